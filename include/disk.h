@@ -0,0 +1,253 @@
+/*******************************************************************************
+ * Disk Access Layer (DAL)
+ * Author: Michael Lombardi
+ *******************************************************************************/
+#ifndef DISK_H
+#define DISK_H
+
+#include <stdio.h>
+
+#include "config.h"
+#include "global_constants.h"
+
+#ifndef DISK_QUEUE_DEPTH
+#define DISK_QUEUE_DEPTH (256)
+#endif
+
+#ifndef DISK_POOL_THREADS
+#define DISK_POOL_THREADS (4)
+#endif
+
+#ifndef DISK_CACHE_BLOCKS
+#define DISK_CACHE_BLOCKS (1024)
+#endif
+
+#ifndef DISK_DIRTY_LIMIT
+#define DISK_DIRTY_LIMIT (DISK_CACHE_BLOCKS / 2)
+#endif
+
+#ifndef DISK_WRITEBACK_MS
+#define DISK_WRITEBACK_MS (5000)
+#endif
+
+#ifndef DISK_HUGE_PAGE_SIZE
+#define DISK_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#endif
+
+#ifndef DISK_RAM_MAPS
+#define DISK_RAM_MAPS (8)
+#endif
+
+#ifndef DISK_IMAGE_MAPS
+#define DISK_IMAGE_MAPS (8)
+#endif
+
+//============================== DAL TYPE DEFINITION ==============================//
+/**
+ * @brief Backends available for reading and writing the disk image.
+ */
+typedef enum DiskMode {
+    /** Buffered stdio (fseek + fread/fwrite) on the image file. */
+    DISK_STDIO = 0,
+    /** The image is mapped with mmap; block I/O becomes memcpy, msync gives durability. */
+    DISK_MMAP = 1,
+    /** pread/pwrite on the image through the write-back block cache; batched reads are queued
+     * on an io_uring (or a thread pool). */
+    DISK_URING = 2,
+    /** O_DIRECT on the image, bypassing the host page cache; served through the write-back
+     * block cache. */
+    DISK_DIRECT = 3,
+    /** The image and its maps live in an anonymous (hugepage-backed when possible) buffer and
+     * never touch the host disk; `disk_snapshot`/`disk_restore` save and load it. */
+    DISK_RAM = 4
+} DiskMode;
+
+/**
+ * @brief One block transfer in a batch handed to `disk_read_batch`.
+ */
+typedef struct DiskRequest {
+    /** Buffer the bytes are read into. */
+    void *buffer;
+    /** Byte offset within the image. */
+    unsigned int diskOffset;
+    /** Number of bytes to transfer. */
+    unsigned int len;
+} DiskRequest;
+
+/** Submission/completion rings shared with the kernel (DISK_URING). */
+typedef struct DiskRing DiskRing;
+
+/** Worker threads serving batches when io_uring is unavailable (DISK_URING). */
+typedef struct DiskPool DiskPool;
+
+/** Fixed-size write-back cache of whole blocks held in an aligned pool (DISK_URING,
+ * DISK_DIRECT); see `disk_write` for when dirty blocks are written back. */
+typedef struct DiskCache DiskCache;
+
+/**
+ * @brief Disk Access Layer structure.
+ *
+ * Holds the open image and the state of whichever backend is serving block I/O.
+ */
+typedef struct Disk {
+    /** Backend currently serving reads and writes. */
+    DiskMode mode;
+    /** File handle of the image (DISK_STDIO). */
+    FILE *handle;
+    /** File descriptor of the image (DISK_MMAP, DISK_URING, DISK_DIRECT). */
+    int fd;
+    /** Base address of the mapped image (DISK_MMAP) or of the in-memory image (DISK_RAM). */
+    unsigned char *map;
+    /** Number of addressable bytes in the image. */
+    size_t size;
+    /** One bit per page of the mapping written since the last msync (DISK_MMAP). */
+    unsigned char *dirtyPages;
+    /** io_uring instance used for batched reads, Null if the kernel refused one (DISK_URING). */
+    DiskRing *ring;
+    /** Thread pool used for batched reads when there is no ring (DISK_URING). */
+    DiskPool *pool;
+    /** Write-back block cache every transfer goes through (DISK_URING, DISK_DIRECT). */
+    DiskCache *cache;
+} Disk;
+
+extern Disk *disk;
+
+//============================== DAL FUNCTION PROTOTYPES ==========================//
+
+/**
+ * @brief Opens the disk image with the requested backend.
+ * For DISK_MMAP the image is grown, if needed, to cover every sector the SSM can hand out
+ * and then mapped shared into memory. DISK_DIRECT requires BLOCK_SIZE to be a multiple of the
+ * logical sector size of the image. DISK_RAM ignores the path and starts from a zeroed image.
+ * A backend that cannot be set up falls back to DISK_STDIO.
+ * @param[in] _path Path of the disk image.
+ * @param[in] _mode Backend to use.
+ * @return True if the image was opened, false otherwise.
+ */
+Bool disk_open(const char *_path, DiskMode _mode);
+
+/**
+ * @brief Flushes and closes the disk image.
+ * @return True if the image was closed cleanly, false otherwise.
+ */
+Bool disk_close(void);
+
+/**
+ * @brief Reads bytes from the disk image.
+ * @param[out] _buffer Destination buffer.
+ * @param[in] _diskOffset Byte offset within the image.
+ * @param[in] _len Number of bytes to read.
+ * @return True if all bytes were read, false otherwise.
+ */
+Bool disk_read(void *_buffer, unsigned int _diskOffset, unsigned int _len);
+
+/**
+ * @brief Writes bytes to the disk image.
+ * Under DISK_URING and DISK_DIRECT the blocks are kept dirty in the block cache and written
+ * back, sorted into runs, once DISK_DIRTY_LIMIT are dirty, the oldest has waited
+ * DISK_WRITEBACK_MS or a dirty block is evicted. There is no timer thread: the age is checked
+ * here, on the next write, so blocks written before the file system goes idle stay in memory
+ * until `disk_sync`. The other backends have no write-back stage and write straight through.
+ * @param[in] _buffer Source buffer.
+ * @param[in] _diskOffset Byte offset within the image.
+ * @param[in] _len Number of bytes to write.
+ * @return True if all bytes were written, false otherwise.
+ */
+Bool disk_write(const void *_buffer, unsigned int _diskOffset, unsigned int _len);
+
+/**
+ * @brief Reads a batch of independent block transfers.
+ * Consecutive requests whose image ranges are adjacent are merged into runs and each run is
+ * read with one preadv straight into the request buffers. DISK_URING queues every run on the
+ * ring at once (up to DISK_QUEUE_DEPTH in flight) and reaps the completions in bulk; without
+ * io_uring the runs are spread over a pool of DISK_POOL_THREADS workers. DISK_MMAP, DISK_DIRECT
+ * and DISK_RAM serve the requests from memory one at a time.
+ * @param[in,out] _requests Transfers to perform; the buffers receive the data.
+ * @param[in] _count Number of requests.
+ * @return True if every request was read in full, false otherwise.
+ */
+Bool disk_read_batch(DiskRequest *_requests, unsigned int _count);
+
+/**
+ * @brief Starts bringing blocks in ahead of use without waiting for them.
+ * Adjacent offsets are merged into ranges. DISK_STDIO and DISK_URING hand each range to the
+ * kernel's asynchronous readahead (POSIX_FADV_WILLNEED), DISK_MMAP uses MADV_WILLNEED and
+ * DISK_DIRECT loads the blocks into the block cache.
+ * @param[in] _diskOffsets Offsets of the blocks to prefetch.
+ * @param[in] _count Number of offsets.
+ * @param[in] _len Bytes per block.
+ * @return void
+ */
+void disk_prefetch(const unsigned int *_diskOffsets, unsigned int _count, unsigned int _len);
+
+/**
+ * @brief Makes all writes issued so far durable.
+ * DISK_STDIO flushes the stream and fsyncs the file; DISK_MMAP msyncs each run of
+ * pages written since the previous sync; DISK_URING and DISK_DIRECT write back the dirty
+ * blocks of the block cache (sorted, one pwritev per run of adjacent blocks) and fsync the file.
+ * DISK_RAM has nothing to sync.
+ * @return True if the image was synced, false otherwise.
+ */
+Bool disk_sync(void);
+
+/**
+ * @brief Empties the image so that it reads as zeros, without writing the zeros.
+ * The file is truncated and extended back to `_size` bytes (or to the size of the mapping under
+ * DISK_MMAP), leaving a sparse file whose blocks are allocated only as they are written; cached
+ * blocks are dropped. DISK_RAM hands its pages back to the kernel.
+ * @param[in] _size Size of the emptied image in bytes.
+ * @return True if the image was emptied, false otherwise.
+ */
+Bool disk_discard(unsigned int _size);
+
+/**
+ * @brief Loads one of the file system maps (allocation, free or inode map).
+ * The maps are files next to the image unless `disk_map_embed` placed them inside it; under
+ * DISK_RAM they are held in memory instead, keyed by the same path. A map that was never stored
+ * reads as zeros.
+ * @param[in] _path Path identifying the map.
+ * @param[out] _buffer Destination buffer.
+ * @param[in] _len Number of bytes to read.
+ * @return True if the whole map was read, false otherwise.
+ */
+Bool disk_map_read(const char *_path, void *_buffer, unsigned int _len);
+
+/**
+ * @brief Stores one of the file system maps (allocation, free or inode map).
+ * @param[in] _path Path identifying the map.
+ * @param[in] _buffer Source buffer.
+ * @param[in] _len Number of bytes to write.
+ * @return True if the whole map was written, false otherwise.
+ */
+Bool disk_map_write(const char *_path, const void *_buffer, unsigned int _len);
+
+/**
+ * @brief Keeps a map inside the image instead of in its own file.
+ * From then on `disk_map_read` and `disk_map_write` on `_path` become `disk_read` and
+ * `disk_write` at `_diskOffset`, served by the open backend (and its block cache) like any other
+ * block. Placements last until the image is closed.
+ * @param[in] _path Path identifying the map.
+ * @param[in] _diskOffset Byte offset of the map within the image, or -1 to put the map back in
+ * its own file.
+ * @return True if the map was placed, false if there is no room for another placement.
+ */
+Bool disk_map_embed(const char *_path, unsigned int _diskOffset);
+
+/**
+ * @brief Saves the in-memory image and its maps to a file (DISK_RAM).
+ * @param[in] _path Path of the snapshot file; it is created or truncated.
+ * @return True if the snapshot was written, false otherwise or if the image is not in memory.
+ */
+Bool disk_snapshot(const char *_path);
+
+/**
+ * @brief Replaces the in-memory image and its maps with a snapshot (DISK_RAM).
+ * The snapshot must have been taken from an image no larger than the open one. It is read and
+ * checked in full before anything is replaced, so a truncated or corrupt file leaves the image
+ * and its maps as they were.
+ * @param[in] _path Path of a file written by `disk_snapshot`.
+ * @return True if the snapshot was loaded, false otherwise or if the image is not in memory.
+ */
+Bool disk_restore(const char *_path);
+
+#endif  // DISK_H
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * Disk Access Layer (DAL) - Linux kernel interfaces
+ * Author: Michael Lombardi
+ *******************************************************************************/
+#ifndef DISK_LINUX_H
+#define DISK_LINUX_H
+
+#include <stddef.h>
+#include <sys/uio.h>
+
+#include "disk.h"
+#include "global_constants.h"
+
+// The io_uring ABI and BLKSSZGET come from <linux/*.h> headers, which define a BLOCK_SIZE macro
+// that clashes with the FSM global; only disk_linux.c includes them.
+
+//============================== DAL TYPE DEFINITION ==============================//
+/**
+ * @brief Requests of a batch whose image ranges follow each other, read with one preadv.
+ */
+typedef struct DiskRun {
+    // the run's iovecs (consecutive in the batch's iovec array)
+    struct iovec *iov;
+    int iovCount;
+    // image offset and byte length of the run
+    unsigned int diskOffset;
+    size_t len;
+    // bytes the ring read; a short run is finished by the caller (DISK_URING)
+    size_t done;
+} DiskRun;
+
+//============================== DAL FUNCTION PROTOTYPES ==========================//
+
+/**
+ * @brief Creates an io_uring with raw syscalls and maps its rings.
+ * @param[in] _entries Requested submission queue depth.
+ * @return The ring, or Null if the kernel refused to create one.
+ */
+DiskRing *disk_ring_create(unsigned int _entries);
+
+/**
+ * @brief Unmaps the rings and closes the io_uring.
+ * @param[in] _ring Ring to release.
+ * @return void
+ */
+void disk_ring_destroy(DiskRing *_ring);
+
+/**
+ * @brief Queues a batch of runs on the ring and reaps the completions in bulk.
+ * Submits as many runs as the queue holds with a single io_uring_enter (one READV each), waits
+ * for all of them, then continues with the rest of the batch. The bytes each run got are left
+ * in its `done`. If io_uring_enter fails, the entries the kernel has not taken are withdrawn
+ * and the ones it has taken are waited for, so no read is still filling the caller's buffers
+ * when the batch returns.
+ * @param[in] _ring Ring to submit on.
+ * @param[in] _fd Descriptor of the image.
+ * @param[in,out] _runs Runs to read.
+ * @param[in] _count Number of runs.
+ * @return True if every run completed without an error, false otherwise.
+ */
+Bool disk_ring_read_runs(DiskRing *_ring, int _fd, DiskRun *_runs, unsigned int _count);
+
+/**
+ * @brief Gets the logical sector size of a block device (BLKSSZGET).
+ * @param[in] _fd Descriptor of an open block device.
+ * @return The logical sector size in bytes, or 0 if the device did not report one.
+ */
+unsigned int disk_blkdev_sector_size(int _fd);
+
+#endif  // DISK_LINUX_H
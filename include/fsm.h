@@ -7,18 +7,48 @@
 #include <stdio.h>
 
 #include "config.h"
+#include "disk.h"
 #include "fsm_constants.h"
 #include "global_constants.h"
 #include "inode.h"
 
 //======================== FSM TYPE DEFINITION ==============================//
 typedef struct FSM {
-    // pointers used for disk access
-    FILE *diskHandle;
+    // backend used for disk access (mount option)
+    DiskMode diskMode;
+    // whether the inode table is kept resident in memory (mount option)
+    Bool residentInodes;
+    // whether small files and new directories keep their data in the inode (mount option)
+    Bool inlineData;
+    // whether new regular files are mapped with extents instead of block pointers (mount option)
+    Bool extentFiles;
+    // whether fs_make leaves the image sparse and writes inode table chunks on first use
+    // (mount option)
+    Bool lazyInodes;
+    // whether fs_make keeps the sector, free and inode maps inside the image (mount option)
+    Bool embeddedMaps;
+    // whether all-zero blocks of a file are left unallocated as holes (mount option)
+    Bool sparseFiles;
+    // whether directories keep a name index beside their entries (mount option)
+    Bool dirIndex;
 } FSM;
 
 extern FSM *fsm;
 
+/**
+ * @brief Position of a streaming read through a file (see `fs_stream_open`).
+ */
+typedef struct FileStream {
+    // inode number of the file being read
+    unsigned int inodeNum;
+    // size of the file when the stream was opened, in bytes
+    unsigned int size;
+    // first block of the next chunk
+    unsigned int nextBlock;
+    // number of blocks per chunk
+    unsigned int chunkBlocks;
+} FileStream;
+
 //======================== FSM FUNCTION PROTOTYPES ==========================//
 
 /**
@@ -37,6 +67,17 @@ extern FSM *fsm;
 Bool fs_make(unsigned int _DISK_SIZE, unsigned int _BLOCK_SIZE, unsigned int _INODE_SIZE,
              unsigned int _INODE_BLOCKS, unsigned int _INODE_COUNT, int _initSsmMaps);
 
+/**
+ * @brief Mounts the file system already on the disk image without remaking it.
+ * Reads the geometry `fs_make` recorded in the super block, opens the image with the selected
+ * backend and loads the sector, free and inode maps as they are; nothing on the image is
+ * written. Not available for DISK_RAM, whose image is brought back with `fs_load_snapshot`.
+ * @return True if the file system was mounted, false if the image has no valid super block or
+ * could not be opened.
+ * @date 2026-10-18 First implementation.
+ */
+Bool fs_mount(void);
+
 /**
  * @brief Closes the file system and releases associated resources.
  * Finalizes the file system by closing the disk handle if it is open.
@@ -46,6 +87,139 @@ Bool fs_make(unsigned int _DISK_SIZE, unsigned int _BLOCK_SIZE, unsigned int _IN
  */
 Bool fs_remove(void);
 
+/**
+ * @brief Selects the backend used to access the disk image.
+ * Must be called before `fs_make`; DISK_STDIO is used by default. A backend that cannot be set
+ * up on the image (no mapping, no O_DIRECT support, misaligned BLOCK_SIZE) falls back to
+ * DISK_STDIO.
+ * @param[in] _mode DISK_STDIO, DISK_MMAP, DISK_URING, DISK_DIRECT or DISK_RAM.
+ * @return True if the mode is supported, false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+Bool fs_set_disk_mode(DiskMode _mode);
+
+/**
+ * @brief Selects whether the inode table is kept in memory.
+ * Must be called before `fs_make`. A resident table is loaded with one sequential read when the
+ * file system is set up; inode reads and writes then go to the array, and changed inodes are
+ * written back in contiguous runs by `fs_sync` and `fs_remove`.
+ * @param[in] _resident True to keep the inode table resident, false to read inodes from disk.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+void fs_set_resident_inodes(Bool _resident);
+
+/**
+ * @brief Selects whether small files and directories keep their data inline in the inode.
+ * With inline data on, a file written with at most `inode_inline_capacity()` bytes that owns no
+ * blocks keeps its data in the inode's pointers and the spare end of its slot, and a new
+ * directory keeps its first entries there; neither needs a data block to be allocated or read.
+ * A file that outgrows the inode moves to blocks on its next write, and a directory moves its
+ * entries to a data block when they no longer fit. Inline inodes are read correctly whatever
+ * the setting.
+ * @param[in] _inline True to create inline files and directories, false otherwise.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+void fs_set_inline_data(Bool _inline);
+
+/**
+ * @brief Selects whether new regular files are mapped with extents.
+ * An extent-mapped file records its data as runs of contiguous blocks (first file block, disk
+ * offset, length): up to INODE_EXTENT_SLOTS runs take the place of the direct pointers and the
+ * rest go in one extent block hung off the single indirect pointer. Blocks are allocated in runs
+ * of up to EXTENT_MAX_RUN sectors, so a large file is read with a handful of transfers instead
+ * of one per block. The choice is made per inode when a file without blocks is first written;
+ * extent-mapped files are read, rewritten and removed correctly whatever the setting.
+ * @param[in] _extents True to map new files with extents, false to use block pointers.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+void fs_set_extent_files(Bool _extents);
+
+/**
+ * @brief Selects whether `fs_make` initializes the inode table lazily.
+ * With lazy inodes on, `fs_make` empties the image with `disk_discard` instead of writing it
+ * full of zeros, which leaves a sparse file, and records every INODE_CHUNK_BLOCKS chunk of the
+ * inode table as unwritten in the super block. A chunk is written the first time one of its
+ * inodes is read or written; `fs_init_inodes` writes the rest ahead of use. Making a large
+ * image then costs a few writes instead of one per byte.
+ * @param[in] _lazy True to make file systems with lazy inodes, false otherwise.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+void fs_set_lazy_inodes(Bool _lazy);
+
+/**
+ * @brief Selects whether `fs_make` keeps the file system maps inside the image.
+ * With embedded maps on, the sector allocation map, the free map and the iMap are stored in
+ * sectors reserved right after the inode table instead of in ./fs/aMap, ./fs/fMap and
+ * ./fs/iMap. They are then read and written through the disk backend and its block cache like
+ * any other block, with no file opened per update, and a copy of the image is a complete copy
+ * of the file system. The super block records where the maps are, so `fs_mount` and
+ * `fs_load_snapshot` find them whatever the setting.
+ * @param[in] _embedded True to keep the maps inside the image, false to keep them in files.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+void fs_set_embedded_maps(Bool _embedded);
+
+/**
+ * @brief Selects whether `fs_write_to_file` leaves all-zero blocks of a file as holes.
+ * With sparse files on, every block about to be written is checked for zeros first; a zero block
+ * gets no data block (its pointer stays -1, or it falls between two extents) and a block that
+ * becomes zero on a rewrite is freed. Holes inside the file size read back as zeros.
+ * @param[in] _sparse True to leave zero blocks unallocated, false to write them out.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+void fs_set_sparse_files(Bool _sparse);
+
+/**
+ * @brief Selects whether directories keep a name index beside their entries.
+ * With the index on, a directory that holds its entries in blocks gets a B-tree keyed by the hash
+ * of each name, built when an entry is next added to it. The tree lives in blocks owned by the
+ * directory and its root is kept in the spare bytes of the directory's inode; the entry blocks
+ * keep their format. Indexed directories stay indexed whatever the option says.
+ * @param[in] _index True to index directories, false to leave unindexed ones scanned.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+void fs_set_dir_index(Bool _index);
+
+/**
+ * @brief Writes inode table chunks left unwritten by a lazy `fs_make`.
+ * Meant to be called when the file system is idle, a few chunks at a time.
+ * @param[in] _chunks Maximum number of chunks to write.
+ * @return The number of chunks still unwritten.
+ * @date 2026-10-18 First implementation.
+ */
+unsigned int fs_init_inodes(unsigned int _chunks);
+
+/**
+ * @brief Makes all changes written so far durable on the disk image.
+ * @return True if the disk image was synced, false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+Bool fs_sync(void);
+
+/**
+ * @brief Saves a RAM disk (DISK_RAM) to a file, image and maps included.
+ * @param[in] _path Path of the snapshot file.
+ * @return True if the snapshot was written, false otherwise or if the disk is not a RAM disk.
+ * @date 2026-10-18 First implementation.
+ */
+Bool fs_snapshot(const char *_path);
+
+/**
+ * @brief Replaces the contents of a RAM disk (DISK_RAM) with a snapshot.
+ * Must be called after `fs_make`; the SSM maps and the iMap are reloaded from the snapshot.
+ * @param[in] _path Path of a file written by `fs_snapshot`.
+ * @return True if the snapshot was loaded, false otherwise or if the disk is not a RAM disk.
+ * @date 2026-10-18 First implementation.
+ */
+Bool fs_load_snapshot(const char *_path);
+
 /**
  * @brief Creates a file or directory.
  * This function creates a new file or directory in the file sector manager.
@@ -79,6 +253,8 @@ Bool fs_close_file(void);
 /**
  * @brief Removes a file from a directory.
  * Removes the file identified by `_inodeNumF` from the directory specified by `_inodeNumD`.
+ * The entry block named by the file's back-pointer is searched first; the directory's other
+ * blocks are searched only if the entry is not there.
  * @param[in] _inodeNumF Inode number of the file to be removed.
  * @param[in] _inodeNumD Inode number of the directory containing the file.
  * @return True if the file was successfully removed, false if the file could not be accessed.
@@ -97,6 +273,108 @@ Bool fs_remove_file_from_dir(unsigned int _inodeNumF, unsigned int _inodeNumD);
  */
 Bool fs_write_to_file(unsigned int _inodeNum, void *_buffer, long long int _fileSize);
 
+/**
+ * @brief Writes part of a file, in place.
+ * Only the blocks covering `_offset` to `_offset` + `_len` are touched: holes among them are
+ * allocated, whole blocks are written straight from `_buffer` (one write per run of blocks that
+ * are adjacent on disk) and the partial blocks at either edge are read, patched and written
+ * back. A write past the end of the file grows it; the blocks skipped over are left as holes.
+ * @param[in] _inodeNum Inode number of the file to write to; it must not be a directory.
+ * @param[in] _buffer Data to write.
+ * @param[in] _len Number of bytes to write.
+ * @param[in] _offset Byte offset within the file of the first byte to write.
+ * @return The number of bytes written, or -1 if the file could not be opened or the disk ran
+ * out of space.
+ * @date 2026-10-18 First implementation.
+ */
+long long int fs_pwrite(unsigned int _inodeNum, const void *_buffer, unsigned int _len,
+                        unsigned int _offset);
+
+/**
+ * @brief Adds data at the end of a file.
+ * The partial last block is read, filled and written back, and blocks are allocated only for the
+ * new tail: pointer blocks are added to the existing trees (or the last extent is extended)
+ * instead of being rebuilt, so an append costs in proportion to its size, not the file's.
+ * @param[in] _inodeNum Inode number of the file to append to; it must not be a directory.
+ * @param[in] _buffer Data to append.
+ * @param[in] _len Number of bytes to append.
+ * @return The number of bytes appended, or -1 if the file could not be opened or the disk ran
+ * out of space.
+ * @date 2026-10-18 First implementation.
+ */
+long long int fs_append(unsigned int _inodeNum, const void *_buffer, unsigned int _len);
+
+/**
+ * @brief Shrinks or extends a file to `_size` bytes in place.
+ * Shrinking frees only the data blocks past the new end, and the pointer blocks left with
+ * nothing under them; pointer blocks wholly before the new end are not read. The freed sectors
+ * are handed to the SSM in batches, with one update of its maps per batch. Extending leaves the
+ * new part of the file as a hole that reads as zeros.
+ * @param[in] _inodeNum Inode number of the file; it must not be a directory.
+ * @param[in] _size New size of the file in bytes.
+ * @return True if the file was resized, false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+Bool fs_truncate(unsigned int _inodeNum, unsigned int _size);
+
+/**
+ * @brief Opens a file and returns a handle to it.
+ * The handle keeps a copy of the inode, the block map of the file, a file offset and its own
+ * readahead state, so `fs_read`, `fs_write` and `fs_seek` on it read no inode and walk no pointer
+ * tree once the map is built. The copy is refreshed only when the file is changed through another
+ * call (or another handle).
+ * @param[in] _inodeNum Inode number of the file to open.
+ * @return A handle from 0 to MAX_OPEN_FILES - 1, or -1 if the file could not be opened or every
+ * handle is in use.
+ * @date 2026-10-18 First implementation.
+ */
+int fs_open(unsigned int _inodeNum);
+
+/**
+ * @brief Closes a handle returned by `fs_open` and frees its block map.
+ * @param[in] _fd Handle to close.
+ * @return True if the handle was closed, false if it was not open.
+ * @date 2026-10-18 First implementation.
+ */
+Bool fs_close(int _fd);
+
+/**
+ * @brief Reads from a file at the offset of a handle and moves the offset past the data read.
+ * Blocks are looked up in the handle's block map, built on the first read; reads that follow
+ * each other are prefetched ahead as by `fs_read_blocks`.
+ * @param[in] _fd Handle returned by `fs_open`.
+ * @param[out] _buffer Buffer of at least `_len` bytes.
+ * @param[in] _len Number of bytes to read.
+ * @return The number of bytes read (0 at the end of the file), or -1 if the handle is not open
+ * or the file could not be read.
+ * @date 2026-10-18 First implementation.
+ */
+long long int fs_read(int _fd, void *_buffer, unsigned int _len);
+
+/**
+ * @brief Writes to a file at the offset of a handle and moves the offset past the data written.
+ * A write inside blocks the file already has goes straight to the disk offsets in the handle's
+ * block map; any other write is done as by `fs_pwrite`, and the handle keeps the inode it leaves.
+ * @param[in] _fd Handle returned by `fs_open`; its file must not be a directory.
+ * @param[in] _buffer Data to write.
+ * @param[in] _len Number of bytes to write.
+ * @return The number of bytes written, or -1 if the handle is not open or the write failed.
+ * @date 2026-10-18 First implementation.
+ */
+long long int fs_write(int _fd, const void *_buffer, unsigned int _len);
+
+/**
+ * @brief Moves the offset of a handle.
+ * @param[in] _fd Handle returned by `fs_open`.
+ * @param[in] _offset Offset in bytes, relative to `_whence`.
+ * @param[in] _whence SEEK_SET (start of the file), SEEK_CUR (current offset) or SEEK_END (end of
+ * the file).
+ * @return The new offset, or -1 if `_whence` is not one of the three above, the handle is not
+ * open or the offset would be out of range.
+ * @date 2026-10-18 First implementation.
+ */
+long long int fs_seek(int _fd, long long int _offset, int _whence);
+
 /**
  * @brief Reads a file.
  * Reads the contents of the file associated with the given inode number
@@ -108,9 +386,72 @@ Bool fs_write_to_file(unsigned int _inodeNum, void *_buffer, long long int _file
  */
 Bool fs_read_from_file(unsigned int _inodeNum, void *_buffer);
 
+/**
+ * @brief Reads a range of blocks of a file.
+ * Reads `_count` blocks starting at block `_firstBlock` of the file into the provided buffer;
+ * holes read as zeros. Reads that continue where the previous read of the same file stopped
+ * are treated as sequential: the upcoming data blocks (and the pointer blocks that map them)
+ * are prefetched, with a window that doubles on every sequential read and halves otherwise.
+ * The first read of a file builds its block map (one walk of the pointer tree); later reads look
+ * blocks up in the map, so a random read costs one data I/O until the file changes.
+ * @param[in] _inodeNum Inode number of the file to read.
+ * @param[in] _firstBlock Index of the first block to read.
+ * @param[in] _count Number of blocks to read.
+ * @param[out] _buffer Buffer of at least `_count` * BLOCK_SIZE bytes.
+ * @return True if the blocks were read successfully, false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+Bool fs_read_blocks(unsigned int _inodeNum, unsigned int _firstBlock, unsigned int _count,
+                    void *_buffer);
+
+/**
+ * @brief Starts reading a file as a stream of fixed-size chunks.
+ * The file is read by `fs_stream_next` one chunk of `_chunkBlocks` blocks at a time, so the
+ * caller needs a buffer of one chunk instead of the whole file. Opening the stream already
+ * starts loading the first chunk.
+ * @param[out] _stream Stream to set up; it holds no memory and needs no closing.
+ * @param[in] _inodeNum Inode number of the file to read.
+ * @param[in] _chunkBlocks Number of blocks per chunk, at least 1.
+ * @return True if the stream was opened, false if the file could not be opened.
+ * @date 2026-10-18 First implementation.
+ */
+Bool fs_stream_open(FileStream *_stream, unsigned int _inodeNum, unsigned int _chunkBlocks);
+
+/**
+ * @brief Reads the next chunk of a stream.
+ * The chunk is read with `fs_read_blocks`, mapping only its own blocks. Before returning, the
+ * blocks of the following chunk are handed to `disk_prefetch`, so they load while the caller
+ * works on this one; a caller that alternates between two chunk buffers (e.g. handing the full
+ * one to another thread) keeps copying out and reading overlapped.
+ * @param[in,out] _stream Stream opened by `fs_stream_open`.
+ * @param[out] _buffer Buffer of at least `_chunkBlocks` * BLOCK_SIZE bytes.
+ * @return The number of bytes of the file in the chunk (the last chunk may be short), 0 at the
+ * end of the file, or -1 if the chunk could not be read.
+ * @date 2026-10-18 First implementation.
+ */
+long long int fs_stream_next(FileStream *_stream, void *_buffer);
+
+/**
+ * @brief Reads part of a file.
+ * Reads up to `_len` bytes starting at byte `_offset` with `fs_read_blocks`, so only the blocks
+ * covering the range are mapped and read. Whole blocks go straight into `_buffer`; a partial
+ * block at either edge goes through a block buffer. The read stops at the end of the file.
+ * @param[in] _inodeNum Inode number of the file to read.
+ * @param[out] _buffer Buffer of at least `_len` bytes.
+ * @param[in] _len Number of bytes to read.
+ * @param[in] _offset Byte offset within the file of the first byte to read.
+ * @return The number of bytes read (0 at or past the end of the file), or -1 if the file could
+ * not be read.
+ * @date 2026-10-18 First implementation.
+ */
+long long int fs_pread(unsigned int _inodeNum, void *_buffer, unsigned int _len,
+                       unsigned int _offset);
+
 /**
  * @brief Removes a file from the filesystem.
  * Removes the file identified by `_inodeNum` from the directory specified by `_inodeNumD`.
+ * A file that still has other hard links only loses this name and keeps its data; its blocks
+ * and inode are freed when the last link goes.
  * @param[in] _inodeNum Inode number of the file to be removed.
  * @param[in] _inodeNumD Inode number of the directory containing the file.
  * @return True if the file was removed successfully, false otherwise.
@@ -121,7 +462,8 @@ Bool fs_remove_file(unsigned int _inodeNum, unsigned int _inodeNumD);
 /**
  * @brief Renames a file within a directory.
  * Updates the name of the file identified by `_inodeNumF` in the directory
- * specified by `_inodeNumD`.
+ * specified by `_inodeNumD`. As in `fs_remove_file_from_dir`, the entry block named by the
+ * file's back-pointer is searched before the rest of the directory.
  * @param[in] _inodeNumF Inode number of the file to rename.
  * @param[in] _name Pointer to the new name for the file.
  * @param[in] _inodeNumD Inode number of the directory containing the file.
@@ -130,4 +472,66 @@ Bool fs_remove_file(unsigned int _inodeNum, unsigned int _inodeNumD);
  */
 Bool fs_rename_file(unsigned int _inodeNumF, unsigned int *_name, unsigned int _inodeNumD);
 
+/**
+ * @brief Finds a file in a directory by name.
+ * Answers come from the dentry cache when it has the name, including names it has seen missing.
+ * Otherwise an indexed directory (see `fs_set_dir_index`) reads only the index nodes down to one
+ * leaf and the entries whose name has the same hash, other directories are scanned, and the
+ * answer is cached. Creating, renaming and removing files keeps the cache up to date.
+ * @param[in] _inodeNumD Inode number of the directory.
+ * @param[in] _name Pointer to the name of the file (8 bytes).
+ * @return Inode number of the file, -1 if the directory has no entry of that name.
+ * @date 2026-10-18 First implementation.
+ */
+unsigned int fs_lookup(unsigned int _inodeNumD, const unsigned int *_name);
+
+/**
+ * @brief Finds a file by its path from the root directory, e.g. "/a/b/c/file".
+ * Each component is looked up with `fs_lookup`, so a path walked before is resolved from the
+ * dentry cache without reading any directory. Repeated slashes are skipped; "." and ".." are
+ * the entries every directory has. A symbolic link is followed wherever it appears in the path:
+ * an absolute target is walked from the root, a relative one from the link's directory.
+ * @param[in] _path Path of the file; components are at most 8 bytes.
+ * @return Inode number of the file, -1 if a component is missing, too long or not a directory,
+ * or if more than SYMLINK_MAX_HOPS links are followed (e.g. a loop of links).
+ * @date 2026-10-18 First implementation.
+ */
+unsigned int fs_resolve(const char *_path);
+
+/**
+ * @brief Adds a hard link: another name in a directory for an existing file.
+ * The new entry refers to the same inode, so both names share the data without copying it;
+ * the inode's `linkCount` counts the names (directories keep counting their entries there).
+ * @param[in] _inodeNumF Inode number of the file to link; must not be a directory.
+ * @param[in] _name Pointer to the name of the new link.
+ * @param[in] _inodeNumD Inode number of the directory to add the link to.
+ * @return True if the link was added, false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+Bool fs_link(unsigned int _inodeNumF, unsigned int *_name, unsigned int _inodeNumD);
+
+/**
+ * @brief Creates a symbolic link to a path.
+ * The link is an inode of type 3 whose data is the target path. A target of up to
+ * `inode_inline_capacity()` bytes is stored inline in the inode, so reading it costs no data
+ * block; a longer one (up to BLOCK_SIZE bytes) goes in a data block.
+ * @param[in] _target Null-terminated target path.
+ * @param[in] _name Pointer to the name of the link.
+ * @param[in] _inodeNumD Inode number of the directory to create the link in.
+ * @return The inode number of the link, or -1 if it could not be created.
+ * @date 2026-10-18 First implementation.
+ */
+unsigned int fs_symlink(const char *_target, unsigned int *_name, unsigned int _inodeNumD);
+
+/**
+ * @brief Reads the target of a symbolic link.
+ * @param[in] _inodeNum Inode number of the link.
+ * @param[out] _target Buffer for the Null-terminated target path.
+ * @param[in] _size Size of `_target` in bytes.
+ * @return True if the target was read, false if the inode is not a link or `_target` is too
+ * small.
+ * @date 2026-10-18 First implementation.
+ */
+Bool fs_read_link(unsigned int _inodeNum, char *_target, unsigned int _size);
+
 #endif  // FILE_SECTOR_MGR
@@ -19,6 +19,94 @@
 #define MAX_BLOCK_SIZE (1024)
 #endif
 
+#ifndef READAHEAD_FILES
+#define READAHEAD_FILES (16)
+#endif
+
+#ifndef READAHEAD_MIN_BLOCKS
+#define READAHEAD_MIN_BLOCKS (4)
+#endif
+
+#ifndef READAHEAD_MAX_BLOCKS
+#define READAHEAD_MAX_BLOCKS (256)
+#endif
+
+#ifndef BLOCK_MAP_FILES
+#define BLOCK_MAP_FILES (16)
+#endif
+
+#ifndef MAX_OPEN_FILES
+#define MAX_OPEN_FILES (64)
+#endif
+
+#ifndef INODE_INLINE
+#define INODE_INLINE (0x1)
+#endif
+
+#ifndef DIR_ENTRY_SIZE
+#define DIR_ENTRY_SIZE (16)
+#endif
+
+#ifndef INODE_EXTENTS
+#define INODE_EXTENTS (0x2)
+#endif
+
+#ifndef INODE_DIR_INDEX
+#define INODE_DIR_INDEX (0x4)
+#endif
+
+#ifndef DIR_INDEX_MAX_DEPTH
+#define DIR_INDEX_MAX_DEPTH (8)
+#endif
+
+#ifndef ROOT_DIR_INODE
+#define ROOT_DIR_INODE (2)
+#endif
+
+#ifndef DENTRY_CACHE_SIZE
+#define DENTRY_CACHE_SIZE (1024)
+#endif
+
+#ifndef SYMLINK_MAX_HOPS
+#define SYMLINK_MAX_HOPS (8)
+#endif
+
+#ifndef DIR_SLOT_DIRS
+#define DIR_SLOT_DIRS (64)
+#endif
+
+#ifndef INODE_EXTENT_SLOTS
+#define INODE_EXTENT_SLOTS (3)
+#endif
+
+#ifndef EXTENT_MAX_RUN
+#define EXTENT_MAX_RUN (32)
+#endif
+
+#ifndef FREE_BATCH_SECTORS
+#define FREE_BATCH_SECTORS (256)
+#endif
+
+#ifndef INODE_CHUNK_BLOCKS
+#define INODE_CHUNK_BLOCKS (32)
+#endif
+
+#ifndef SUPERBLOCK_MAGIC
+#define SUPERBLOCK_MAGIC (0x42535A41)
+#endif
+
+#ifndef SUPERBLOCK_MAX_CHUNKS
+#define SUPERBLOCK_MAX_CHUNKS (MAX_INODE_BLOCKS / INODE_CHUNK_BLOCKS)
+#endif
+
+#ifndef SUPERBLOCK_MIN_BLOCK_SIZE
+#define SUPERBLOCK_MIN_BLOCK_SIZE (128)
+#endif
+
+#ifndef SUPERBLOCK_LAZY_INODES
+#define SUPERBLOCK_LAZY_INODES (0x1)
+#endif
+
 extern unsigned int DISK_SIZE;     // 3000000
 extern unsigned int BLOCK_SIZE;    // 1024
 extern unsigned int INODE_SIZE;    //(BLOCK_SIZE / 8)
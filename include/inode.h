@@ -36,13 +36,22 @@ typedef struct Inode {
 
 typedef struct InodeMap {
     unsigned int iMapOffset[2];
-    FILE *iMapHandle;
     unsigned char iMap[MAX_INODE_BLOCKS];
     unsigned int id;
 } InodeMap;
 
+typedef struct InodeTable {
+    // the whole inode table, INODE_SIZE bytes per inode; Null unless the table is resident
+    unsigned char *inodes;
+    // one bit per inode changed since the last flush
+    unsigned char *dirty;
+    // number of inodes held
+    unsigned int count;
+} InodeTable;
+
 extern Inode inode;
 extern InodeMap inode_map;
+extern InodeTable inode_table;
 
 /**
  * @brief Initializes the inode memory pointers.
@@ -63,11 +72,10 @@ int inode_init(Inode *_inode);
  * Creates a sequence of `_count` inodes starting at the specified disk offset.
  * Each inode is initialized with zeroed data fields and -1 in all pointer fields.
  * @param[in] _count Number of inodes to construct.
- * @param[in,out] _fileStream Pointer to the file representing the hard drive.
  * @param[in] _diskOffset Offset on disk where the inode block begins.
  * @return void
  */
-void inode_make(unsigned int _count, FILE *_fileStream, unsigned int _diskOffset);
+void inode_make(unsigned int _count, unsigned int _diskOffset);
 
 /**
  * @brief Reads an inode from disk and loads it into the provided buffer.
@@ -75,10 +83,9 @@ void inode_make(unsigned int _count, FILE *_fileStream, unsigned int _diskOffset
  * reads its contents into the `_inode` buffer.
  * @param[out] _inode Pointer to an Inode structure to store the result.
  * @param[in] _inodeNum The index of the inode to read.
- * @param[in] _fileStream Pointer to the file representing the hard drive.
  * @return void
  */
-void inode_read(Inode *_inode, unsigned int _inodeNum, FILE *_fileStream);
+void inode_read(Inode *_inode, unsigned int _inodeNum);
 
 /**
  * @brief Writes an inode to its corresponding location on disk.
@@ -86,10 +93,101 @@ void inode_read(Inode *_inode, unsigned int _inodeNum, FILE *_fileStream);
  * writes the contents of the `_inode` buffer to that location.
  * @param[in] _inode Pointer to the Inode structure containing the data to write.
  * @param[in] _inodeNum The index of the inode to write.
- * @param[in,out] _fileStream Pointer to the file representing the hard drive.
  * @return void
  */
-void inode_write(Inode *_inode, unsigned int _inodeNum, FILE *_fileStream);
+void inode_write(Inode *_inode, unsigned int _inodeNum);
+
+/**
+ * @brief Gets the number of data bytes an inode can hold inline.
+ * An inline inode (INODE_INLINE set in `status`) keeps its data in place of its block pointers
+ * and in the spare bytes at the end of its INODE_SIZE slot.
+ * @return The inline capacity in bytes.
+ * @date 2026-10-18 First implementation.
+ */
+unsigned int inode_inline_capacity(void);
+
+/**
+ * @brief Reads the inline data of an inode.
+ * @param[in] _inode The inode, as read with `inode_read`; holds the start of the data.
+ * @param[in] _inodeNum The index of the inode; its slot holds the rest of the data.
+ * @param[out] _data Buffer of at least `inode_inline_capacity()` bytes.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+void inode_read_inline(const Inode *_inode, unsigned int _inodeNum, void *_data);
+
+/**
+ * @brief Stores inline data in an inode and writes the inode.
+ * The start of the data is copied over the pointers of `_inode`, the rest goes to the spare
+ * bytes of the slot.
+ * @param[in,out] _inode The inode to write.
+ * @param[in] _inodeNum The index of the inode.
+ * @param[in] _data Buffer of `inode_inline_capacity()` bytes.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+void inode_write_inline(Inode *_inode, unsigned int _inodeNum, const void *_data);
+
+/**
+ * @brief Gets the number of spare bytes at the end of an inode's slot, past the inode struct.
+ * An inode that is not inline may keep its own metadata there (e.g. the root of a directory's
+ * name index).
+ * @return The number of spare bytes, INODE_SIZE - sizeof(Inode).
+ * @date 2026-10-18 First implementation.
+ */
+unsigned int inode_spare_size(void);
+
+/**
+ * @brief Reads the spare bytes of an inode's slot.
+ * @param[in] _inodeNum The index of the inode.
+ * @param[out] _data Buffer of at least `inode_spare_size()` bytes.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+void inode_read_spare(unsigned int _inodeNum, void *_data);
+
+/**
+ * @brief Writes the spare bytes of an inode's slot; the inode itself is left as it is.
+ * @param[in] _inodeNum The index of the inode.
+ * @param[in] _data Buffer of `inode_spare_size()` bytes.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+void inode_write_spare(unsigned int _inodeNum, const void *_data);
+
+/**
+ * @brief Writes chunks of the inode table that are still unwritten.
+ * A file system made with lazy inodes writes each chunk of its table the first time one of its
+ * inodes is read or written; this finishes the remaining chunks ahead of use, e.g. when idle.
+ * @param[in] _max Maximum number of chunks to write.
+ * @return The number of chunks still unwritten.
+ * @date 2026-10-18 First implementation.
+ */
+unsigned int inode_chunks_init(unsigned int _max);
+
+/**
+ * @brief Loads the whole inode table into memory with one sequential read.
+ * While the table is resident `inode_read` and `inode_write` work on the array and only mark
+ * inodes dirty; `inode_table_flush` writes them back. A table already resident is discarded.
+ * @return True if the table was loaded, false otherwise (inodes are then read from disk).
+ * @date 2026-10-18 First implementation.
+ */
+Bool inode_table_load(void);
+
+/**
+ * @brief Writes the dirty inodes of the resident table back to disk.
+ * Adjacent dirty inodes are written together, one write per run.
+ * @return True if every run was written (or the table is not resident), false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+Bool inode_table_flush(void);
+
+/**
+ * @brief Flushes the resident inode table and releases it.
+ * @return True if the table was flushed, false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+Bool inode_table_unload(void);
 
 /**
  * @brief Allocates a new inode.
@@ -19,10 +19,6 @@
  * within a file system or block storage interface.
  */
 typedef struct SSM {
-    /** File handle for the allocation map. */
-    FILE *alocMapHandle;
-    /** File handle for the free sector map. */
-    FILE *freeMapHandle;
     /** Allocation bitmap per sector. */
     unsigned char alocMap[SECTOR_BYTES];
     /** Free sector bitmap. */
@@ -69,6 +65,16 @@ unsigned int ssm_allocate_sectors(int _n);
  */
 Bool ssm_deallocate_sectors(int _sectorNum);
 
+/**
+ * @brief Frees a batch of sectors that need not be contiguous.
+ * Every sector is marked free in the maps first; the consistency check and the write of the
+ * maps to disk then happen once for the whole batch instead of once per sector.
+ * @param[in] _sectorNums Numbers of the sectors to deallocate.
+ * @param[in] _count Number of sectors.
+ * @return True if deallocation succeeded and maps remained consistent, False otherwise.
+ */
+Bool ssm_deallocate_batch(const unsigned int *_sectorNums, unsigned int _count);
+
 /**
  * @brief Gets the sector offset of the last allocated sector.
  * @return The disk byte offset to the current sector.
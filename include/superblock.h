@@ -0,0 +1,97 @@
+/*******************************************************************************
+ * File Sector Manager (FSM) - Super Block
+ * Author: Michael Lombardi
+ *******************************************************************************/
+#ifndef SUPERBLOCK_H
+#define SUPERBLOCK_H
+
+#include "config.h"
+#include "fsm_constants.h"
+#include "global_constants.h"
+
+//============================== SUPER BLOCK TYPE DEFINITION ======================//
+/**
+ * @brief On-disk super block, stored at the start of block 1 of the image.
+ *
+ * Describes the file system as a whole: the geometry it was made with, so that it can be
+ * mounted again without being remade, and which chunks of the inode table have been written.
+ */
+typedef struct SuperBlock {
+    /** SUPERBLOCK_MAGIC once the file system has been made. */
+    unsigned int magic;
+    /** Geometry passed to `fs_make`. */
+    unsigned int diskSize;
+    unsigned int blockSize;
+    unsigned int inodeSize;
+    unsigned int inodeBlocks;
+    unsigned int inodeCount;
+    /** Byte offset of the sector, free and inode maps inside the image, 0 if they are kept in
+     * files next to it. */
+    unsigned int mapsOffset;
+    /** SUPERBLOCK_LAZY_INODES while some chunk of the inode table is still unwritten. */
+    unsigned int flags;
+    /** Number of INODE_CHUNK_BLOCKS chunks in the inode table. */
+    unsigned int inodeChunks;
+    /** Number of chunks not written yet. */
+    unsigned int pendingChunks;
+    /** One bit per chunk, set once the chunk's inodes have been written. */
+    unsigned char chunkReady[(SUPERBLOCK_MAX_CHUNKS + 7) / 8];
+} SuperBlock;
+
+extern SuperBlock superblock;
+
+//============================== SUPER BLOCK FUNCTION PROTOTYPES ==================//
+
+/**
+ * @brief Starts a new super block for a file system being made and writes it.
+ * The geometry is taken from the FSM constants. Every chunk of the inode table starts out
+ * unwritten.
+ * @param[in] _inodeChunks Number of chunks in the inode table.
+ * @param[in] _mapsOffset Byte offset of the maps inside the image, 0 if they are kept in files.
+ * @param[in] _lazy True if the chunks are written on first use, false if they are written now.
+ * @return True if the super block was written, false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+Bool superblock_format(unsigned int _inodeChunks, unsigned int _mapsOffset, Bool _lazy);
+
+/**
+ * @brief Loads the super block from the image.
+ * An image without a valid super block is taken as fully written.
+ * @return True if a valid super block was read, false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+Bool superblock_read(void);
+
+/**
+ * @brief Looks for the super block of an image whose geometry is not known yet.
+ * The super block sits at the start of block 1, so each power-of-two block size from
+ * MAX_BLOCK_SIZE down to SUPERBLOCK_MIN_BLOCK_SIZE is tried in turn. The image must be open.
+ * @return True if a super block with a usable geometry was found and loaded, false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+Bool superblock_find(void);
+
+/**
+ * @brief Writes the super block to the image.
+ * @return True if the super block was written, false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+Bool superblock_write(void);
+
+/**
+ * @brief Verify if a chunk of the inode table has been written.
+ * @param[in] _chunk Index of the chunk.
+ * @return True if the chunk is written or outside the table; false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+Bool superblock_chunk_ready(unsigned int _chunk);
+
+/**
+ * @brief Records that a chunk of the inode table has been written and saves the super block.
+ * @param[in] _chunk Index of the chunk.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+void superblock_chunk_set_ready(unsigned int _chunk);
+
+#endif  // SUPERBLOCK_H
@@ -4,6 +4,10 @@
 # *	Author: Michael Lombardi
 # **********************************/
 
+# Usage: ./qaStart.sh [disk mode ...]
+# Runs the driver once per disk mode given (0 stdio, 1 mmap, 2 io_uring, 3 O_DIRECT,
+# 4 RAM) and compares each output with the baseline. With no mode, only stdio is run.
+
 echo ">>> Initializing FS Data..."
 make touch_data
 echo ">>> Cleaning the Project..."
@@ -11,13 +15,28 @@ make clean
 echo ">>> Building..."
 make
 
-#Use input file
-echo ">>> Running the Driver..."
-./test/fsm 1 > test/qaOutput.txt
+modes=("$@")
+if [ ${#modes[@]} -eq 0 ]; then
+    modes=(0)
+fi
 
 #Use stub input file
 #./test/fsm 1 1 > test/qaOutput.txt
 
-echo ">>> Comparing Outputs..."
-diff test/qaOutput.txt test/qaOutputBaseline.txt
+status=0
+for mode in "${modes[@]}"; do
+    #Use input file with the disk backend of this mode; stdio keeps test/qaOutput.txt
+    output=test/qaOutput.txt
+    if [ "$mode" != "0" ]; then
+        output=test/qaOutput$mode.txt
+    fi
+    echo ">>> Running the Driver (disk mode $mode)..."
+    ./test/fsm 1 0 "$mode" > "$output"
 
+    echo ">>> Comparing Outputs (disk mode $mode)..."
+    if ! diff "$output" test/qaOutputBaseline.txt; then
+        echo ">>> Disk mode $mode differs from the baseline"
+        status=1
+    fi
+done
+exit $status
@@ -0,0 +1,1377 @@
+/*******************************************************************************
+ * Disk Access Layer (DAL)
+ * Author: Michael Lombardi
+ *******************************************************************************/
+// O_DIRECT and statx are GNU extensions and must be requested before any system header
+#define _GNU_SOURCE
+#include "disk.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "config.h"
+#include "disk_linux.h"
+#include "fsm_constants.h"
+#include "global_constants.h"
+#include "ssm_constants.h"
+
+//============================== DAL TYPE DEFINITION ==============================//
+struct DiskPool {
+    pthread_t threads[DISK_POOL_THREADS];
+    unsigned int threadCount;
+    pthread_mutex_t lock;
+    // signalled when a batch is posted or the pool is stopped
+    pthread_cond_t work;
+    // signalled when the last request of a batch completes
+    pthread_cond_t done;
+    // runs of the batch currently being served
+    DiskRun *runs;
+    unsigned int count;
+    unsigned int next;
+    unsigned int pending;
+    Bool status;
+    Bool stop;
+};
+
+struct DiskCache {
+    // number of slots and bytes per slot
+    unsigned int capacity;
+    unsigned int blockSize;
+    // capacity * blockSize bytes, aligned for O_DIRECT
+    unsigned char *data;
+    // block held by each slot, -1 if the slot is empty
+    unsigned int *blocks;
+    // clock reference bit of each slot
+    unsigned char *referenced;
+    // hash chains: bucket heads and the next slot in each chain, -1 terminated
+    int *buckets;
+    int *next;
+    unsigned int bucketCount;
+    // clock hand used to pick the next victim
+    unsigned int hand;
+    // write-back state: dirty bit of each slot, how many are set and when the oldest was set
+    unsigned char *dirty;
+    unsigned int dirtyCount;
+    struct timespec firstDirty;
+    // scratch space for flushing, sized for a cache full of dirty blocks
+    struct DiskDirtyBlock *flushList;
+    struct iovec *flushIov;
+};
+
+// a dirty slot and the block it holds, sorted by block number when flushing
+typedef struct DiskDirtyBlock {
+    unsigned int block;
+    unsigned int slot;
+} DiskDirtyBlock;
+
+// a map held in memory under DISK_RAM, keyed by the path it has on disk in the other modes
+typedef struct DiskMap {
+    char *path;
+    unsigned char *data;
+    unsigned int len;
+} DiskMap;
+
+// a map kept inside the image, keyed by the path it would otherwise have on disk
+typedef struct DiskMapPlace {
+    char *path;
+    unsigned int diskOffset;
+} DiskMapPlace;
+
+// start of a DISK_RAM snapshot; followed by each map (path length, path, length, bytes) and then
+// the image
+typedef struct DiskSnapshotHeader {
+    char magic[8];
+    uint32_t imageSize;
+    uint32_t mapCount;
+} DiskSnapshotHeader;
+
+static const char DISK_SNAPSHOT_MAGIC[8] = {'A', 'Z', 'R', 'A', 'M', 'I', 'M', 'G'};
+
+//============================== DAL STRUCT =====================================//
+static Disk disk_instance = {.mode = DISK_STDIO,
+                             .handle = NULL,
+                             .fd = -1,
+                             .map = NULL,
+                             .size = 0,
+                             .dirtyPages = NULL,
+                             .ring = NULL,
+                             .pool = NULL,
+                             .cache = NULL};
+
+Disk *disk = &disk_instance;
+
+static DiskMap ram_maps[DISK_RAM_MAPS];
+
+static DiskMapPlace map_places[DISK_IMAGE_MAPS];
+
+//============================== DAL FUNCTION PROTOTYPES =========================//
+static Bool disk_open_mmap(const char *_path);
+static Bool disk_open_uring(const char *_path);
+static Bool disk_open_direct(const char *_path);
+static Bool disk_open_ram(void);
+static unsigned int direct_alignment(int _fd);
+static DiskMap *ram_map(const char *_path, Bool _create);
+static Bool ram_map_store(DiskMap *_map, const void *_buffer, unsigned int _len);
+static void ram_maps_free(void);
+static void ram_maps_release(DiskMap *_maps);
+static DiskMapPlace *map_place(const char *_path);
+static void map_places_free(void);
+static void mark_dirty_pages(unsigned int _diskOffset, unsigned int _len);
+static Bool sync_dirty_pages(void);
+static Bool pread_full(void *_buffer, unsigned int _diskOffset, unsigned int _len);
+static Bool preadv_full(int _fd, struct iovec *_iov, int _iovCount, off_t _offset);
+static Bool pwritev_full(int _fd, struct iovec *_iov, int _iovCount, off_t _offset);
+static void iov_advance(struct iovec **_iov, int *_iovCount, size_t _bytes);
+static unsigned int build_runs(DiskRequest *_requests, unsigned int _count, struct iovec *_iov,
+                               DiskRun *_runs);
+static Bool read_runs(DiskRun *_runs, unsigned int _count);
+static Bool finish_runs(DiskRun *_runs, unsigned int _count);
+static void prefetch_range(unsigned int _diskOffset, size_t _len);
+static DiskPool *pool_create(void);
+static void pool_destroy(DiskPool *_pool);
+static Bool pool_read_runs(DiskPool *_pool, DiskRun *_runs, unsigned int _count);
+static void *pool_worker(void *_arg);
+static DiskCache *cache_create(unsigned int _capacity, unsigned int _blockSize,
+                               unsigned int _alignment);
+static void cache_destroy(DiskCache *_cache);
+static int cache_lookup(DiskCache *_cache, unsigned int _block);
+static unsigned char *cache_get(DiskCache *_cache, unsigned int _block, Bool _load);
+static Bool cache_read(DiskCache *_cache, void *_buffer, unsigned int _diskOffset,
+                       unsigned int _len);
+static Bool cache_write(DiskCache *_cache, const void *_buffer, unsigned int _diskOffset,
+                        unsigned int _len);
+static void cache_overlay_dirty(DiskCache *_cache, DiskRequest *_requests, unsigned int _count);
+static Bool cache_flush(DiskCache *_cache);
+static void cache_discard(DiskCache *_cache);
+static int compare_dirty_blocks(const void *_a, const void *_b);
+
+//============================== DAL FUNCTION DEFINITIONS =========================//
+Bool disk_open(const char *_path, DiskMode _mode) {
+    disk->mode = _mode;
+    if (_mode == DISK_MMAP) {
+        if (disk_open_mmap(_path)) {
+            return True;
+        }
+        // fall back to the stdio path if the image could not be mapped
+        disk->mode = DISK_STDIO;
+    }
+    if (_mode == DISK_URING) {
+        if (disk_open_uring(_path)) {
+            return True;
+        }
+        disk->mode = DISK_STDIO;
+    }
+    if (_mode == DISK_DIRECT) {
+        if (disk_open_direct(_path)) {
+            return True;
+        }
+        disk->mode = DISK_STDIO;
+    }
+    if (_mode == DISK_RAM) {
+        if (disk_open_ram()) {
+            return True;
+        }
+        disk->mode = DISK_STDIO;
+    }
+    disk->handle = fopen(_path, "rb+");
+    disk->size = 0;
+    return disk->handle != NULL;
+}
+
+/**
+ * @brief Maps the disk image into memory.
+ * Grows the image if needed and maps it shared, so stores into the mapping reach the file.
+ * @param[in] _path Path of the disk image.
+ * @return True if the image was mapped, false otherwise.
+ */
+static Bool disk_open_mmap(const char *_path) {
+    struct stat st;
+    disk->fd = open(_path, O_RDWR);
+    if (disk->fd < 0) {
+        return False;
+    }
+    // the mapping must cover every sector the SSM can hand out
+    size_t size = (size_t)NUM_SECTORS * BLOCK_SIZE;
+    void *map = MAP_FAILED;
+    if (fstat(disk->fd, &st) == SUCCESS) {
+        if ((size_t)st.st_size > size) {
+            size = (size_t)st.st_size;
+        }
+        if ((size_t)st.st_size == size || ftruncate(disk->fd, (off_t)size) == SUCCESS) {
+            map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, disk->fd, 0);
+        }
+    }
+    if (map == MAP_FAILED) {
+        close(disk->fd);
+        disk->fd = -1;
+        return False;
+    }
+    long pageSize = sysconf(_SC_PAGESIZE);
+    size_t pages = (size + (size_t)pageSize - 1) / (size_t)pageSize;
+    disk->map = (unsigned char *)map;
+    disk->size = size;
+    disk->dirtyPages = calloc((pages + BITS_PER_BYTE - 1) / BITS_PER_BYTE, 1);
+    return True;
+}
+
+/**
+ * @brief Opens the disk image for positioned I/O and sets up the batch engine.
+ * An io_uring is preferred; if the kernel does not provide one (ENOSYS, EPERM, ...) the
+ * thread pool takes over. With neither, batches are served by serial preads.
+ * @param[in] _path Path of the disk image.
+ * @return True if the image was opened, false otherwise.
+ */
+static Bool disk_open_uring(const char *_path) {
+    disk->fd = open(_path, O_RDWR);
+    if (disk->fd < 0) {
+        return False;
+    }
+    disk->ring = disk_ring_create(DISK_QUEUE_DEPTH);
+    if (disk->ring == NULL) {
+        disk->pool = pool_create();
+    }
+    // write-back stage; without it writes go straight to the image
+    disk->cache = cache_create(DISK_CACHE_BLOCKS, BLOCK_SIZE, (unsigned int)sysconf(_SC_PAGESIZE));
+    return True;
+}
+
+/**
+ * @brief Opens the disk image with O_DIRECT and allocates the block cache.
+ * Fails if the file system refuses O_DIRECT or if BLOCK_SIZE is not a multiple of the
+ * alignment direct I/O requires on the image.
+ * @param[in] _path Path of the disk image.
+ * @return True if the image was opened, false otherwise.
+ */
+static Bool disk_open_direct(const char *_path) {
+    disk->fd = open(_path, O_RDWR | O_DIRECT);
+    if (disk->fd < 0) {
+        return False;
+    }
+    unsigned int alignment = direct_alignment(disk->fd);
+    if (alignment != 0 && BLOCK_SIZE % alignment == 0) {
+        disk->cache = cache_create(DISK_CACHE_BLOCKS, BLOCK_SIZE, alignment);
+    }
+    if (disk->cache == NULL) {
+        close(disk->fd);
+        disk->fd = -1;
+        return False;
+    }
+    return True;
+}
+
+/**
+ * @brief Allocates a zeroed in-memory image covering every sector the SSM can hand out.
+ * Explicit huge pages are tried first, rounding the image up to whole huge pages; without a
+ * reserved pool the buffer comes from ordinary anonymous memory and is offered to transparent
+ * huge pages, which keeps the TLB footprint of a large image small.
+ * @return True if the image was allocated, false otherwise.
+ */
+static Bool disk_open_ram(void) {
+    size_t size = (size_t)NUM_SECTORS * BLOCK_SIZE;
+    size_t hugeSize = (size + DISK_HUGE_PAGE_SIZE - 1) / DISK_HUGE_PAGE_SIZE * DISK_HUGE_PAGE_SIZE;
+    void *map = mmap(NULL, hugeSize, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (map != MAP_FAILED) {
+        size = hugeSize;
+    } else {
+        map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (map == MAP_FAILED) {
+            return False;
+        }
+        madvise(map, size, MADV_HUGEPAGE);
+    }
+    disk->map = (unsigned char *)map;
+    disk->size = size;
+    return True;
+}
+
+/**
+ * @brief Determines the alignment direct I/O requires on the image.
+ * Uses the logical sector size reported by statx (or BLKSSZGET for a block device), raised to
+ * the buffer alignment if that is stricter.
+ * @param[in] _fd Descriptor of the image opened with O_DIRECT.
+ * @return The alignment in bytes, or 0 if the file system does not support direct I/O.
+ */
+static unsigned int direct_alignment(int _fd) {
+    struct statx stx;
+    memset(&stx, 0, sizeof(stx));
+    if (statx(_fd, "", AT_EMPTY_PATH, STATX_TYPE | STATX_DIOALIGN, &stx) == SUCCESS &&
+        (stx.stx_mask & STATX_DIOALIGN)) {
+        if (stx.stx_dio_offset_align == 0) return 0;
+        return stx.stx_dio_mem_align > stx.stx_dio_offset_align ? stx.stx_dio_mem_align
+                                                                : stx.stx_dio_offset_align;
+    }
+    if ((stx.stx_mask & STATX_TYPE) && S_ISBLK(stx.stx_mode)) {
+        unsigned int sectorSize = disk_blkdev_sector_size(_fd);
+        if (sectorSize > 0) return sectorSize;
+    }
+    // older kernels do not report it; 512 is the smallest logical sector size in use
+    return 512;
+}
+
+Bool disk_close(void) {
+    Bool status = True;
+    if (disk->handle != NULL || disk->fd >= 0) {
+        status = disk_sync();
+    }
+    if (disk->ring != NULL) {
+        disk_ring_destroy(disk->ring);
+        disk->ring = Null;
+    }
+    if (disk->pool != NULL) {
+        pool_destroy(disk->pool);
+        disk->pool = Null;
+    }
+    if (disk->cache != NULL) {
+        cache_destroy(disk->cache);
+        disk->cache = Null;
+    }
+    if (disk->map != NULL) {
+        munmap(disk->map, disk->size);
+        disk->map = Null;
+    }
+    if (disk->fd >= 0) {
+        close(disk->fd);
+        disk->fd = -1;
+    }
+    if (disk->handle != NULL) {
+        fclose(disk->handle);
+        disk->handle = Null;
+    }
+    free(disk->dirtyPages);
+    disk->dirtyPages = Null;
+    disk->size = 0;
+    // a RAM disk is gone once closed, maps included
+    if (disk->mode == DISK_RAM) {
+        ram_maps_free();
+    }
+    map_places_free();
+    return status;
+}
+
+Bool disk_read(void *_buffer, unsigned int _diskOffset, unsigned int _len) {
+    if (disk->mode == DISK_MMAP || disk->mode == DISK_RAM) {
+        if ((size_t)_diskOffset + _len > disk->size) {
+            return False;
+        }
+        memcpy(_buffer, disk->map + _diskOffset, _len);
+        return True;
+    }
+    if (disk->cache != NULL) {
+        return cache_read(disk->cache, _buffer, _diskOffset, _len);
+    }
+    if (disk->mode == DISK_URING) {
+        return pread_full(_buffer, _diskOffset, _len);
+    }
+    if (disk->handle == NULL || fseek(disk->handle, _diskOffset, SEEK_SET) != SUCCESS) {
+        return False;
+    }
+    return fread(_buffer, 1, _len, disk->handle) == _len;
+}
+
+Bool disk_write(const void *_buffer, unsigned int _diskOffset, unsigned int _len) {
+    if (disk->mode == DISK_MMAP || disk->mode == DISK_RAM) {
+        if ((size_t)_diskOffset + _len > disk->size) {
+            return False;
+        }
+        memcpy(disk->map + _diskOffset, _buffer, _len);
+        mark_dirty_pages(_diskOffset, _len);
+        return True;
+    }
+    if (disk->cache != NULL) {
+        return cache_write(disk->cache, _buffer, _diskOffset, _len);
+    }
+    if (disk->mode == DISK_URING) {
+        return pwrite(disk->fd, _buffer, _len, (off_t)_diskOffset) == (ssize_t)_len;
+    }
+    if (disk->handle == NULL || fseek(disk->handle, _diskOffset, SEEK_SET) != SUCCESS) {
+        return False;
+    }
+    return fwrite(_buffer, 1, _len, disk->handle) == _len;
+}
+
+Bool disk_read_batch(DiskRequest *_requests, unsigned int _count) {
+    if (_count == 0) {
+        return True;
+    }
+    Bool status = True;
+    if (disk->mode == DISK_MMAP || disk->mode == DISK_DIRECT || disk->mode == DISK_RAM) {
+        // served from memory (mapping, block cache or RAM image), nothing to gain from merging
+        for (unsigned int i = 0; i < _count; i++) {
+            if (disk_read(_requests[i].buffer, _requests[i].diskOffset, _requests[i].len) ==
+                False) {
+                status = False;
+            }
+        }
+        return status;
+    }
+    // merge requests whose image ranges are adjacent into runs, one preadv per run
+    struct iovec *iov = malloc(_count * sizeof(struct iovec));
+    DiskRun *runs = malloc(_count * sizeof(DiskRun));
+    if (iov == NULL || runs == NULL) {
+        status = False;
+    } else {
+        unsigned int runCount = build_runs(_requests, _count, iov, runs);
+        if (disk->mode == DISK_URING && disk->ring != NULL) {
+            status = disk_ring_read_runs(disk->ring, disk->fd, runs, runCount);
+            if (status == True) status = finish_runs(runs, runCount);
+        } else if (disk->mode == DISK_URING && disk->pool != NULL) {
+            status = pool_read_runs(disk->pool, runs, runCount);
+        } else {
+            status = read_runs(runs, runCount);
+        }
+        // the runs bypass the write-back stage; blocks still waiting in it are newer
+        if (disk->cache != NULL) {
+            cache_overlay_dirty(disk->cache, _requests, _count);
+        }
+    }
+    free(runs);
+    free(iov);
+    return status;
+}
+
+void disk_prefetch(const unsigned int *_diskOffsets, unsigned int _count, unsigned int _len) {
+    unsigned int i = 0;
+    while (i < _count) {
+        // extend the range over blocks that follow each other on disk
+        unsigned int start = _diskOffsets[i];
+        size_t len = _len;
+        for (i++; i < _count && (size_t)start + len == _diskOffsets[i]; i++) {
+            len += _len;
+        }
+        prefetch_range(start, len);
+    }
+}
+
+Bool disk_sync(void) {
+    if (disk->mode == DISK_MMAP) {
+        return sync_dirty_pages();
+    }
+    if (disk->mode == DISK_RAM) {
+        return True;
+    }
+    if (disk->cache != NULL && cache_flush(disk->cache) == False) {
+        return False;
+    }
+    if (disk->mode == DISK_URING || disk->mode == DISK_DIRECT) {
+        return fsync(disk->fd) == SUCCESS;
+    }
+    if (disk->handle == NULL) {
+        return False;
+    }
+    if (fflush(disk->handle) != SUCCESS) {
+        return False;
+    }
+    return fsync(fileno(disk->handle)) == SUCCESS;
+}
+
+Bool disk_discard(unsigned int _size) {
+    if (disk->mode == DISK_RAM) {
+        // dropped pages of a private anonymous mapping come back zero-filled
+        if (madvise(disk->map, disk->size, MADV_DONTNEED) != SUCCESS) {
+            memset(disk->map, 0, disk->size);
+        }
+        return True;
+    }
+    if (disk->cache != NULL) {
+        cache_discard(disk->cache);
+    }
+    if (disk->handle != NULL && fflush(disk->handle) != SUCCESS) {
+        return False;
+    }
+    int fd = disk->handle != NULL ? fileno(disk->handle) : disk->fd;
+    if (fd < 0) {
+        return False;
+    }
+    off_t size = _size;
+    if (disk->mode == DISK_MMAP) {
+        // the mapping must stay backed by the file
+        size = (off_t)disk->size;
+        long pageSize = sysconf(_SC_PAGESIZE);
+        size_t pages = (disk->size + (size_t)pageSize - 1) / (size_t)pageSize;
+        memset(disk->dirtyPages, 0, (pages + BITS_PER_BYTE - 1) / BITS_PER_BYTE);
+    }
+    return ftruncate(fd, 0) == SUCCESS && ftruncate(fd, size) == SUCCESS;
+}
+
+Bool disk_map_read(const char *_path, void *_buffer, unsigned int _len) {
+    DiskMapPlace *place = map_place(_path);
+    if (place != NULL) {
+        return disk_read(_buffer, place->diskOffset, _len);
+    }
+    if (disk->mode == DISK_RAM) {
+        DiskMap *map = ram_map(_path, False);
+        memset(_buffer, 0, _len);
+        if (map == NULL) {
+            return False;
+        }
+        memcpy(_buffer, map->data, map->len < _len ? map->len : _len);
+        return map->len >= _len;
+    }
+    FILE *handle = fopen(_path, "r+");
+    if (handle == NULL) {
+        return False;
+    }
+    Bool status = fread(_buffer, 1, _len, handle) == _len;
+    if (fclose(handle) != SUCCESS) {
+        status = False;
+    }
+    return status;
+}
+
+Bool disk_map_write(const char *_path, const void *_buffer, unsigned int _len) {
+    DiskMapPlace *place = map_place(_path);
+    if (place != NULL) {
+        return disk_write(_buffer, place->diskOffset, _len);
+    }
+    if (disk->mode == DISK_RAM) {
+        return ram_map_store(ram_map(_path, True), _buffer, _len);
+    }
+    FILE *handle = fopen(_path, "r+");
+    if (handle == NULL) {
+        return False;
+    }
+    Bool status = fwrite(_buffer, 1, _len, handle) == _len;
+    if (fclose(handle) != SUCCESS) {
+        status = False;
+    }
+    return status;
+}
+
+Bool disk_map_embed(const char *_path, unsigned int _diskOffset) {
+    DiskMapPlace *place = map_place(_path);
+    if (_diskOffset == (unsigned int)(-1)) {
+        // the map goes back to its own file
+        if (place != NULL) {
+            free(place->path);
+            place->path = Null;
+        }
+        return True;
+    }
+    for (unsigned int i = 0; place == NULL && i < DISK_IMAGE_MAPS; i++) {
+        if (map_places[i].path == NULL) {
+            map_places[i].path = strdup(_path);
+            if (map_places[i].path == NULL) {
+                return False;
+            }
+            place = &map_places[i];
+        }
+    }
+    if (place == NULL) {
+        return False;
+    }
+    place->diskOffset = _diskOffset;
+    return True;
+}
+
+Bool disk_snapshot(const char *_path) {
+    if (disk->mode != DISK_RAM || disk->map == NULL) {
+        return False;
+    }
+    FILE *handle = fopen(_path, "wb");
+    if (handle == NULL) {
+        return False;
+    }
+    // the huge page padding past the last sector is not part of the image
+    size_t imageSize = (size_t)NUM_SECTORS * BLOCK_SIZE;
+    if (imageSize > disk->size) imageSize = disk->size;
+    DiskSnapshotHeader header;
+    memcpy(header.magic, DISK_SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.imageSize = (uint32_t)imageSize;
+    header.mapCount = 0;
+    for (unsigned int i = 0; i < DISK_RAM_MAPS; i++) {
+        if (ram_maps[i].path != NULL) header.mapCount++;
+    }
+    Bool status = fwrite(&header, sizeof(header), 1, handle) == 1;
+    for (unsigned int i = 0; i < DISK_RAM_MAPS && status == True; i++) {
+        if (ram_maps[i].path == NULL) continue;
+        uint32_t pathLen = (uint32_t)strlen(ram_maps[i].path);
+        uint32_t len = ram_maps[i].len;
+        status = fwrite(&pathLen, sizeof(pathLen), 1, handle) == 1 &&
+                 fwrite(ram_maps[i].path, 1, pathLen, handle) == pathLen &&
+                 fwrite(&len, sizeof(len), 1, handle) == 1 &&
+                 fwrite(ram_maps[i].data, 1, len, handle) == len;
+    }
+    if (status == True) {
+        status = fwrite(disk->map, 1, imageSize, handle) == imageSize;
+    }
+    if (fclose(handle) != SUCCESS) {
+        status = False;
+    }
+    return status;
+}
+
+Bool disk_restore(const char *_path) {
+    if (disk->mode != DISK_RAM || disk->map == NULL) {
+        return False;
+    }
+    FILE *handle = fopen(_path, "rb");
+    if (handle == NULL) {
+        return False;
+    }
+    DiskSnapshotHeader header;
+    Bool status = fread(&header, sizeof(header), 1, handle) == 1 &&
+                  memcmp(header.magic, DISK_SNAPSHOT_MAGIC, sizeof(header.magic)) == 0 &&
+                  header.imageSize <= disk->size && header.mapCount <= DISK_RAM_MAPS;
+    // the whole snapshot is read and checked before any of the current state is replaced
+    DiskMap maps[DISK_RAM_MAPS];
+    memset(maps, 0, sizeof(maps));
+    for (uint32_t i = 0; i < header.mapCount && status == True; i++) {
+        uint32_t pathLen;
+        uint32_t len;
+        status = fread(&pathLen, sizeof(pathLen), 1, handle) == 1 && pathLen < PATH_MAX &&
+                 (maps[i].path = malloc(pathLen + 1)) != NULL &&
+                 fread(maps[i].path, 1, pathLen, handle) == pathLen &&
+                 fread(&len, sizeof(len), 1, handle) == 1 &&
+                 (maps[i].data = malloc(len > 0 ? len : 1)) != NULL &&
+                 fread(maps[i].data, 1, len, handle) == len;
+        if (status == True) {
+            maps[i].path[pathLen] = '\0';
+            maps[i].len = len;
+        }
+    }
+    unsigned char *image = status == True ? malloc(header.imageSize > 0 ? header.imageSize : 1)
+                                          : Null;
+    // the image must fill the rest of the file exactly
+    status = status == True && image != NULL &&
+             fread(image, 1, header.imageSize, handle) == header.imageSize &&
+             fgetc(handle) == EOF && feof(handle);
+    fclose(handle);
+    if (status == True) {
+        ram_maps_free();
+        memcpy(ram_maps, maps, sizeof(maps));
+        memcpy(disk->map, image, header.imageSize);
+        memset(disk->map + header.imageSize, 0, disk->size - header.imageSize);
+    } else {
+        ram_maps_release(maps);
+    }
+    free(image);
+    return status;
+}
+
+/**
+ * @brief Finds the in-memory copy of a map (DISK_RAM).
+ * @param[in] _path Path identifying the map.
+ * @param[in] _create Whether to claim a free slot for a map not stored yet.
+ * @return The map, or Null if it is not stored (or no slot is left to create it).
+ */
+static DiskMap *ram_map(const char *_path, Bool _create) {
+    DiskMap *slot = Null;
+    for (unsigned int i = 0; i < DISK_RAM_MAPS; i++) {
+        if (ram_maps[i].path == NULL) {
+            if (slot == NULL) slot = &ram_maps[i];
+        } else if (strcmp(ram_maps[i].path, _path) == 0) {
+            return &ram_maps[i];
+        }
+    }
+    if (_create == False || slot == NULL) {
+        return Null;
+    }
+    slot->path = strdup(_path);
+    if (slot->path == NULL) {
+        return Null;
+    }
+    slot->data = Null;
+    slot->len = 0;
+    return slot;
+}
+
+/**
+ * @brief Replaces the contents of an in-memory map (DISK_RAM).
+ * @param[in,out] _map Map to update, may be Null.
+ * @param[in] _buffer Source buffer.
+ * @param[in] _len Number of bytes to store.
+ * @return True if the map was stored, false otherwise.
+ */
+static Bool ram_map_store(DiskMap *_map, const void *_buffer, unsigned int _len) {
+    if (_map == NULL) {
+        return False;
+    }
+    if (_map->len != _len) {
+        unsigned char *data = realloc(_map->data, _len > 0 ? _len : 1);
+        if (data == NULL) {
+            return False;
+        }
+        _map->data = data;
+        _map->len = _len;
+    }
+    memcpy(_map->data, _buffer, _len);
+    return True;
+}
+
+/**
+ * @brief Releases every in-memory map (DISK_RAM).
+ * @return void
+ */
+static void ram_maps_free(void) {
+    ram_maps_release(ram_maps);
+}
+
+/**
+ * @brief Releases a table of DISK_RAM_MAPS maps and marks every slot free.
+ * @param[in,out] _maps Maps to release.
+ * @return void
+ */
+static void ram_maps_release(DiskMap *_maps) {
+    for (unsigned int i = 0; i < DISK_RAM_MAPS; i++) {
+        free(_maps[i].path);
+        free(_maps[i].data);
+        _maps[i].path = Null;
+        _maps[i].data = Null;
+        _maps[i].len = 0;
+    }
+}
+
+/**
+ * @brief Finds where in the image a map is kept.
+ * @param[in] _path Path identifying the map.
+ * @return The map's place, or Null if the map is kept in its own file.
+ */
+static DiskMapPlace *map_place(const char *_path) {
+    for (unsigned int i = 0; i < DISK_IMAGE_MAPS; i++) {
+        if (map_places[i].path != NULL && strcmp(map_places[i].path, _path) == SUCCESS) {
+            return &map_places[i];
+        }
+    }
+    return Null;
+}
+
+/**
+ * @brief Forgets every map kept in the image.
+ * @return void
+ */
+static void map_places_free(void) {
+    for (unsigned int i = 0; i < DISK_IMAGE_MAPS; i++) {
+        free(map_places[i].path);
+        map_places[i].path = Null;
+    }
+}
+
+/**
+ * @brief Records the pages of the mapping touched by a write.
+ * @param[in] _diskOffset Byte offset of the write.
+ * @param[in] _len Number of bytes written.
+ * @return void
+ */
+static void mark_dirty_pages(unsigned int _diskOffset, unsigned int _len) {
+    if (_len == 0 || disk->dirtyPages == NULL) return;
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t first = _diskOffset / pageSize;
+    size_t last = ((size_t)_diskOffset + _len - 1) / pageSize;
+    for (size_t p = first; p <= last; p++) {
+        disk->dirtyPages[p / BITS_PER_BYTE] |= (unsigned char)(1u << (p % BITS_PER_BYTE));
+    }
+}
+
+/**
+ * @brief Flushes every run of dirty pages with one msync per run.
+ * @return True if all runs were synced, false otherwise.
+ */
+static Bool sync_dirty_pages(void) {
+    if (disk->map == NULL || disk->dirtyPages == NULL) return False;
+    Bool status = True;
+    size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+    size_t pages = (disk->size + pageSize - 1) / pageSize;
+    size_t p = 0;
+    while (p < pages) {
+        if ((disk->dirtyPages[p / BITS_PER_BYTE] & (1u << (p % BITS_PER_BYTE))) == 0) {
+            p++;
+            continue;
+        }
+        // extend the run over consecutive dirty pages
+        size_t start = p;
+        while (p < pages && (disk->dirtyPages[p / BITS_PER_BYTE] & (1u << (p % BITS_PER_BYTE)))) {
+            disk->dirtyPages[p / BITS_PER_BYTE] &= (unsigned char)~(1u << (p % BITS_PER_BYTE));
+            p++;
+        }
+        if (msync(disk->map + start * pageSize, (p - start) * pageSize, MS_SYNC) != SUCCESS) {
+            status = False;
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief Reads `_len` bytes at `_diskOffset` from the image descriptor, retrying short reads.
+ * @param[out] _buffer Destination buffer.
+ * @param[in] _diskOffset Byte offset within the image.
+ * @param[in] _len Number of bytes to read.
+ * @return True if all bytes were read, false otherwise.
+ */
+static Bool pread_full(void *_buffer, unsigned int _diskOffset, unsigned int _len) {
+    size_t done = 0;
+    while (done < _len) {
+        ssize_t res =
+            pread(disk->fd, (char *)_buffer + done, _len - done, (off_t)(_diskOffset + done));
+        if (res < 0 && errno == EINTR) continue;
+        if (res <= 0) return False;
+        done += (size_t)res;
+    }
+    return True;
+}
+
+/**
+ * @brief Reads into an iovec array with preadv, retrying short reads.
+ * @param[in] _fd Descriptor of the image.
+ * @param[in,out] _iov Destination buffers; consumed as they are filled.
+ * @param[in] _iovCount Number of iovecs.
+ * @param[in] _offset Byte offset within the image.
+ * @return True if every buffer was filled, false otherwise.
+ */
+static Bool preadv_full(int _fd, struct iovec *_iov, int _iovCount, off_t _offset) {
+    while (_iovCount > 0) {
+        ssize_t res = preadv(_fd, _iov, _iovCount, _offset);
+        if (res < 0 && errno == EINTR) continue;
+        if (res <= 0) return False;
+        _offset += res;
+        iov_advance(&_iov, &_iovCount, (size_t)res);
+    }
+    return True;
+}
+
+/**
+ * @brief Writes an iovec array with pwritev, retrying short writes.
+ * @param[in] _fd Descriptor of the image.
+ * @param[in,out] _iov Source buffers; consumed as they are written.
+ * @param[in] _iovCount Number of iovecs.
+ * @param[in] _offset Byte offset within the image.
+ * @return True if every buffer was written, false otherwise.
+ */
+static Bool pwritev_full(int _fd, struct iovec *_iov, int _iovCount, off_t _offset) {
+    while (_iovCount > 0) {
+        ssize_t res = pwritev(_fd, _iov, _iovCount, _offset);
+        if (res < 0 && errno == EINTR) continue;
+        if (res <= 0) return False;
+        _offset += res;
+        iov_advance(&_iov, &_iovCount, (size_t)res);
+    }
+    return True;
+}
+
+/**
+ * @brief Drops the bytes already transferred from the front of an iovec array.
+ * @param[in,out] _iov First iovec; advanced past the filled ones.
+ * @param[in,out] _iovCount Number of iovecs left.
+ * @param[in] _bytes Number of bytes transferred.
+ * @return void
+ */
+static void iov_advance(struct iovec **_iov, int *_iovCount, size_t _bytes) {
+    while (*_iovCount > 0 && _bytes >= (*_iov)->iov_len) {
+        _bytes -= (*_iov)->iov_len;
+        (*_iov)++;
+        (*_iovCount)--;
+    }
+    if (*_iovCount > 0) {
+        (*_iov)->iov_base = (char *)(*_iov)->iov_base + _bytes;
+        (*_iov)->iov_len -= _bytes;
+    }
+}
+
+/**
+ * @brief Groups consecutive requests whose image ranges are adjacent into runs.
+ * Within a run, requests whose buffers are also adjacent share one iovec, so a well laid out
+ * file read into one buffer becomes a single plain read per run.
+ * @param[in] _requests Requests in the order given by the caller.
+ * @param[in] _count Number of requests.
+ * @param[out] _iov Iovec storage, at least `_count` entries.
+ * @param[out] _runs Run storage, at least `_count` entries.
+ * @return The number of runs.
+ */
+static unsigned int build_runs(DiskRequest *_requests, unsigned int _count, struct iovec *_iov,
+                               DiskRun *_runs) {
+    unsigned int runCount = 0;
+    unsigned int iovCount = 0;
+    for (unsigned int i = 0; i < _count; i++) {
+        DiskRequest *request = &_requests[i];
+        DiskRun *run = runCount > 0 ? &_runs[runCount - 1] : Null;
+        if (run != NULL && (size_t)run->diskOffset + run->len == request->diskOffset &&
+            run->iovCount < IOV_MAX) {
+            struct iovec *last = &run->iov[run->iovCount - 1];
+            if ((char *)last->iov_base + last->iov_len == (char *)request->buffer) {
+                last->iov_len += request->len;
+            } else {
+                _iov[iovCount++] = (struct iovec){request->buffer, request->len};
+                run->iovCount++;
+            }
+            run->len += request->len;
+        } else {
+            _iov[iovCount] = (struct iovec){request->buffer, request->len};
+            _runs[runCount++] = (DiskRun){&_iov[iovCount], 1, request->diskOffset, request->len, 0};
+            iovCount++;
+        }
+    }
+    return runCount;
+}
+
+/**
+ * @brief Reads each run with one blocking preadv.
+ * The stdio stream is flushed first so the reads see every write buffered in it.
+ * @param[in] _runs Runs to read.
+ * @param[in] _count Number of runs.
+ * @return True if every run was read in full, false otherwise.
+ */
+static Bool read_runs(DiskRun *_runs, unsigned int _count) {
+    int fd = disk->fd;
+    if (disk->mode == DISK_STDIO) {
+        if (disk->handle == NULL || fflush(disk->handle) != SUCCESS) {
+            return False;
+        }
+        fd = fileno(disk->handle);
+    }
+    Bool status = True;
+    for (unsigned int i = 0; i < _count; i++) {
+        if (preadv_full(fd, _runs[i].iov, _runs[i].iovCount, (off_t)_runs[i].diskOffset) == False) {
+            status = False;
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief Reads the rest of each run the ring returned short with preadv.
+ * @param[in] _runs Runs read by `disk_ring_read_runs`.
+ * @param[in] _count Number of runs.
+ * @return True if every run was read in full, false otherwise.
+ */
+static Bool finish_runs(DiskRun *_runs, unsigned int _count) {
+    Bool status = True;
+    for (unsigned int i = 0; i < _count; i++) {
+        DiskRun *run = &_runs[i];
+        if (run->done < run->len) {
+            struct iovec *iov = run->iov;
+            int iovCount = run->iovCount;
+            iov_advance(&iov, &iovCount, run->done);
+            if (preadv_full(disk->fd, iov, iovCount, (off_t)(run->diskOffset + run->done)) ==
+                False) {
+                status = False;
+            }
+        }
+    }
+    return status;
+}
+
+/**
+ * @brief Asks the backend to bring a byte range of the image in ahead of use.
+ * @param[in] _diskOffset Byte offset of the range.
+ * @param[in] _len Length of the range.
+ * @return void
+ */
+static void prefetch_range(unsigned int _diskOffset, size_t _len) {
+    if (disk->mode == DISK_RAM) {
+        return;
+    }
+    if (disk->mode == DISK_MMAP) {
+        if ((size_t)_diskOffset >= disk->size) return;
+        if (_diskOffset + _len > disk->size) _len = disk->size - _diskOffset;
+        // madvise wants a page aligned address
+        size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+        size_t start = _diskOffset - _diskOffset % pageSize;
+        madvise(disk->map + start, _len + (_diskOffset - start), MADV_WILLNEED);
+    } else if (disk->mode == DISK_DIRECT) {
+        for (size_t done = 0; done < _len; done += disk->cache->blockSize) {
+            cache_get(disk->cache, (unsigned int)((_diskOffset + done) / disk->cache->blockSize),
+                      True);
+        }
+    } else {
+        int fd = disk->mode == DISK_STDIO ? (disk->handle ? fileno(disk->handle) : -1) : disk->fd;
+        if (fd >= 0) posix_fadvise(fd, (off_t)_diskOffset, (off_t)_len, POSIX_FADV_WILLNEED);
+    }
+}
+
+/**
+ * @brief Starts the worker threads that serve batches when io_uring is unavailable.
+ * @return The pool, or Null if no worker could be started.
+ */
+static DiskPool *pool_create(void) {
+    DiskPool *pool = calloc(1, sizeof(DiskPool));
+    if (pool == NULL) {
+        return Null;
+    }
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->work, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    for (unsigned int i = 0; i < DISK_POOL_THREADS; i++) {
+        if (pthread_create(&pool->threads[i], NULL, pool_worker, pool) != SUCCESS) {
+            break;
+        }
+        pool->threadCount++;
+    }
+    if (pool->threadCount == 0) {
+        pool_destroy(pool);
+        return Null;
+    }
+    return pool;
+}
+
+/**
+ * @brief Stops and joins the worker threads and releases the pool.
+ * @param[in] _pool Pool to release.
+ * @return void
+ */
+static void pool_destroy(DiskPool *_pool) {
+    pthread_mutex_lock(&_pool->lock);
+    _pool->stop = True;
+    pthread_cond_broadcast(&_pool->work);
+    pthread_mutex_unlock(&_pool->lock);
+    for (unsigned int i = 0; i < _pool->threadCount; i++) {
+        pthread_join(_pool->threads[i], NULL);
+    }
+    pthread_cond_destroy(&_pool->done);
+    pthread_cond_destroy(&_pool->work);
+    pthread_mutex_destroy(&_pool->lock);
+    free(_pool);
+}
+
+/**
+ * @brief Posts a batch of runs to the pool and waits until every run has completed.
+ * @param[in] _pool Pool serving the batch.
+ * @param[in,out] _runs Runs to read.
+ * @param[in] _count Number of runs.
+ * @return True if every run was read in full, false otherwise.
+ */
+static Bool pool_read_runs(DiskPool *_pool, DiskRun *_runs, unsigned int _count) {
+    pthread_mutex_lock(&_pool->lock);
+    _pool->runs = _runs;
+    _pool->count = _count;
+    _pool->next = 0;
+    _pool->pending = _count;
+    _pool->status = True;
+    pthread_cond_broadcast(&_pool->work);
+    while (_pool->pending > 0) {
+        pthread_cond_wait(&_pool->done, &_pool->lock);
+    }
+    Bool status = _pool->status;
+    _pool->runs = Null;
+    _pool->count = 0;
+    _pool->next = 0;
+    pthread_mutex_unlock(&_pool->lock);
+    return status;
+}
+
+/**
+ * @brief Worker loop: claims runs from the posted batch and preadvs them.
+ * @param[in] _arg The pool the worker belongs to.
+ * @return Null
+ */
+static void *pool_worker(void *_arg) {
+    DiskPool *pool = _arg;
+    pthread_mutex_lock(&pool->lock);
+    while (True) {
+        while (pool->stop == False && pool->next >= pool->count) {
+            pthread_cond_wait(&pool->work, &pool->lock);
+        }
+        if (pool->stop == True) break;
+        DiskRun *run = &pool->runs[pool->next++];
+        pthread_mutex_unlock(&pool->lock);
+        Bool status = preadv_full(disk->fd, run->iov, run->iovCount, (off_t)run->diskOffset);
+        pthread_mutex_lock(&pool->lock);
+        if (status == False) pool->status = False;
+        if (--pool->pending == 0) pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return Null;
+}
+
+/**
+ * @brief Allocates a block cache whose slots all come from one aligned pool.
+ * @param[in] _capacity Number of blocks the cache holds.
+ * @param[in] _blockSize Bytes per block.
+ * @param[in] _alignment Alignment of the pool (and, since `_blockSize` is a multiple of it,
+ * of every slot).
+ * @return The cache, or Null if it could not be allocated.
+ */
+static DiskCache *cache_create(unsigned int _capacity, unsigned int _blockSize,
+                               unsigned int _alignment) {
+    DiskCache *cache = calloc(1, sizeof(DiskCache));
+    if (cache == NULL) {
+        return Null;
+    }
+    void *data = Null;
+    if (posix_memalign(&data, _alignment < sizeof(void *) ? sizeof(void *) : _alignment,
+                       (size_t)_capacity * _blockSize) != SUCCESS) {
+        free(cache);
+        return Null;
+    }
+    cache->capacity = _capacity;
+    cache->blockSize = _blockSize;
+    cache->data = data;
+    cache->bucketCount = 2 * _capacity;
+    cache->blocks = malloc(_capacity * sizeof(unsigned int));
+    cache->referenced = calloc(_capacity, 1);
+    cache->next = malloc(_capacity * sizeof(int));
+    cache->buckets = malloc(cache->bucketCount * sizeof(int));
+    cache->dirty = calloc(_capacity, 1);
+    cache->flushList = malloc(_capacity * sizeof(DiskDirtyBlock));
+    cache->flushIov = malloc(_capacity * sizeof(struct iovec));
+    if (cache->blocks == NULL || cache->referenced == NULL || cache->next == NULL ||
+        cache->buckets == NULL || cache->dirty == NULL || cache->flushList == NULL ||
+        cache->flushIov == NULL) {
+        cache_destroy(cache);
+        return Null;
+    }
+    memset(cache->blocks, UINT8_MAX, _capacity * sizeof(unsigned int));
+    memset(cache->next, UINT8_MAX, _capacity * sizeof(int));
+    memset(cache->buckets, UINT8_MAX, cache->bucketCount * sizeof(int));
+    return cache;
+}
+
+/**
+ * @brief Releases the block cache and its pool.
+ * @param[in] _cache Cache to release.
+ * @return void
+ */
+static void cache_destroy(DiskCache *_cache) {
+    free(_cache->flushIov);
+    free(_cache->flushList);
+    free(_cache->dirty);
+    free(_cache->buckets);
+    free(_cache->next);
+    free(_cache->referenced);
+    free(_cache->blocks);
+    free(_cache->data);
+    free(_cache);
+}
+
+/**
+ * @brief Finds the slot holding a block.
+ * @param[in] _cache Cache to look in.
+ * @param[in] _block Block number.
+ * @return The slot, or -1 if the block is not cached.
+ */
+static int cache_lookup(DiskCache *_cache, unsigned int _block) {
+    int slot = _cache->buckets[_block % _cache->bucketCount];
+    while (slot >= 0 && _cache->blocks[slot] != _block) {
+        slot = _cache->next[slot];
+    }
+    return slot;
+}
+
+/**
+ * @brief Returns the cached copy of a block, bringing it in on a miss.
+ * On a miss the clock hand picks a victim slot; if the victim is dirty, every dirty block is
+ * written back first. With `_load` the block is read from the image (bytes past the end of the
+ * image read as zero).
+ * @param[in] _cache Cache to look in.
+ * @param[in] _block Block number.
+ * @param[in] _load Whether a missing block must be read from the image.
+ * @return The block's bytes, or Null if it could not be read.
+ */
+static unsigned char *cache_get(DiskCache *_cache, unsigned int _block, Bool _load) {
+    unsigned int bucket = _block % _cache->bucketCount;
+    int slot = cache_lookup(_cache, _block);
+    if (slot >= 0) {
+        _cache->referenced[slot] = 1;
+        return _cache->data + (size_t)slot * _cache->blockSize;
+    }
+    // advance the clock hand past recently used slots
+    while (_cache->referenced[_cache->hand]) {
+        _cache->referenced[_cache->hand] = 0;
+        _cache->hand = (_cache->hand + 1) % _cache->capacity;
+    }
+    int victim = (int)_cache->hand;
+    _cache->hand = (_cache->hand + 1) % _cache->capacity;
+    if (_cache->dirty[victim] && cache_flush(_cache) == False) {
+        return Null;
+    }
+    // unlink the victim from the chain of the block it held
+    if (_cache->blocks[victim] != (unsigned int)(-1)) {
+        int *link = &_cache->buckets[_cache->blocks[victim] % _cache->bucketCount];
+        while (*link != victim) link = &_cache->next[*link];
+        *link = _cache->next[victim];
+        _cache->blocks[victim] = (unsigned int)(-1);
+    }
+    unsigned char *data = _cache->data + (size_t)victim * _cache->blockSize;
+    if (_load) {
+        ssize_t res = pread(disk->fd, data, _cache->blockSize, (off_t)_block * _cache->blockSize);
+        if (res < 0) {
+            return Null;
+        }
+        memset(data + res, 0, _cache->blockSize - (size_t)res);
+    }
+    _cache->blocks[victim] = _block;
+    _cache->referenced[victim] = 1;
+    _cache->next[victim] = _cache->buckets[bucket];
+    _cache->buckets[bucket] = victim;
+    return data;
+}
+
+/**
+ * @brief Reads a byte range through the block cache.
+ * @param[in] _cache Cache serving the range.
+ * @param[out] _buffer Destination buffer.
+ * @param[in] _diskOffset Byte offset within the image.
+ * @param[in] _len Number of bytes to read.
+ * @return True if all bytes were read, false otherwise.
+ */
+static Bool cache_read(DiskCache *_cache, void *_buffer, unsigned int _diskOffset,
+                       unsigned int _len) {
+    unsigned char *buffer = _buffer;
+    while (_len > 0) {
+        unsigned int offset = _diskOffset % _cache->blockSize;
+        unsigned int part = _cache->blockSize - offset < _len ? _cache->blockSize - offset : _len;
+        unsigned char *data = cache_get(_cache, _diskOffset / _cache->blockSize, True);
+        if (data == NULL) {
+            return False;
+        }
+        memcpy(buffer, data + offset, part);
+        buffer += part;
+        _diskOffset += part;
+        _len -= part;
+    }
+    return True;
+}
+
+/**
+ * @brief Writes a byte range into the block cache.
+ * Each touched block is updated in the cache (read first unless it is overwritten whole) and
+ * marked dirty. The dirty blocks are written back together once DISK_DIRTY_LIMIT of them
+ * have collected or the oldest has waited DISK_WRITEBACK_MS, on `disk_sync`, or when a dirty
+ * block has to be evicted. The age is only checked here, so an idle cache is not flushed.
+ * @param[in] _cache Cache serving the range.
+ * @param[in] _buffer Source buffer.
+ * @param[in] _diskOffset Byte offset within the image.
+ * @param[in] _len Number of bytes to write.
+ * @return True if all bytes were written, false otherwise.
+ */
+static Bool cache_write(DiskCache *_cache, const void *_buffer, unsigned int _diskOffset,
+                        unsigned int _len) {
+    const unsigned char *buffer = _buffer;
+    while (_len > 0) {
+        unsigned int block = _diskOffset / _cache->blockSize;
+        unsigned int offset = _diskOffset % _cache->blockSize;
+        unsigned int part = _cache->blockSize - offset < _len ? _cache->blockSize - offset : _len;
+        unsigned char *data = cache_get(_cache, block, part != _cache->blockSize);
+        if (data == NULL) {
+            return False;
+        }
+        memcpy(data + offset, buffer, part);
+        size_t slot = (size_t)(data - _cache->data) / _cache->blockSize;
+        if (_cache->dirty[slot] == 0) {
+            _cache->dirty[slot] = 1;
+            if (_cache->dirtyCount++ == 0) {
+                clock_gettime(CLOCK_MONOTONIC, &_cache->firstDirty);
+            }
+        }
+        buffer += part;
+        _diskOffset += part;
+        _len -= part;
+    }
+    if (_cache->dirtyCount >= DISK_DIRTY_LIMIT) {
+        return cache_flush(_cache);
+    }
+    // the write-back timer is checked lazily, on the next write after it expires
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    long long elapsed = (now.tv_sec - _cache->firstDirty.tv_sec) * 1000LL +
+                        (now.tv_nsec - _cache->firstDirty.tv_nsec) / 1000000;
+    if (_cache->dirtyCount > 0 && elapsed >= DISK_WRITEBACK_MS) {
+        return cache_flush(_cache);
+    }
+    return True;
+}
+
+/**
+ * @brief Copies blocks still waiting in the write-back stage over data read from the image.
+ * @param[in] _cache Cache holding the dirty blocks.
+ * @param[in,out] _requests Requests whose buffers were filled from the image.
+ * @param[in] _count Number of requests.
+ * @return void
+ */
+static void cache_overlay_dirty(DiskCache *_cache, DiskRequest *_requests, unsigned int _count) {
+    if (_cache->dirtyCount == 0) return;
+    for (unsigned int i = 0; i < _count; i++) {
+        unsigned int diskOffset = _requests[i].diskOffset;
+        unsigned char *buffer = _requests[i].buffer;
+        unsigned int len = _requests[i].len;
+        while (len > 0) {
+            unsigned int offset = diskOffset % _cache->blockSize;
+            unsigned int part = _cache->blockSize - offset < len ? _cache->blockSize - offset : len;
+            int slot = cache_lookup(_cache, diskOffset / _cache->blockSize);
+            if (slot >= 0 && _cache->dirty[slot]) {
+                memcpy(buffer, _cache->data + (size_t)slot * _cache->blockSize + offset, part);
+            }
+            buffer += part;
+            diskOffset += part;
+            len -= part;
+        }
+    }
+}
+
+/**
+ * @brief Writes every dirty block back to the image.
+ * The dirty blocks are sorted by block number and each run of consecutive blocks is written
+ * with one pwritev, so the image is written in order with as few calls as possible.
+ * @param[in] _cache Cache holding the dirty blocks.
+ * @return True if every dirty block was written, false otherwise.
+ */
+static Bool cache_flush(DiskCache *_cache) {
+    if (_cache->dirtyCount == 0) {
+        return True;
+    }
+    unsigned int count = 0;
+    for (unsigned int slot = 0; slot < _cache->capacity; slot++) {
+        if (_cache->dirty[slot]) {
+            _cache->flushList[count++] = (DiskDirtyBlock){_cache->blocks[slot], slot};
+        }
+    }
+    qsort(_cache->flushList, count, sizeof(DiskDirtyBlock), compare_dirty_blocks);
+    Bool status = True;
+    unsigned int i = 0;
+    while (i < count) {
+        // gather the run of consecutive blocks starting at flushList[i]
+        unsigned int first = _cache->flushList[i].block;
+        int iovCount = 0;
+        do {
+            unsigned int slot = _cache->flushList[i].slot;
+            _cache->flushIov[iovCount++] =
+                (struct iovec){_cache->data + (size_t)slot * _cache->blockSize, _cache->blockSize};
+            _cache->dirty[slot] = 0;
+            i++;
+        } while (i < count && iovCount < IOV_MAX &&
+                 _cache->flushList[i].block == first + (unsigned int)iovCount);
+        if (pwritev_full(disk->fd, _cache->flushIov, iovCount, (off_t)first * _cache->blockSize) ==
+            False) {
+            status = False;
+        }
+    }
+    _cache->dirtyCount = 0;
+    return status;
+}
+
+/**
+ * @brief Empties the cache without writing anything back.
+ * @param[in] _cache Cache to empty.
+ * @return void
+ */
+static void cache_discard(DiskCache *_cache) {
+    memset(_cache->blocks, UINT8_MAX, _cache->capacity * sizeof(unsigned int));
+    memset(_cache->next, UINT8_MAX, _cache->capacity * sizeof(int));
+    memset(_cache->buckets, UINT8_MAX, _cache->bucketCount * sizeof(int));
+    memset(_cache->referenced, 0, _cache->capacity);
+    memset(_cache->dirty, 0, _cache->capacity);
+    _cache->dirtyCount = 0;
+    _cache->hand = 0;
+}
+
+/**
+ * @brief Orders dirty blocks by block number for `qsort`.
+ * @param[in] _a First DiskDirtyBlock.
+ * @param[in] _b Second DiskDirtyBlock.
+ * @return Negative, zero or positive as `_a` sorts before, with or after `_b`.
+ */
+static int compare_dirty_blocks(const void *_a, const void *_b) {
+    unsigned int a = ((const DiskDirtyBlock *)_a)->block;
+    unsigned int b = ((const DiskDirtyBlock *)_b)->block;
+    return (a > b) - (a < b);
+}
@@ -0,0 +1,190 @@
+/*******************************************************************************
+ * Disk Access Layer (DAL) - Linux kernel interfaces
+ * Author: Michael Lombardi
+ *******************************************************************************/
+#include "disk_linux.h"
+
+#include <errno.h>
+#include <linux/fs.h>
+#include <linux/io_uring.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+//============================== DAL TYPE DEFINITION ==============================//
+struct DiskRing {
+    // file descriptor returned by io_uring_setup
+    int fd;
+    // submission queue ring
+    unsigned int *sqHead;
+    unsigned int *sqTail;
+    unsigned int *sqMask;
+    unsigned int *sqArray;
+    struct io_uring_sqe *sqes;
+    unsigned int sqEntries;
+    // completion queue ring
+    unsigned int *cqHead;
+    unsigned int *cqTail;
+    unsigned int *cqMask;
+    struct io_uring_cqe *cqes;
+    // mappings to release on teardown
+    void *sqRing;
+    size_t sqRingSize;
+    void *cqRing;
+    size_t cqRingSize;
+    size_t sqesSize;
+};
+
+//============================== DAL FUNCTION PROTOTYPES =========================//
+static unsigned int ring_reap(DiskRing *_ring, DiskRun *_runs, Bool *_status);
+
+//============================== DAL FUNCTION DEFINITIONS =========================//
+DiskRing *disk_ring_create(unsigned int _entries) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = (int)syscall(__NR_io_uring_setup, _entries, &params);
+    if (fd < 0) {
+        return Null;
+    }
+    DiskRing *ring = calloc(1, sizeof(DiskRing));
+    if (ring == NULL) {
+        close(fd);
+        return Null;
+    }
+    ring->fd = fd;
+    ring->sqEntries = params.sq_entries;
+    ring->sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    ring->cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ring->sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    ring->sqRing = mmap(NULL, ring->sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        fd, IORING_OFF_SQ_RING);
+    ring->cqRing = mmap(NULL, ring->cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                        fd, IORING_OFF_CQ_RING);
+    ring->sqes = mmap(NULL, ring->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd,
+                      IORING_OFF_SQES);
+    if (ring->sqRing == MAP_FAILED || ring->cqRing == MAP_FAILED || ring->sqes == MAP_FAILED) {
+        disk_ring_destroy(ring);
+        return Null;
+    }
+    unsigned char *sq = ring->sqRing;
+    unsigned char *cq = ring->cqRing;
+    ring->sqHead = (unsigned int *)(sq + params.sq_off.head);
+    ring->sqTail = (unsigned int *)(sq + params.sq_off.tail);
+    ring->sqMask = (unsigned int *)(sq + params.sq_off.ring_mask);
+    ring->sqArray = (unsigned int *)(sq + params.sq_off.array);
+    ring->cqHead = (unsigned int *)(cq + params.cq_off.head);
+    ring->cqTail = (unsigned int *)(cq + params.cq_off.tail);
+    ring->cqMask = (unsigned int *)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+    return ring;
+}
+
+void disk_ring_destroy(DiskRing *_ring) {
+    if (_ring->sqes != NULL && _ring->sqes != MAP_FAILED) {
+        munmap(_ring->sqes, _ring->sqesSize);
+    }
+    if (_ring->cqRing != NULL && _ring->cqRing != MAP_FAILED) {
+        munmap(_ring->cqRing, _ring->cqRingSize);
+    }
+    if (_ring->sqRing != NULL && _ring->sqRing != MAP_FAILED) {
+        munmap(_ring->sqRing, _ring->sqRingSize);
+    }
+    close(_ring->fd);
+    free(_ring);
+}
+
+Bool disk_ring_read_runs(DiskRing *_ring, int _fd, DiskRun *_runs, unsigned int _count) {
+    Bool status = True;
+    unsigned int first = 0;
+    while (first < _count) {
+        unsigned int n = _count - first;
+        if (n > _ring->sqEntries) n = _ring->sqEntries;
+        // fill one submission queue entry per run
+        unsigned int tail = *_ring->sqTail;
+        for (unsigned int i = 0; i < n; i++) {
+            DiskRun *run = &_runs[first + i];
+            unsigned int index = tail & *_ring->sqMask;
+            struct io_uring_sqe *sqe = &_ring->sqes[index];
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_READV;
+            sqe->fd = _fd;
+            sqe->addr = (uint64_t)(uintptr_t)run->iov;
+            sqe->len = (unsigned int)run->iovCount;
+            sqe->off = run->diskOffset;
+            sqe->user_data = first + i;
+            _ring->sqArray[index] = index;
+            tail++;
+        }
+        __atomic_store_n(_ring->sqTail, tail, __ATOMIC_RELEASE);
+        // submit the whole chunk and wait for its completions in one call
+        unsigned int toSubmit = n;
+        unsigned int reaped = 0;
+        while (reaped < n) {
+            long res = syscall(__NR_io_uring_enter, _ring->fd, toSubmit, n - reaped,
+                               IORING_ENTER_GETEVENTS, NULL, 0);
+            if (res < 0 && errno != EINTR) {
+                break;
+            }
+            if (res > 0) toSubmit -= (unsigned int)res;
+            reaped += ring_reap(_ring, _runs, &status);
+        }
+        if (reaped < n) {
+            // withdraw the entries the kernel has not taken; the taken ones are still reading
+            // into the caller's buffers, so they are reaped before the batch gives up
+            unsigned int head = __atomic_load_n(_ring->sqHead, __ATOMIC_ACQUIRE);
+            __atomic_store_n(_ring->sqTail, head, __ATOMIC_RELEASE);
+            unsigned int submitted = n - (tail - head);
+            while (reaped < submitted) {
+                if (syscall(__NR_io_uring_enter, _ring->fd, 0, submitted - reaped,
+                            IORING_ENTER_GETEVENTS, NULL, 0) < 0 &&
+                    errno != EINTR) {
+                    // completions are still posted to the mapped ring without a wait
+                    sched_yield();
+                }
+                reaped += ring_reap(_ring, _runs, &status);
+            }
+            return False;
+        }
+        first += n;
+    }
+    return status;
+}
+
+/**
+ * @brief Reaps the completions waiting on the ring.
+ * A run that failed sets `_status` to false; the bytes a run got are recorded in its `done`.
+ * @param[in] _ring Ring to reap.
+ * @param[in,out] _runs Runs of the batch, indexed by each completion's user data.
+ * @param[out] _status Set to false if a run could not be read in full, left alone otherwise.
+ * @return The number of completions reaped.
+ */
+static unsigned int ring_reap(DiskRing *_ring, DiskRun *_runs, Bool *_status) {
+    unsigned int reaped = 0;
+    unsigned int head = *_ring->cqHead;
+    while (head != __atomic_load_n(_ring->cqTail, __ATOMIC_ACQUIRE)) {
+        struct io_uring_cqe *cqe = &_ring->cqes[head & *_ring->cqMask];
+        DiskRun *run = &_runs[cqe->user_data];
+        if (cqe->res < 0) {
+            *_status = False;
+        } else {
+            run->done = (size_t)cqe->res;
+        }
+        head++;
+        reaped++;
+    }
+    __atomic_store_n(_ring->cqHead, head, __ATOMIC_RELEASE);
+    return reaped;
+}
+
+unsigned int disk_blkdev_sector_size(int _fd) {
+    int sectorSize = 0;
+    if (ioctl(_fd, BLKSSZGET, &sectorSize) != SUCCESS || sectorSize <= 0) {
+        return 0;
+    }
+    return (unsigned int)sectorSize;
+}
@@ -5,32 +5,181 @@
 #include "fsm.h"
 
 #include <math.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "config.h"
+#include "disk.h"
 #include "fsm_constants.h"
 #include "global_constants.h"
 #include "inode.h"
 #include "ssm.h"
+#include "superblock.h"
 
 // @todo look for inline opportunities
 // @todo revisit return status and exception handling
 // @todo replace literals with constants
 
-static FSM fsm_instance = {.diskHandle = NULL};
+static FSM fsm_instance = {
+    .diskMode = DISK_STDIO, .residentInodes = False, .inlineData = False, .extentFiles = False,
+    .lazyInodes = False, .embeddedMaps = False, .sparseFiles = False, .dirIndex = False};
 
 FSM *fsm = &fsm_instance;
 
 //================================ TYPES ==================================//
 typedef enum PointerType { SINGLE, DOUBLE, TRIPLE } PointerType;
 
+// Data blocks of a file in file order, each paired with its place in the read buffer
+typedef struct BlockList {
+    DiskRequest *requests;
+    unsigned int count;
+    unsigned int capacity;
+    // end of the file in the read buffer; holes before it read as zeros. Null when unmapped
+    // blocks are skipped instead (directories)
+    char *end;
+} BlockList;
+
+// Sectors waiting to be handed back to the SSM together
+typedef struct SectorBatch {
+    unsigned int sectors[FREE_BATCH_SECTORS];
+    unsigned int count;
+} SectorBatch;
+
+// Pointer blocks last read at each level of indirection while mapping blocks of a file
+typedef struct PointerPath {
+    unsigned int offset[3];
+    unsigned int ptrs[3][MAX_BLOCK_SIZE / 4];
+} PointerPath;
+
+// Sequential readahead state of one file
+typedef struct Readahead {
+    unsigned int inodeNum;
+    // block a sequential reader asks for next
+    unsigned int nextBlock;
+    // number of blocks prefetched past a sequential read
+    unsigned int window;
+} Readahead;
+
+static Readahead readahead[READAHEAD_FILES];
+
+// Logical-to-physical block map of one file, built the first time its blocks are mapped
+typedef struct BlockMap {
+    unsigned int inodeNum;
+    // inode the map was built from; any difference means the file changed since
+    Inode source;
+    // disk offset of each block of the file, -1 for holes
+    unsigned int *blocks;
+    unsigned int count;
+} BlockMap;
+
+static BlockMap block_maps[BLOCK_MAP_FILES];
+
+// A file opened with fs_open: what reading and writing it needs, kept between calls
+typedef struct FileHandle {
+    Bool open;
+    unsigned int inodeNum;
+    // copy of the file's inode; reread only when the file changed through another call
+    Inode inode;
+    Bool stale;
+    // byte offset of the next fs_read or fs_write
+    unsigned int offset;
+    BlockMap map;
+    Readahead readahead;
+} FileHandle;
+
+static FileHandle handles[MAX_OPEN_FILES];
+
+// A run of contiguous data blocks of a file
+typedef struct Extent {
+    // index of the run's first block within the file
+    unsigned int logical;
+    // disk offset of the run's first block
+    unsigned int start;
+    // number of blocks in the run
+    unsigned int length;
+} Extent;
+
+// Extents of a file: INODE_EXTENT_SLOTS in the inode, the rest in one extent block
+#define MAX_EXTENTS (INODE_EXTENT_SLOTS + MAX_BLOCK_SIZE / sizeof(Extent))
+
+// A node of a directory's name index is a block holding its level (0 for a leaf), its number of
+// pairs and then (hash, value) pairs sorted by hash. A leaf's values are the disk offsets of
+// entries; an interior node's are child nodes, each covering hashes from its own up to the next
+#define INDEX_PAIRS ((BLOCK_SIZE / 4 - 2) / 2)
+
+// Called for each used entry while walking a directory; returning True stops the walk
+typedef Bool (*EntryVisitor)(const unsigned int *_entry, unsigned int _entryOffset, void *_arg);
+
+// A name looked for while walking a directory, and the inode number found for it
+typedef struct NameSearch {
+    const unsigned int *name;
+    unsigned int inodeNum;
+} NameSearch;
+
+// Disk offset of the entry create_file wrote last, -1 if it went into an inline directory
+static unsigned int dir_entry_offset = (unsigned int)(-1);
+
+// A name in a directory and the inode it refers to, as last looked up or changed
+typedef struct Dentry {
+    Bool used;
+    unsigned int inodeNumD;
+    unsigned int name[2];
+    // -1 for a negative entry: the directory has no file of that name
+    unsigned int inodeNum;
+} Dentry;
+
+static Dentry dentries[DENTRY_CACHE_SIZE];
+
+// Where the next entry of a directory can go without scanning its blocks
+typedef struct DirSlots {
+    Bool used;
+    unsigned int inodeNumD;
+    // entry block last seen with a free slot, -1 if none is known
+    unsigned int block;
+    // whether every other entry block of the directory is known to be full
+    Bool othersFull;
+} DirSlots;
+
+static DirSlots dir_slots[DIR_SLOT_DIRS];
+
+// Whether the entry create_file wrote last went into a block it had to add to the directory
+static Bool dir_entry_new_block = False;
+
+// Disk offset of the entry a remove or rename looks at first, -1 to go through every block
+static unsigned int dir_entry_hint = (unsigned int)(-1);
+
 //========================= FSM FUNCTION PROTOTYPES =======================//
 static void init_file_sector_mgr(int _initSsmMaps);
 static void init_fsm_maps(void);
+static void place_maps(unsigned int _mapsOffset);
+static unsigned int maps_blocks(void);
 static Bool is_not_null(unsigned int _ptr);
 static Bool is_null(unsigned int _ptr);
+static Bool is_inline(const Inode *_inode);
+static Bool has_no_blocks(const Inode *_inode);
+static Bool block_is_zero(const void *_buffer, unsigned int _len);
+static Bool sparse_files(void);
+static Bool sparse_block(const void *_buffer);
+static Bool write_inline(unsigned int _inodeNum, const void *_buffer, unsigned int _size);
+static Bool add_inline_entry(unsigned int _inodeNumF, unsigned int *_name,
+                             unsigned int _inodeNumD);
+static Bool expand_inline_dir(unsigned int _inodeNumD);
+static Bool is_extent(const Inode *_inode);
+static unsigned int extent_load(Extent *_extents);
+static Bool extent_store(unsigned int _inodeNum, const Extent *_extents, unsigned int _count);
+static unsigned int extent_map_block(unsigned int _fileBlock, PointerPath *_path, Bool _load,
+                                     unsigned int *_pending);
+static void extent_truncate(Extent *_extents, unsigned int *_count, unsigned int _blocks);
+static Bool extent_grow(Extent *_extents, unsigned int *_count, unsigned int _first,
+                        unsigned int _blocks);
+static Bool extent_block_is_zero(const char *_buffer, unsigned int _size, unsigned int _block);
+static Bool extent_insert(Extent *_extents, unsigned int *_count, unsigned int _logical,
+                          unsigned int _start);
+static Bool extent_allocate(Extent *_extents, unsigned int *_count, unsigned int _first,
+                            unsigned int _end);
+static Bool write_extents(unsigned int _inodeNum, const void *_buffer, unsigned int _size);
 static Bool create_file(unsigned int _inodeNumF, unsigned int *_name, unsigned int _inodeNumD);
 static Bool create_file_in_avail_indirect_loc(unsigned int _inodeNumF, unsigned int *_file_name,
                                               Bool _allocate);
@@ -82,9 +231,42 @@ static void write_to_double_indirect_blocks(unsigned int _baseOffset, void *_buf
                                             unsigned int _dIndirectPtrs);
 static void write_to_triple_indirect_blocks(unsigned int _baseOffset, void *_buffer,
                                             unsigned int _tIndirectPtrs);
-static void read_from_single_indirect_blocks(void *_buffer, unsigned int _diskOffset);
-static void read_from_double_indirect_blocks(void *_buffer, unsigned int _diskOffset);
-static void read_from_triple_indirect_blocks(void *_buffer, unsigned int _diskOffset);
+static Bool block_list_append(BlockList *_list, void *_buffer, unsigned int _diskOffset);
+static Bool block_list_hole(BlockList *_list, void *_buffer, unsigned int _blocks);
+static Bool list_single_indirect_blocks(BlockList *_list, void *_buffer, unsigned int _diskOffset);
+static Bool list_double_indirect_blocks(BlockList *_list, void *_buffer, unsigned int _diskOffset);
+static Bool list_triple_indirect_blocks(BlockList *_list, void *_buffer, unsigned int _diskOffset);
+static unsigned int map_file_block(unsigned int _fileBlock, PointerPath *_path, Bool _load,
+                                   unsigned int *_pending);
+static unsigned int aloc_pointer_block(void);
+static unsigned int aloc_file_block(unsigned int _fileBlock, PointerPath *_path);
+static Bool aloc_file_blocks(unsigned int _inodeNum, unsigned int _first, unsigned int _end);
+static Bool inline_to_blocks(unsigned int _inodeNum);
+static void zero_file_tail(unsigned int _size, PointerPath *_path);
+static void sector_batch_add(SectorBatch *_batch, unsigned int _diskOffset);
+static void sector_batch_flush(SectorBatch *_batch);
+static Bool truncate_single_indirect_blocks(unsigned int _diskOffset, unsigned int _keep,
+                                            SectorBatch *_batch);
+static Bool truncate_double_indirect_blocks(unsigned int _diskOffset, unsigned int _keep,
+                                            SectorBatch *_batch);
+static Bool truncate_triple_indirect_blocks(unsigned int _diskOffset, unsigned int _keep,
+                                            SectorBatch *_batch);
+static BlockMap *block_map_get(unsigned int _inodeNum);
+static BlockMap *block_map_fill(BlockMap *_map, unsigned int _inodeNum);
+static unsigned int block_map_lookup(BlockMap *_map, unsigned int _fileBlock, PointerPath *_path,
+                                     Bool _load, unsigned int *_pending);
+static void block_map_invalidate(unsigned int _inodeNum);
+static void block_map_invalidate_all(void);
+static void read_ahead(Readahead *_state, unsigned int _inodeNum, unsigned int _firstBlock,
+                       unsigned int _count, BlockMap *_map, PointerPath *_path);
+static void stream_prefetch(const FileStream *_stream);
+static Bool read_blocks(unsigned int _inodeNum, unsigned int _firstBlock, unsigned int _count,
+                        void *_buffer, BlockMap *_map, Readahead *_state);
+static long long int read_range(unsigned int _inodeNum, void *_buffer, unsigned int _len,
+                                unsigned int _offset, BlockMap *_map, Readahead *_state);
+static long long int write_range(unsigned int _inodeNum, const void *_buffer, unsigned int _len,
+                                 unsigned int _offset, BlockMap *_map);
+static FileHandle *handle_get(int _fd);
 static void remove_file_single_indirect_blocks(unsigned int _fileType, unsigned int _inodeNumD,
                                                unsigned int _diskOffset);
 static void remove_file_indirect_blocks(PointerType _type, unsigned int indirect,
@@ -102,6 +284,51 @@ static Bool rename_file_in_triple_indirect(unsigned int _inodeNumF, unsigned int
                                            unsigned int _tIndirectOffset);
 static Bool remove_file_from_dir_indirect_pointers(unsigned int _inodeNumF,
                                                    unsigned int _inodeNumD);
+static Bool place_dir_entry(unsigned int _inodeNumF, unsigned int *_name,
+                            unsigned int _inodeNumParentDir);
+static Bool is_dir_indexed(const Inode *_inode);
+static unsigned int dir_name_hash(const unsigned int *_name);
+static Bool dir_name_equal(const unsigned int *_a, const unsigned int *_b);
+static unsigned int dir_index_root(void);
+static void dir_index_set_root(unsigned int _diskOffset);
+static unsigned int dir_index_leaf(unsigned int _hash, unsigned int *_node, unsigned int *_path,
+                                   unsigned int *_depth);
+static Bool dir_index_insert(const unsigned int *_name, unsigned int _entryOffset);
+static void dir_index_delete(const unsigned int *_name, unsigned int _entryOffset);
+static unsigned int dir_index_find(const unsigned int *_name);
+static Bool dir_index_build(void);
+static void dir_index_drop(void);
+static void dir_index_free(unsigned int _diskOffset, SectorBatch *_batch);
+static Bool dir_walk(EntryVisitor _visit, void *_arg);
+static Bool dir_walk_blocks(unsigned int _diskOffset, unsigned int _level, EntryVisitor _visit,
+                            void *_arg);
+static Bool index_entry(const unsigned int *_entry, unsigned int _entryOffset, void *_arg);
+static Bool find_name(const unsigned int *_entry, unsigned int _entryOffset, void *_arg);
+static unsigned int dir_lookup(unsigned int _inodeNumD, const unsigned int *_name);
+static Dentry *dentry_slot(unsigned int _inodeNumD, const unsigned int *_name);
+static Bool dentry_find(unsigned int _inodeNumD, const unsigned int *_name,
+                        unsigned int *_inodeNum);
+static void dentry_store(unsigned int _inodeNumD, const unsigned int *_name,
+                         unsigned int _inodeNum);
+static void dentry_forget(unsigned int _inodeNumD, const unsigned int *_name);
+static void dentry_forget_inode(unsigned int _inodeNum);
+static void dentry_forget_all(void);
+static unsigned int resolve_from(unsigned int _inodeNumD, const char *_path, unsigned int *_hops);
+static Bool add_file_to_dir_block(unsigned int _inodeNumF, unsigned int *_name,
+                                  unsigned int _diskOffset, unsigned int *_buffer);
+static DirSlots *dir_slots_get(unsigned int _inodeNumD);
+static DirSlots *dir_slots_find(unsigned int _inodeNumD);
+static void dir_slots_placed(unsigned int _inodeNumD, unsigned int _entryOffset, Bool _newBlock);
+static void dir_slots_freed(unsigned int _inodeNumD, unsigned int _diskOffset);
+static void dir_slots_dropped(unsigned int _inodeNumD, unsigned int _diskOffset);
+static void dir_slots_forget(unsigned int _inodeNumD);
+static void dir_slots_forget_all(void);
+static void dir_backref_store(unsigned int _inodeNumF, unsigned int _inodeNumD,
+                              unsigned int _entryOffset);
+static unsigned int dir_backref_find(unsigned int _inodeNumF, unsigned int _inodeNumD);
+static Bool dir_block_hinted(unsigned int _diskOffset);
+static Bool remove_file_from_dir_blocks(unsigned int _inodeNumF, unsigned int _inodeNumD);
+static Bool rename_file_in_dir_blocks(unsigned int _inodeNumF, unsigned int *_name);
 
 //========================= FSM FUNCTION DEFINITIONS =======================//
 /**
@@ -120,6 +347,97 @@ static inline Bool is_not_null(unsigned int _ptr) { return _ptr != (unsigned int
  */
 static inline Bool is_null(unsigned int _ptr) { return _ptr == (unsigned int)(-1); }
 
+/**
+ * @brief Verify if an inode keeps its data inline.
+ * @param[in] _inode an inode.
+ * @return True if the inode's data is held in the inode itself; false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+static inline Bool is_inline(const Inode *_inode) {
+    return (_inode->status & INODE_INLINE) != 0 ? True : False;
+}
+
+/**
+ * @brief Verify if a directory has a name index.
+ * @param[in] _inode an inode.
+ * @return True if the directory's entries are indexed by name; false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+static inline Bool is_dir_indexed(const Inode *_inode) {
+    return (_inode->status & INODE_DIR_INDEX) != 0 ? True : False;
+}
+
+/**
+ * @brief Verify if an inode maps its blocks with extents.
+ * @param[in] _inode an inode.
+ * @return True if the inode's pointers hold extents; false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+static inline Bool is_extent(const Inode *_inode) {
+    return (_inode->status & INODE_EXTENTS) != 0 ? True : False;
+}
+
+/**
+ * @brief Verify if an inode has no data or pointer blocks.
+ * @param[in] _inode an inode that is not inline.
+ * @return True if every pointer of the inode is null; false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool has_no_blocks(const Inode *_inode) {
+    for (int i = 0; i < INODE_DIRECT_PTRS; i++) {
+        if (is_not_null(_inode->directPtr[i])) return False;
+    }
+    return is_null(_inode->sIndirect) && is_null(_inode->dIndirect) && is_null(_inode->tIndirect);
+}
+
+/**
+ * @brief Tells whether a buffer holds only zeros.
+ * The bytes are OR-ed together 64 at a time, eight 64-bit words with no branch between them,
+ * which the compiler turns into vector loads and ORs; only the result of each group is tested.
+ * @param[in] _buffer Bytes to check.
+ * @param[in] _len Number of bytes.
+ * @return True if every byte is zero; false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool block_is_zero(const void *_buffer, unsigned int _len) {
+    const unsigned char *bytes = _buffer;
+    unsigned int i = 0;
+    for (; i + 64 <= _len; i += 64) {
+        uint64_t words[8];
+        memcpy(words, bytes + i, sizeof(words));
+        uint64_t bits = 0;
+        for (unsigned int j = 0; j < 8; j++) {
+            bits |= words[j];
+        }
+        if (bits != 0) {
+            return False;
+        }
+    }
+    for (; i < _len; i++) {
+        if (bytes[i] != 0) {
+            return False;
+        }
+    }
+    return True;
+}
+
+/**
+ * @brief Tells whether zero blocks of the open file (`inode`) are left as holes.
+ * @return True if sparse files are on and the file is not a directory; false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool sparse_files(void) { return fsm->sparseFiles == True && inode.fileType != 2; }
+
+/**
+ * @brief Tells whether a block about to be written to the open file is left as a hole.
+ * @param[in] _buffer The block's data, BLOCK_SIZE bytes.
+ * @return True if sparse files are on for the file and the block is all zeros; false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool sparse_block(const void *_buffer) {
+    return sparse_files() && block_is_zero(_buffer, BLOCK_SIZE);
+}
+
 /**
  * @brief Initializes the File Sector Manager.
  * Sets up the File Sector Manager and optionally initializes the SSM maps.
@@ -128,6 +446,10 @@ static inline Bool is_null(unsigned int _ptr) { return _ptr == (unsigned int)(-1
  * @date 2010-04-01 First implementation.
  */
 static void init_file_sector_mgr(int _initSsmMaps) {
+    // Learn which chunks of the inode table are written and where the maps are kept
+    if (superblock_read() == True) {
+        place_maps(superblock.mapsOffset);
+    }
     // Initialize SEctor Space Manager
     ssm_init(_initSsmMaps);
     // Initialize FSM's variables
@@ -139,15 +461,12 @@ static void init_file_sector_mgr(int _initSsmMaps) {
     }
 
     inode_map.id = (unsigned int)-1;
-    // Open file stream for iMap
-    inode_map.iMapHandle = fopen(FSM_INODE_MAP, "r+");
-    // Read in INODE_BLOCKS number of items from iMap to iMapHandle
-    fread(inode_map.iMap, 1, INODE_BLOCKS, inode_map.iMapHandle);
-    // Closes the iMapHandle
-    fclose(inode_map.iMapHandle);
-    inode_map.iMapHandle = Null;
-    // Open binary form of file for reading and writing
-    fsm->diskHandle = fopen(HARD_DISK, "rb+");
+    // Read in INODE_BLOCKS number of items from the iMap
+    disk_map_read(FSM_INODE_MAP, inode_map.iMap, INODE_BLOCKS);
+    // Load the whole inode table if it is to be kept resident
+    if (fsm->residentInodes == True && inode_table_load() == False) {
+        printf("Error loading the inode table, reading inodes from disk\n");
+    }
 }
 
 /**
@@ -158,23 +477,46 @@ static void init_file_sector_mgr(int _initSsmMaps) {
  */
 static void init_fsm_maps(void) {
     unsigned char map[INODE_BLOCKS];  // SECTOR_BYTES
-    unsigned char disk[DISK_SIZE];
-    // Load iMap from file and place in iMapHandle
-    inode_map.iMapHandle = fopen(FSM_INODE_MAP, "r+");
+    // Clear the image before storing the iMap, which may be kept inside it. A lazily made
+    // image is left sparse; its zeros are never written
+    if (fsm->lazyInodes == False || disk_discard(DISK_SIZE) == False) {
+        unsigned char zeros[MAX_BLOCK_SIZE];
+        memset(zeros, 0, BLOCK_SIZE);
+        // Write the image full of zeros one block at a time
+        for (unsigned int offset = 0; offset < DISK_SIZE; offset += BLOCK_SIZE) {
+            unsigned int len = DISK_SIZE - offset < BLOCK_SIZE ? DISK_SIZE - offset : BLOCK_SIZE;
+            disk_write(zeros, offset, len);
+        }
+    }
     // Initialize all map elements to 255
     memset(map, UINT8_MAX, INODE_BLOCKS);
-    // Write map back to iMapHandle
-    fwrite(map, 1, INODE_BLOCKS, inode_map.iMapHandle);
-    // close the file
-    fclose(inode_map.iMapHandle);
-    inode_map.iMapHandle = Null;
-    fsm->diskHandle = fopen(HARD_DISK, "rb+");
-    // Initialize all disk elements to 0
-    memset(disk, 0, DISK_SIZE);
-    // Write contents of disk to diskHandle
-    fwrite(disk, 1, DISK_SIZE, fsm->diskHandle);
-    fclose(fsm->diskHandle);
-    fsm->diskHandle = Null;
+    // Store the map as the iMap
+    disk_map_write(FSM_INODE_MAP, map, INODE_BLOCKS);
+}
+
+/**
+ * @brief Places the sector, free and inode maps inside the image or back in their files.
+ * The three maps are stored one after the other: allocation map, free map, iMap.
+ * @param[in] _mapsOffset Byte offset of the maps inside the image, 0 to keep them in files.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void place_maps(unsigned int _mapsOffset) {
+    Bool embedded = _mapsOffset != 0 ? True : False;
+    disk_map_embed(SSM_ALLOCATE_MAP, embedded == True ? _mapsOffset : (unsigned int)(-1));
+    disk_map_embed(SSM_FREE_MAP,
+                   embedded == True ? _mapsOffset + SECTOR_BYTES : (unsigned int)(-1));
+    disk_map_embed(FSM_INODE_MAP,
+                   embedded == True ? _mapsOffset + 2 * SECTOR_BYTES : (unsigned int)(-1));
+}
+
+/**
+ * @brief Gets the number of blocks the maps take when kept inside the image.
+ * @return The number of blocks.
+ * @date 2026-10-18 First implementation.
+ */
+static unsigned int maps_blocks(void) {
+    return (2 * SECTOR_BYTES + INODE_BLOCKS + BLOCK_SIZE - 1) / BLOCK_SIZE;
 }
 
 unsigned int fs_create_file(int _isDirectory, unsigned int *_name,
@@ -186,15 +528,27 @@ unsigned int fs_create_file(int _isDirectory, unsigned int *_name,
     // Create a default file. Will start with all pointers as -1
     unsigned int inodeNum;
     inodeNum = BITS_PER_BYTE * inode_map.iMapOffset[0] + inode_map.iMapOffset[1];
-    inode_read(&inode, inodeNum, fsm->diskHandle);
+    inode_read(&inode, inodeNum);
     // initialize inode metadata
     if (inode_init(&inode) == FAILURE) {
         // @todo do something here
     }
     // Assign filetype
     inode.fileType = _isDirectory == 1 ? 2 : 1;
+    // A file starts with the one name it is created under; a directory counts its entries
+    if (_isDirectory != 1) inode.linkCount = 1;
 
-    inode_write(&inode, inodeNum, fsm->diskHandle);
+    Bool isInline = _isDirectory == 1 && fsm->inlineData == True ? True : False;
+    if (isInline == True) {
+        // A new directory starts inline, with its entries kept in the inode
+        unsigned int entries[INODE_SIZE / 4];
+        memset(entries, 0, sizeof(entries));
+        inode.status |= INODE_INLINE;
+        inode.fileSize = inode_inline_capacity() / DIR_ENTRY_SIZE * DIR_ENTRY_SIZE;
+        inode_write_inline(&inode, inodeNum, entries);
+    } else {
+        inode_write(&inode, inodeNum);
+    }
     allocate_inode();
     unsigned int name[2];
     if (_isDirectory == 1) {
@@ -205,7 +559,10 @@ unsigned int fs_create_file(int _isDirectory, unsigned int *_name,
         strcpy((char *)name, "..");
         create_file(_inodeNumParentDir, name, inodeNum);
     }  // end if (_isDirectory == 1)
-    create_file(inodeNum, _name, _inodeNumParentDir);
+    if (create_file(inodeNum, _name, _inodeNumParentDir) == True && isInline == False) {
+        // the new file remembers where its entry went, for removing or renaming it later
+        dir_backref_store(inodeNum, _inodeNumParentDir, dir_entry_offset);
+    }
     return inodeNum;
 }
 
@@ -213,7 +570,7 @@ Bool fs_open_file(unsigned int _inodeNum, Inode *_inode) {
     if (is_null(_inodeNum)) {
         return False;
     }
-    inode_read(_inode, _inodeNum, fsm->diskHandle);
+    inode_read(_inode, _inodeNum);
     inode_map.id = _inodeNum;
     if (_inode->fileType <= 0) {
         // If file not loaded, create a default inode and return False
@@ -238,1523 +595,3985 @@ Bool fs_read_from_file(unsigned int _inodeNum, void *_buffer) {
     if (!fs_open_file(_inodeNum, &inode)) {
         return False;
     }  // end if (success == False)
+    // Inline data is copied out of the inode, there are no blocks to read
+    if (is_inline(&inode)) {
+        unsigned char data[INODE_SIZE];
+        inode_read_inline(&inode, _inodeNum, data);
+        unsigned int size = inode.fileSize;
+        memcpy(_buffer, data, size < inode_inline_capacity() ? size : inode_inline_capacity());
+        return True;
+    }
+    // An extent-mapped file is read with one request per extent
+    if (is_extent(&inode)) {
+        Extent extents[MAX_EXTENTS];
+        unsigned int count = extent_load(extents);
+        DiskRequest requests[MAX_EXTENTS];
+        unsigned int next = 0;
+        for (unsigned int i = 0; i < count; i++) {
+            if (extents[i].logical > next) {
+                // a gap between extents is a hole
+                memset((char *)_buffer + (size_t)next * BLOCK_SIZE, 0,
+                       (size_t)(extents[i].logical - next) * BLOCK_SIZE);
+            }
+            requests[i] = (DiskRequest){(char *)_buffer + (size_t)extents[i].logical * BLOCK_SIZE,
+                                        extents[i].start, extents[i].length * BLOCK_SIZE};
+            next = extents[i].logical + extents[i].length;
+        }
+        unsigned int blocks =
+            inode.fileSize / BLOCK_SIZE + (inode.fileSize % BLOCK_SIZE > 0 ? 1 : 0);
+        if (blocks > next) {
+            memset((char *)_buffer + (size_t)next * BLOCK_SIZE, 0,
+                   (size_t)(blocks - next) * BLOCK_SIZE);
+        }
+        return disk_read_batch(requests, count);
+    }
     void *buffer = _buffer;
-    // Read data from direct pointers into buffer _buffer
+    // Build the file's block list: direct pointers first, then the indirect trees. Null pointers
+    // of a file are holes; a directory's are skipped
+    BlockList list = {Null, 0, 0, Null};
+    if (inode.fileType != 2) {
+        unsigned int blocks =
+            inode.fileSize / BLOCK_SIZE + (inode.fileSize % BLOCK_SIZE > 0 ? 1 : 0);
+        list.end = (char *)_buffer + (size_t)blocks * BLOCK_SIZE;
+    }
+    // a list that cannot grow or a pointer block that cannot be read fails the whole read
+    Bool status = True;
     unsigned int diskOffset;
-    for (int i = 0; i < INODE_DIRECT_PTRS; i++) {
+    for (int i = 0; i < INODE_DIRECT_PTRS && status == True; i++) {
         diskOffset = inode.directPtr[i];
         if (is_not_null(diskOffset)) {
-            fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-            fread(buffer, BLOCK_SIZE, 1, fsm->diskHandle);
+            status = block_list_append(&list, buffer, diskOffset);
+            buffer = (char *)buffer + BLOCK_SIZE;
+        } else if (block_list_hole(&list, buffer, 1)) {
             buffer = (char *)buffer + BLOCK_SIZE;
         }
     }  // end for (i = 0; i < INODE_DIRECT_PTRS; i++)
-    // Read data from single indirect pointer into buffer _buffer
     diskOffset = inode.sIndirect;
-    if (is_not_null(diskOffset)) {
-        read_from_single_indirect_blocks(buffer, diskOffset);
+    if (status == True && is_not_null(diskOffset)) {
+        status = list_single_indirect_blocks(&list, buffer, diskOffset);
+        buffer = (char *)buffer + BLOCK_SIZE * S_INDIRECT_BLOCKS;
+    } else if (status == True && block_list_hole(&list, buffer, S_INDIRECT_BLOCKS)) {
         buffer = (char *)buffer + BLOCK_SIZE * S_INDIRECT_BLOCKS;
     }
     diskOffset = inode.dIndirect;
-    if (is_not_null(diskOffset)) {
-        read_from_double_indirect_blocks(buffer, diskOffset);
+    if (status == True && is_not_null(diskOffset)) {
+        status = list_double_indirect_blocks(&list, buffer, diskOffset);
+        buffer = (char *)buffer + BLOCK_SIZE * D_INDIRECT_BLOCKS;
+    } else if (status == True && block_list_hole(&list, buffer, D_INDIRECT_BLOCKS)) {
         buffer = (char *)buffer + BLOCK_SIZE * D_INDIRECT_BLOCKS;
     }
     diskOffset = inode.tIndirect;
-    if (is_not_null(diskOffset)) {
-        read_from_triple_indirect_blocks(buffer, diskOffset);
+    if (status == True && is_not_null(diskOffset)) {
+        status = list_triple_indirect_blocks(&list, buffer, diskOffset);
+    } else if (status == True) {
+        block_list_hole(&list, buffer, T_INDIRECT_BLOCKS);
     }
-    fseek(fsm->diskHandle, 0, SEEK_SET);
-    return True;
+    // Read the whole list; physically adjacent blocks are merged into one preadv per run
+    if (status == True) {
+        status = disk_read_batch(list.requests, list.count);
+    }
+    free(list.requests);
+    return status;
+}
+
+Bool fs_read_blocks(unsigned int _inodeNum, unsigned int _firstBlock, unsigned int _count,
+                    void *_buffer) {
+    if (!fs_open_file(_inodeNum, &inode)) {
+        return False;
+    }
+    return read_blocks(_inodeNum, _firstBlock, _count, _buffer,
+                       &block_maps[_inodeNum % BLOCK_MAP_FILES],
+                       &readahead[_inodeNum % READAHEAD_FILES]);
 }
 
 /**
- * @brief Writes data to a file that uses direct blocks.
- * Writes the contents of the provided buffer to the file identified by the given inode number.
- * @param[in,out] _buffer Pointer to the data to be written.
- * @param[in,out] directPtrs the number of direct blocks
- * @return the updated buffer address.
- * @date 2025-06-16 First implementation.
+ * @brief Reads a range of blocks of the open file (`inode`), as `fs_read_blocks` does.
+ * @param[in] _inodeNum Inode number of the open file.
+ * @param[in] _firstBlock Index of the first block to read.
+ * @param[in] _count Number of blocks to read.
+ * @param[out] _buffer Buffer of at least `_count` * BLOCK_SIZE bytes.
+ * @param[in,out] _map Where the block map of the file is kept (a shared slot or a handle's).
+ * @param[in,out] _state Readahead state of the file.
+ * @return True if the blocks were read successfully, false otherwise.
+ * @date 2026-10-18 First implementation.
  */
-static void *write_to_file_direct(void *buffer, unsigned int directPtrs) {
-    unsigned int diskOffset;
-    for (unsigned int i = 0; i < directPtrs; i++) {
-        diskOffset = inode.directPtr[i];
+static Bool read_blocks(unsigned int _inodeNum, unsigned int _firstBlock, unsigned int _count,
+                        void *_buffer, BlockMap *_map, Readahead *_state) {
+    if (is_inline(&inode)) {
+        // inline data is all of block 0
+        unsigned char data[INODE_SIZE];
+        memset(_buffer, 0, (size_t)_count * BLOCK_SIZE);
+        if (_firstBlock == 0 && _count > 0) {
+            inode_read_inline(&inode, _inodeNum, data);
+            unsigned int size = inode.fileSize;
+            memcpy(_buffer, data, size < inode_inline_capacity() ? size : inode_inline_capacity());
+        }
+        return True;
+    }
+    PointerPath path;
+    memset(path.offset, 0xFF, sizeof(path.offset));
+    BlockMap *map = block_map_fill(_map, _inodeNum);
+    BlockList list = {Null, 0, 0, Null};
+    char *buffer = _buffer;
+    Bool status = True;
+    for (unsigned int i = 0; i < _count && status == True; i++) {
+        unsigned int diskOffset = block_map_lookup(map, _firstBlock + i, &path, True, Null);
         if (is_null(diskOffset)) {
-            // If direct pointer is empty, get a Sector for it
-            diskOffset = ssm_allocate_sectors(1);
-            if (is_null(diskOffset)) {
-                break;
-            } else {
-                inode.directPtr[i] = diskOffset;
-                fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-                fwrite(buffer, BLOCK_SIZE, 1, fsm->diskHandle);
-                buffer = (char *)buffer + BLOCK_SIZE;
-            }
+            // holes and blocks past the end of the file read as zeros
+            memset(buffer + (size_t)i * BLOCK_SIZE, 0, BLOCK_SIZE);
         } else {
-            // Search for diskHandle from beginning of disk
-            fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-            // Overwrite the data at that location
-            fwrite(buffer, BLOCK_SIZE, 1, fsm->diskHandle);
-            buffer = (char *)buffer + BLOCK_SIZE;
+            status = block_list_append(&list, buffer + (size_t)i * BLOCK_SIZE, diskOffset);
         }
-    }  // end for (i = 0; i < directPtrs; i++)
-    return buffer;
+    }
+    if (status == True) {
+        status = disk_read_batch(list.requests, list.count);
+    }
+    free(list.requests);
+    read_ahead(_state, _inodeNum, _firstBlock, _count, map, &path);
+    return status;
 }
 
-/**
- * @brief Writes data to a file that uses single indirect blocks.
- * Writes the contents of the provided buffer to the file identified by the given inode number.
- * @param[in,out] _buffer Pointer to the data to be written.
- * @param[in,out] _fileSize Size of the data to write, in bytes.
- * @param[in,out] baseOffset the base offset to write to
- * @param[in,out] sIndirectPtrs the number of single indirect blocks
- * @return the updated buffer address.
- * @date 2025-06-16 First implementation.
- */
-static void *write_to_file_using_single_indirect_blocks(void *buffer, long long int *fileSize,
-                                                        unsigned int *baseOffset,
-                                                        unsigned int *sIndirectPtrs) {
-    // Calculate number of single indirect pointers needed
-    *sIndirectPtrs = *fileSize / BLOCK_SIZE;
-    if (*fileSize % BLOCK_SIZE > 0) {
-        *sIndirectPtrs += 1;
-    }  // end if (fileSize % BLOCK_SIZE > 0)
-    // Allocate single indirect pointers
-    inode.sIndirect = aloc_single_indirect(*sIndirectPtrs);
-    // Write to single indirect pointers
-    *baseOffset = inode.sIndirect;
-    write_to_single_indirect_blocks(*baseOffset, buffer, *sIndirectPtrs);
-    return buffer;
+Bool fs_stream_open(FileStream *_stream, unsigned int _inodeNum, unsigned int _chunkBlocks) {
+    if (_chunkBlocks == 0 || !fs_open_file(_inodeNum, &inode)) {
+        return False;
+    }
+    _stream->inodeNum = _inodeNum;
+    _stream->size = inode.fileSize;
+    _stream->nextBlock = 0;
+    _stream->chunkBlocks = _chunkBlocks;
+    stream_prefetch(_stream);
+    return True;
+}
+
+long long int fs_stream_next(FileStream *_stream, void *_buffer) {
+    unsigned int blocks = _stream->size / BLOCK_SIZE + (_stream->size % BLOCK_SIZE > 0 ? 1 : 0);
+    if (_stream->nextBlock >= blocks) {
+        return 0;
+    }
+    unsigned int count = blocks - _stream->nextBlock < _stream->chunkBlocks
+                             ? blocks - _stream->nextBlock
+                             : _stream->chunkBlocks;
+    if (fs_read_blocks(_stream->inodeNum, _stream->nextBlock, count, _buffer) == False) {
+        return -1;
+    }
+    unsigned int first = _stream->nextBlock * BLOCK_SIZE;
+    _stream->nextBlock += count;
+    // the next chunk loads while the caller works on this one
+    stream_prefetch(_stream);
+    unsigned int end = _stream->nextBlock * BLOCK_SIZE;
+    return (end < _stream->size ? end : _stream->size) - first;
 }
 
 /**
- * @brief Writes data to a file that uses double indirect blocks.
- * Writes the contents of the provided buffer to the file identified by the given inode number.
- * @param[in,out] _buffer Pointer to the data to be written.
- * @param[in,out] _fileSize Size of the data to write, in bytes.
- * @param[in,out] baseOffset the base offset to write to
- * @param[in,out] sIndirectPtrs the number of single indirect blocks
- * @param[in,out] dIndirectPtrs the number of double indirect blocks
- * @return the updated buffer address.
- * @date 2025-06-16 First implementation.
+ * @brief Starts loading the next chunk of a stream without waiting for it.
+ * The chunk's blocks are mapped through the block map of the file (which must be the open file,
+ * `inode`) and handed to `disk_prefetch` READAHEAD_MAX_BLOCKS at a time.
+ * @param[in] _stream Stream whose next chunk to prefetch.
+ * @return void
+ * @date 2026-10-18 First implementation.
  */
-static void *write_to_file_using_double_indirect_blocks(void *buffer, long long int *fileSize,
-                                                        unsigned int *baseOffset,
-                                                        unsigned int *sIndirectPtrs,
-                                                        unsigned int *dIndirectPtrs) {
-    // Allocate single Indirect blocks
-    *sIndirectPtrs = S_INDIRECT_BLOCKS;
-    inode.sIndirect = aloc_single_indirect(*sIndirectPtrs);
-    // Write to single Indirect pointers
-    *baseOffset = inode.sIndirect;
-    write_to_single_indirect_blocks(*baseOffset, buffer, *sIndirectPtrs);
-    buffer = (char *)buffer + BLOCK_SIZE * S_INDIRECT_BLOCKS;
-    // Calculate Remaining filesize
-    *fileSize = *fileSize + (INODE_DIRECT_PTRS * BLOCK_SIZE) - S_INDIRECT_SIZE;
-    // Calculate number of double Indirect Pointrs needed
-    *dIndirectPtrs = *fileSize / BLOCK_SIZE;
-    if (*fileSize % BLOCK_SIZE > 0) {
-        *dIndirectPtrs += 1;
-    }  // end if (fileSize % BLOCK_SIZE > 0)
-    // Allocate double Indirect Pointers
-    inode.dIndirect = aloc_double_indirect(*dIndirectPtrs);
-    *baseOffset = inode.dIndirect;
-    // Write to double Indirect Pointers
-    write_to_double_indirect_blocks(*baseOffset, buffer, *dIndirectPtrs);
+static void stream_prefetch(const FileStream *_stream) {
+    unsigned int blocks = _stream->size / BLOCK_SIZE + (_stream->size % BLOCK_SIZE > 0 ? 1 : 0);
+    if (_stream->nextBlock >= blocks || is_inline(&inode)) {
+        return;
+    }
+    unsigned int end = blocks - _stream->nextBlock < _stream->chunkBlocks
+                           ? blocks
+                           : _stream->nextBlock + _stream->chunkBlocks;
+    BlockMap *map = block_map_get(_stream->inodeNum);
+    PointerPath path;
+    memset(path.offset, 0xFF, sizeof(path.offset));
+    unsigned int offsets[READAHEAD_MAX_BLOCKS];
+    unsigned int count = 0;
+    for (unsigned int i = _stream->nextBlock; i < end; i++) {
+        unsigned int diskOffset = block_map_lookup(map, i, &path, True, Null);
+        if (is_not_null(diskOffset)) {
+            offsets[count++] = diskOffset;
+        }
+        if (count == READAHEAD_MAX_BLOCKS) {
+            disk_prefetch(offsets, count, BLOCK_SIZE);
+            count = 0;
+        }
+    }
+    disk_prefetch(offsets, count, BLOCK_SIZE);
+}
 
-    return buffer;
+long long int fs_pread(unsigned int _inodeNum, void *_buffer, unsigned int _len,
+                       unsigned int _offset) {
+    if (!fs_open_file(_inodeNum, &inode)) {
+        return -1;
+    }
+    return read_range(_inodeNum, _buffer, _len, _offset, &block_maps[_inodeNum % BLOCK_MAP_FILES],
+                      &readahead[_inodeNum % READAHEAD_FILES]);
 }
 
 /**
- * @brief Writes data to a file that uses triple indirect blocks.
- * Writes the contents of the provided buffer to the file identified by the given inode number.
- * @param[in,out] _buffer Pointer to the data to be written.
- * @param[in,out] _fileSize Size of the data to write, in bytes.
- * @param[in,out] baseOffset the base offset to write to
- * @param[in,out] sIndirectPtrs the number of single indirect blocks
- * @param[in,out] dIndirectPtrs the number of double indirect blocks
- * @param[in,out] tIndirectPtrs the number of triple indirect blocks
- * @return the updated buffer address.
- * @date 2025-06-16 First implementation.
+ * @brief Reads part of the open file (`inode`), as `fs_pread` does.
+ * @param[in] _inodeNum Inode number of the open file.
+ * @param[out] _buffer Buffer of at least `_len` bytes.
+ * @param[in] _len Number of bytes to read.
+ * @param[in] _offset Byte offset within the file of the first byte to read.
+ * @param[in,out] _map Where the block map of the file is kept.
+ * @param[in,out] _state Readahead state of the file.
+ * @return The number of bytes read, or -1 if the file could not be read.
+ * @date 2026-10-18 First implementation.
  */
-static void *write_to_file_using_triple_indirect_blocks(void *buffer, long long int *fileSize,
-                                                        unsigned int *baseOffset,
-                                                        unsigned int *sIndirectPtrs,
-                                                        unsigned int *dIndirectPtrs,
-                                                        unsigned int *tIndirectPtrs) {
-    *sIndirectPtrs = S_INDIRECT_BLOCKS;
-    *dIndirectPtrs = D_INDIRECT_BLOCKS;
-    // Allocate Single and double indirect pointers
-    inode.sIndirect = aloc_single_indirect(*sIndirectPtrs);
-    inode.dIndirect = aloc_double_indirect(*dIndirectPtrs);
-    // Write to single indirect blocks
-    *baseOffset = inode.sIndirect;
-    write_to_single_indirect_blocks(*baseOffset, buffer, *sIndirectPtrs);
-    buffer = (char *)buffer + BLOCK_SIZE * S_INDIRECT_BLOCKS;
-    // Write to double indirect blocks
-    *baseOffset = inode.dIndirect;
-    write_to_double_indirect_blocks(*baseOffset, buffer, *dIndirectPtrs);
-    buffer = (char *)buffer + BLOCK_SIZE * D_INDIRECT_BLOCKS;
-    // Calculate remaining filesize
-    *fileSize = *fileSize + (INODE_DIRECT_PTRS * BLOCK_SIZE) - D_INDIRECT_SIZE;
-    // Calculate number of triple Indirect pointers needed
-    *tIndirectPtrs = *fileSize / BLOCK_SIZE;
-    if (*fileSize % BLOCK_SIZE > 0) {
-        *tIndirectPtrs += 1;
-    }  // end if (fileSize % BLOCK_SIZE > 0)
-    // Allocate triple Indirect Pointers
-    inode.tIndirect = aloc_triple_indirect(*tIndirectPtrs);
-    *baseOffset = inode.tIndirect;
-    // Write to tripleIndirectBlocks
-    write_to_triple_indirect_blocks(*baseOffset, buffer, *tIndirectPtrs);
+static long long int read_range(unsigned int _inodeNum, void *_buffer, unsigned int _len,
+                                unsigned int _offset, BlockMap *_map, Readahead *_state) {
+    if (_offset >= inode.fileSize) {
+        return 0;
+    }
+    unsigned int len = inode.fileSize - _offset < _len ? inode.fileSize - _offset : _len;
+    char *buffer = _buffer;
+    unsigned char edge[BLOCK_SIZE];
+    unsigned int block = _offset / BLOCK_SIZE;
+    unsigned int skip = _offset % BLOCK_SIZE;
+    unsigned int done = 0;
+    // a partial first block goes through a block buffer
+    if (skip > 0 || len < BLOCK_SIZE) {
+        if (read_blocks(_inodeNum, block, 1, edge, _map, _state) == False) {
+            return -1;
+        }
+        done = BLOCK_SIZE - skip < len ? BLOCK_SIZE - skip : len;
+        memcpy(buffer, edge + skip, done);
+        block++;
+    }
+    // whole blocks are read straight into the caller's buffer
+    unsigned int whole = (len - done) / BLOCK_SIZE;
+    if (whole > 0) {
+        if (read_blocks(_inodeNum, block, whole, buffer + done, _map, _state) == False) {
+            return -1;
+        }
+        done += whole * BLOCK_SIZE;
+        block += whole;
+    }
+    // and so does a partial last block
+    if (done < len) {
+        if (read_blocks(_inodeNum, block, 1, edge, _map, _state) == False) {
+            return -1;
+        }
+        memcpy(buffer + done, edge, len - done);
+    }
+    return len;
+}
 
-    return buffer;
+/**
+ * @brief Returns the block map of the open file (`inode`), building it if needed.
+ * The map covers the blocks within the file size and is built with one walk of the pointer
+ * tree, which reads each pointer block once. It is rebuilt if the inode no longer matches the
+ * one it was built from.
+ * @param[in] _inodeNum Inode number of the open file.
+ * @return The block map, or Null if it could not be allocated.
+ * @date 2026-10-18 First implementation.
+ */
+static BlockMap *block_map_get(unsigned int _inodeNum) {
+    return block_map_fill(&block_maps[_inodeNum % BLOCK_MAP_FILES], _inodeNum);
 }
 
-Bool fs_write_to_file(unsigned int _inodeNum, void *_buffer, long long int _fileSize) {
-    // return false if openFile fails
-    if (!fs_open_file(_inodeNum, &inode)) {
-        return False;
-    }  // end if (success == False)
-    // set fileSize and inode fileSize
-    long long int fileSize = _fileSize;
-    inode.fileSize = (unsigned int)_fileSize;
-    inode.dataBlocks = inode.fileSize / BLOCK_SIZE;
-    unsigned int directPtrs = 0;
-    // Calculate how many direct pointers needed
-    for (unsigned int i = 0; i < INODE_DIRECT_PTRS; i++) {
-        fileSize -= BLOCK_SIZE;
-        directPtrs++;
-        if (fileSize <= 0) {
-            break;
-        }  // end else (fileSize > 0)
-    }  // end for (i = 0; i < INODE_DIRECT_PTRS; i++)
-    void *buffer = _buffer;
-    // Write to direct pointers
-    buffer = write_to_file_direct(buffer, directPtrs);
-
-    unsigned int sIndirectPtrs = 0;
-    unsigned int dIndirectPtrs = 0;
-    unsigned int tIndirectPtrs = 0;
-    unsigned int baseOffset;
-    // If file is too big for the direct pointers,
-    // begin looking at the indrect pointers
-    if (fileSize > 0) {
-        // Write to file using triple Indirection if file too big for
-        /// double indirection
-        if (fileSize + (INODE_DIRECT_PTRS * BLOCK_SIZE) - D_INDIRECT_SIZE > 0) {
-            buffer = write_to_file_using_triple_indirect_blocks(
-                buffer, &fileSize, &baseOffset, &sIndirectPtrs, &dIndirectPtrs, &tIndirectPtrs);
-
-        }  // end if (fileSize + (INODE_DIRECT_PTRS * BLOCK_SIZE) - D_INDIRECT_SIZE > 0)
-        // Write to file using double Indirection if too big for
-        //   single indirection
-        else if (fileSize + (INODE_DIRECT_PTRS * BLOCK_SIZE) - S_INDIRECT_SIZE > 0) {
-            buffer = write_to_file_using_double_indirect_blocks(buffer, &fileSize, &baseOffset,
-                                                                &sIndirectPtrs, &dIndirectPtrs);
-        }  // end else if (fileSize + (INODE_DIRECT_PTRS * BLOCK_SIZE) - S_INDIRECT_SIZE > 0)
-        // Write to file using single Indirection only
-        else {
-            buffer = write_to_file_using_single_indirect_blocks(buffer, &fileSize, &baseOffset,
-                                                                &sIndirectPtrs);
-        }  // end else
-    }  // end if (fileSize > 0)
-    // Write created inode to disk
-    inode_write(&inode, _inodeNum, fsm->diskHandle);
-    fseek(fsm->diskHandle, 0, SEEK_SET);
-    return True;
+/**
+ * @brief Makes `_map` the block map of the open file (`inode`), building it if needed.
+ * @param[in,out] _map Map to check and, if it is for another file or version, rebuild.
+ * @param[in] _inodeNum Inode number of the open file.
+ * @return `_map`, or Null if it could not be allocated.
+ * @date 2026-10-18 First implementation.
+ */
+static BlockMap *block_map_fill(BlockMap *_map, unsigned int _inodeNum) {
+    BlockMap *map = _map;
+    if (map->blocks != NULL && map->inodeNum == _inodeNum &&
+        memcmp(&map->source, &inode, sizeof(Inode)) == 0) {
+        return map;
+    }
+    free(map->blocks);
+    map->blocks = Null;
+    unsigned int count = inode.fileSize / BLOCK_SIZE + (inode.fileSize % BLOCK_SIZE > 0 ? 1 : 0);
+    unsigned int *blocks = malloc((count > 0 ? count : 1) * sizeof(unsigned int));
+    if (blocks == NULL) {
+        return Null;
+    }
+    PointerPath path;
+    memset(path.offset, 0xFF, sizeof(path.offset));
+    for (unsigned int i = 0; i < count; i++) {
+        blocks[i] = map_file_block(i, &path, True, Null);
+    }
+    map->inodeNum = _inodeNum;
+    map->source = inode;
+    map->blocks = blocks;
+    map->count = count;
+    return map;
 }
 
 /**
- * @brief Writes a file to an inode's first available indirect pointer location.
- * Writes a file into the specified inode memory within the File Sector Manager.
- * @param[in] _inodeNumF Inode number of the file to be written.
- * @param[in] _file_name Pointer to the name of the file.
- * @param[in] _allocate If true, allocate SSM blocks as needed.
- * @return True if the file was written successfully, false otherwise.
- * @date 2025-06-17 First implementation.
+ * @brief Maps a block of the open file through its block map.
+ * Blocks the map does not cover (past the file size, or no map at all) are mapped by walking
+ * the pointer tree with `map_file_block`.
+ * @param[in] _map Block map of the open file, may be Null.
+ * @param[in] _fileBlock Index of the block within the file.
+ * @param[in,out] _path Pointer blocks read so far by the fallback walk.
+ * @param[in] _load Whether the fallback walk may read pointer blocks from disk.
+ * @param[out] _pending See `map_file_block`. May be Null.
+ * @return The disk offset of the block, or -1 (see `map_file_block`).
+ * @date 2026-10-18 First implementation.
  */
-static Bool create_file_in_avail_indirect_loc(unsigned int _inodeNumF, unsigned int *_file_name,
-                                              Bool _allocate) {
-    if (is_not_null(inode.sIndirect)) {
-        if (add_file_to_single_indirect(_inodeNumF, _file_name, inode.sIndirect, _allocate))
-            return True;
+static unsigned int block_map_lookup(BlockMap *_map, unsigned int _fileBlock, PointerPath *_path,
+                                     Bool _load, unsigned int *_pending) {
+    if (_map != NULL && _fileBlock < _map->count) {
+        if (_pending != NULL) *_pending = (unsigned int)(-1);
+        return _map->blocks[_fileBlock];
     }
-    if (is_not_null(inode.dIndirect)) {
-        if (add_file_to_double_indirect(_inodeNumF, _file_name, inode.dIndirect, _allocate))
-            return True;
+    return map_file_block(_fileBlock, _path, _load, _pending);
+}
+
+/**
+ * @brief Drops the block map of a file whose pointers are about to change.
+ * @param[in] _inodeNum Inode number of the file.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void block_map_invalidate(unsigned int _inodeNum) {
+    BlockMap *map = &block_maps[_inodeNum % BLOCK_MAP_FILES];
+    if (map->inodeNum == _inodeNum) {
+        free(map->blocks);
+        map->blocks = Null;
+        map->count = 0;
     }
-    if (is_not_null(inode.tIndirect)) {
-        if (add_file_to_triple_indirect(_inodeNumF, _file_name, inode.tIndirect, _allocate))
-            return True;
+    // handles on the file drop their map too and reread the inode on their next call
+    for (unsigned int i = 0; i < MAX_OPEN_FILES; i++) {
+        if (handles[i].open == True && handles[i].inodeNum == _inodeNum) {
+            free(handles[i].map.blocks);
+            handles[i].map.blocks = Null;
+            handles[i].map.count = 0;
+            handles[i].stale = True;
+        }
     }
-    return False;
 }
 
 /**
- * @brief Writes a file to an inode's unset indirect pointer location.
- * Writes a file into the specified inode memory within the File Sector Manager after setting it.
- * @param[in] _type the indirect PointerType (SINGLE, DOUBLE, TRIPLE).
- * @param[in] _inodeNumF Inode number of the file to be written.
- * @param[in] _file_name Pointer to the name of the file.
- * @param[in] _inodeNumD Inode number of the directory to store the file in.
- * @param[in,out] diskOffset Offset within the disk.
- * @param[in] _file_buffer Pointer to the file data buffer.
- * @return True if the file was written successfully, false otherwise.
- * @date 2025-06-17 First implementation.
+ * @brief Drops every block map.
+ * @return void
+ * @date 2026-10-18 First implementation.
  */
-static Bool create_file_in_unavail_indirect_loc(PointerType _type, unsigned int _inodeNumF,
-                                                unsigned int *_file_name, unsigned int _inodeNumD,
-                                                unsigned int *diskOffset,
-                                                unsigned int *file_buffer) {
-    typedef Bool (*WriteFunc)(unsigned int, unsigned int *, unsigned int, Bool);
-
-    unsigned int *indirect = NULL;
-    WriteFunc write_func;
+static void block_map_invalidate_all(void) {
+    for (unsigned int i = 0; i < BLOCK_MAP_FILES; i++) {
+        free(block_maps[i].blocks);
+        block_maps[i].blocks = Null;
+        block_maps[i].count = 0;
+    }
+    for (unsigned int i = 0; i < MAX_OPEN_FILES; i++) {
+        free(handles[i].map.blocks);
+        handles[i].map.blocks = Null;
+        handles[i].map.count = 0;
+        handles[i].stale = True;
+    }
+}
 
-    if (_type == SINGLE) {
-        indirect = &inode.sIndirect;
-        write_func = add_file_to_single_indirect;
-    } else if (_type == DOUBLE) {
-        indirect = &inode.dIndirect;
-        write_func = add_file_to_double_indirect;
+/**
+ * @brief Maps a block of the open file (`inode`) to the disk offset of its data.
+ * Pointer blocks are remembered in `_path`, so mapping consecutive blocks reads each pointer
+ * block once.
+ * @param[in] _fileBlock Index of the block within the file.
+ * @param[in,out] _path Pointer blocks read so far.
+ * @param[in] _load Whether pointer blocks missing from `_path` may be read from disk.
+ * @param[out] _pending Without `_load`, receives the offset of the first missing pointer block
+ * (-1 if none was missing). May be Null.
+ * @return The disk offset of the block, or -1 for a hole, a block past the end of the file or a
+ * block behind a missing pointer block.
+ * @date 2026-10-18 First implementation.
+ */
+static unsigned int map_file_block(unsigned int _fileBlock, PointerPath *_path, Bool _load,
+                                   unsigned int *_pending) {
+    if (_pending != NULL) {
+        *_pending = (unsigned int)(-1);
+    }
+    if (is_extent(&inode)) {
+        return extent_map_block(_fileBlock, _path, _load, _pending);
+    }
+    unsigned int block = _fileBlock;
+    if (block < (unsigned int)INODE_DIRECT_PTRS) {
+        return inode.directPtr[block];
+    }
+    block -= INODE_DIRECT_PTRS;
+    unsigned int diskOffset, depth;
+    if (block < S_INDIRECT_BLOCKS) {
+        diskOffset = inode.sIndirect;
+        depth = 1;
+    } else if ((block -= S_INDIRECT_BLOCKS) < D_INDIRECT_BLOCKS) {
+        diskOffset = inode.dIndirect;
+        depth = 2;
+    } else if ((block -= D_INDIRECT_BLOCKS) < T_INDIRECT_BLOCKS) {
+        diskOffset = inode.tIndirect;
+        depth = 3;
     } else {
-        indirect = &inode.tIndirect;
-        write_func = add_file_to_triple_indirect;
+        return (unsigned int)(-1);
     }
-
-    // Check if memory has been allocated for this indirect memory
-    if (is_null(*indirect)) {
-        // Allocate memory for the inode's indirect pointer using SSM and update the inode
-        *indirect = ssm_allocate_sectors(1);
-        if (is_null(*indirect)) {
-            return False;
-        } else {
-            memset(file_buffer, 0xFF, BLOCK_SIZE);
-            *diskOffset = *indirect;
-            fseek(fsm->diskHandle, 0, SEEK_SET);
-            fseek(fsm->diskHandle, *diskOffset, SEEK_SET);
-
-            fwrite(file_buffer, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-            fseek(fsm->diskHandle, 0, SEEK_SET);
-            inode_write(&inode, _inodeNumD, fsm->diskHandle);
+    // descend one pointer block per level; a pointer at level n spans PTRS_PER_BLOCK^(n-1)
+    for (unsigned int level = depth; level > 0; level--) {
+        if (is_null(diskOffset)) {
+            return (unsigned int)(-1);
         }
-        // Write data to this indirect memory location on disk
-        if (write_func(_inodeNumF, _file_name, *diskOffset, True)) {
-            return True;
+        unsigned int span = level == 3 ? D_INDIRECT_BLOCKS : level == 2 ? S_INDIRECT_BLOCKS : 1;
+        unsigned int *ptrs = _path->ptrs[level - 1];
+        if (_path->offset[level - 1] != diskOffset) {
+            if (_load == False) {
+                if (_pending != NULL) *_pending = diskOffset;
+                return (unsigned int)(-1);
+            }
+            disk_read(ptrs, diskOffset, BLOCK_SIZE);
+            _path->offset[level - 1] = diskOffset;
         }
+        diskOffset = ptrs[block / span];
+        block %= span;
     }
-    return False;
+    return diskOffset;
 }
 
 /**
- * @brief Writes a file to an inode's set direct pointer location.
- * Writes a file into the specified inode memory within the File Sector Manager after setting it.
- * @param[in] _inodeNumF Inode number of the file to be written.
- * @param[in] _file_name Pointer to the name of the file.
- * @param[in,out] diskOffset Offset within the disk.
- * @param[in] _disk_buffer Pointer to the disk io buffer.
- * @return True if the file was written successfully, false otherwise.
- * @date 2025-06-17 First implementation.
+ * @brief Allocates a pointer block with every pointer set to -1.
+ * @return The disk offset of the block, or -1 if no sector was free.
+ * @date 2026-10-18 First implementation.
  */
-static Bool create_file_in_avail_direct_loc(unsigned int _inodeNumF, unsigned int *_file_name,
-                                            unsigned int *diskOffset, unsigned int *disk_buffer) {
-    // Read file's direct pointers from disk
-    unsigned int j;
-    for (unsigned int i = 0; i < INODE_DIRECT_PTRS; i++) {
-        if (is_not_null(inode.directPtr[i])) {
-            *diskOffset = inode.directPtr[i];
-            fseek(fsm->diskHandle, *diskOffset, SEEK_SET);
-
-            fread(disk_buffer, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-            for (j = 0; j < BLOCK_SIZE / 4; j += 4) {
-                if (disk_buffer[j + 3] == 0) {
-                    disk_buffer[j + 3] = 1;
-                    disk_buffer[j] = _file_name[0];
-                    disk_buffer[j + 1] = _file_name[1];
-                    disk_buffer[j + 2] = _inodeNumF;
-                    inode.linkCount += 1;
-                    fseek(fsm->diskHandle, 0, SEEK_SET);
-                    fseek(fsm->diskHandle, *diskOffset, SEEK_SET);
-
-                    fwrite(disk_buffer, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-                    fseek(fsm->diskHandle, 0, SEEK_SET);
-                    Bool status = fs_close_file();
-                    if (status == False) printf("Error closing file\n");
-                    return True;
-                }  // end if (disk_buffer[j+3] == 0)
-            }  // end or (j = 0; j < BLOCK_SIZE/4; j += 4)
-        }
-    }  // end for (i = 0; i < INODE_DIRECT_PTRS; i++)
-    return False;
+static unsigned int aloc_pointer_block(void) {
+    unsigned int diskOffset = ssm_allocate_sectors(1);
+    if (is_not_null(diskOffset)) {
+        unsigned int ptrs[BLOCK_SIZE / 4];
+        memset(ptrs, 0xFF, BLOCK_SIZE);
+        disk_write(ptrs, diskOffset, BLOCK_SIZE);
+    }
+    return diskOffset;
 }
 
 /**
- * @brief Writes a file to an inode's set direct pointer location.
- * Writes a file into the specified inode memory within the File Sector Manager after setting it.
- * @param[in] _inodeNumF Inode number of the file to be written.
- * @param[in] _inodeNumD Inode number of the target directory.
- * @param[in] _file_name Pointer to the name of the file.
- * @param[in,out] diskOffset Offset within the disk.
- * @param[in] _disk_buffer Pointer to the disk io buffer.
- * @return True if the file was written successfully, false otherwise.
- * @date 2025-06-17 First implementation.
+ * @brief Maps a block of the open file (`inode`), allocating it if it is a hole.
+ * Walks the pointer tree like `map_file_block`, allocating missing pointer blocks on the way
+ * down; each new pointer is written to its pointer block as it is set. The inode itself is not
+ * written.
+ * @param[in] _fileBlock Index of the block within the file.
+ * @param[in,out] _path Pointer blocks read so far, kept in step with the pointers set.
+ * @return The disk offset of the block, or -1 if the disk is full or the block is past the
+ * largest file.
+ * @date 2026-10-18 First implementation.
  */
-static Bool create_file_in_unavail_direct_loc(unsigned int _inodeNumF, unsigned int _inodeNumD,
-                                              unsigned int *_file_name, unsigned int *diskOffset,
-                                              unsigned int *disk_buffer) {
-    unsigned int j;
-    for (unsigned int i = 0; i < INODE_DIRECT_PTRS; i++) {
-        if (is_null(inode.directPtr[i])) {
-            // Get sectors for direct pointers
-            *diskOffset = ssm_allocate_sectors(1);
-            if (is_null(*diskOffset)) {
-                // If sectors can't be retrieved, return false
-                return False;
-            } else {
-                inode.directPtr[i] = *diskOffset;
-                fseek(fsm->diskHandle, *diskOffset, SEEK_SET);
-                // Clear disk_buffer
-                for (j = 0; j < BLOCK_SIZE / 4; j++) {
-                    disk_buffer[j] = 0;
-                }  // end for (j = 0; j < BLOCK_SIZE/4; j++)
-                disk_buffer[3] = 1;
-                disk_buffer[0] = _file_name[0];
-                disk_buffer[1] = _file_name[1];
-                disk_buffer[2] = _inodeNumF;
-                inode.linkCount += 1;
-                inode.fileSize += BLOCK_SIZE;
-                inode.dataBlocks = inode.fileSize / BLOCK_SIZE;
-
-                fwrite(disk_buffer, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-                // Write file to disk
-                fseek(fsm->diskHandle, 0, SEEK_SET);
-                inode_write(&inode, _inodeNumD, fsm->diskHandle);
-                Bool status = fs_close_file();
-                if (status == False) printf("Error closing file\n");
-                return True;
+static unsigned int aloc_file_block(unsigned int _fileBlock, PointerPath *_path) {
+    unsigned int block = _fileBlock;
+    if (block < (unsigned int)INODE_DIRECT_PTRS) {
+        if (is_null(inode.directPtr[block])) {
+            inode.directPtr[block] = ssm_allocate_sectors(1);
+        }
+        return inode.directPtr[block];
+    }
+    block -= INODE_DIRECT_PTRS;
+    unsigned int *root, depth;
+    if (block < S_INDIRECT_BLOCKS) {
+        root = &inode.sIndirect;
+        depth = 1;
+    } else if ((block -= S_INDIRECT_BLOCKS) < D_INDIRECT_BLOCKS) {
+        root = &inode.dIndirect;
+        depth = 2;
+    } else if ((block -= D_INDIRECT_BLOCKS) < T_INDIRECT_BLOCKS) {
+        root = &inode.tIndirect;
+        depth = 3;
+    } else {
+        return (unsigned int)(-1);
+    }
+    if (is_null(*root)) {
+        *root = aloc_pointer_block();
+    }
+    unsigned int diskOffset = *root;
+    for (unsigned int level = depth; level > 0 && is_not_null(diskOffset); level--) {
+        unsigned int span = level == 3 ? D_INDIRECT_BLOCKS : level == 2 ? S_INDIRECT_BLOCKS : 1;
+        unsigned int *ptrs = _path->ptrs[level - 1];
+        if (_path->offset[level - 1] != diskOffset) {
+            disk_read(ptrs, diskOffset, BLOCK_SIZE);
+            _path->offset[level - 1] = diskOffset;
+        }
+        unsigned int index = block / span;
+        if (is_null(ptrs[index])) {
+            ptrs[index] = level == 1 ? ssm_allocate_sectors(1) : aloc_pointer_block();
+            if (is_null(ptrs[index])) {
+                return (unsigned int)(-1);
             }
+            disk_write(&ptrs[index], diskOffset + index * 4, sizeof(unsigned int));
         }
-    }  // end for (i = 0; i < INODE_DIRECT_PTRS; i++)
-    return False;
+        diskOffset = ptrs[index];
+        block %= span;
+    }
+    return diskOffset;
 }
 
 /**
- * @brief Write a file.
- * Inserts a file into the specified directory within the File Sector Manager.
- * @param[in] _inodeNumF Inode number of the file to be added.
- * @param[in] _name Pointer to the name of the file.
- * @param[in] _inodeNumParentDir Inode number of the target directory.
- * @return True if the file was added successfully, false otherwise.
- * @date 2010-04-01 First implementation.
+ * @brief Makes sure blocks `_first` to `_end` - 1 of the open file (`inode`) have data blocks.
+ * Holes in the range are allocated; blocks before the range that are not mapped stay holes.
+ * Extent-mapped files, and new regular files when extents are selected, get their blocks as
+ * extents. The inode is written.
+ * @param[in] _inodeNum Inode number of the open file.
+ * @param[in] _first Index of the first block of the range.
+ * @param[in] _end Index one past the last block of the range.
+ * @return True if every block of the range has a data block, false if the disk or the extent
+ * slots ran out.
+ * @date 2026-10-18 First implementation.
  */
-static Bool create_file(unsigned int _inodeNumF, unsigned int *_name,
-                        unsigned int _inodeNumParentDir) {
-    unsigned int diskOffset = 0;
-    unsigned int buffer[BLOCK_SIZE / 4];
-    unsigned int buffer2[BLOCK_SIZE / 4];
+static Bool aloc_file_blocks(unsigned int _inodeNum, unsigned int _first, unsigned int _end) {
+    if (inode.fileType == 1 &&
+        (is_extent(&inode) || (fsm->extentFiles == True && has_no_blocks(&inode)))) {
+        Extent extents[MAX_EXTENTS];
+        unsigned int count = is_extent(&inode) ? extent_load(extents) : 0;
+        Bool status = extent_allocate(extents, &count, _first, _end);
+        if (extent_store(_inodeNum, extents, count) == False) {
+            return False;
+        }
+        return status;
+    }
+    PointerPath path;
+    memset(path.offset, 0xFF, sizeof(path.offset));
+    Bool status = True;
+    for (unsigned int i = _first; i < _end && status == True; i++) {
+        if (is_null(aloc_file_block(i, &path))) {
+            status = False;
+        }
+    }
+    inode_write(&inode, _inodeNum);
+    return status;
+}
 
-    // Open the parent directory
-    if (!fs_open_file(_inodeNumParentDir, &inode)) {
+/**
+ * @brief Moves the data of the open inline file (`inode`) out of the inode into block 0.
+ * Block 0 is allocated like any other block of the file, as an extent when extents are selected.
+ * @param[in] _inodeNum Inode number of the open file.
+ * @return True if the data was moved, false if no block could be allocated.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool inline_to_blocks(unsigned int _inodeNum) {
+    unsigned char data[INODE_SIZE];
+    inode_read_inline(&inode, _inodeNum, data);
+    inode.status &= ~INODE_INLINE;
+    if (inode_init_ptrs(&inode) == FAILURE) {
         return False;
     }
-    // Create file within the parent directory
-
-    // Read file's direct pointers from disk
-    if (create_file_in_avail_direct_loc(_inodeNumF, _name, &diskOffset, buffer)) {
+    unsigned int size = inode.fileSize;
+    if (size == 0) {
+        inode_write(&inode, _inodeNum);
         return True;
     }
+    if (aloc_file_blocks(_inodeNum, 0, 1) == False) {
+        return False;
+    }
+    PointerPath path;
+    memset(path.offset, 0xFF, sizeof(path.offset));
+    unsigned char block[BLOCK_SIZE];
+    memset(block, 0, BLOCK_SIZE);
+    memcpy(block, data, size < inode_inline_capacity() ? size : inode_inline_capacity());
+    disk_write(block, map_file_block(0, &path, True, Null), BLOCK_SIZE);
+    return True;
+}
 
-    // Try to write to the first available indirect memory
-    if (create_file_in_avail_indirect_loc(_inodeNumF, _name, False)) {
-        return True;
+/**
+ * @brief Zeroes the bytes past `_size` in the block of the open file (`inode`) that holds it.
+ * Called before a file grows, so the bytes between its old end and the new data read as zeros
+ * whatever was left in the block.
+ * @param[in] _size Old size of the file in bytes.
+ * @param[in,out] _path Pointer blocks read so far.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void zero_file_tail(unsigned int _size, PointerPath *_path) {
+    if (_size % BLOCK_SIZE == 0) {
+        return;
+    }
+    unsigned int diskOffset = map_file_block(_size / BLOCK_SIZE, _path, True, Null);
+    if (is_not_null(diskOffset)) {
+        unsigned char block[BLOCK_SIZE];
+        disk_read(block, diskOffset, BLOCK_SIZE);
+        memset(block + _size % BLOCK_SIZE, 0, BLOCK_SIZE - _size % BLOCK_SIZE);
+        disk_write(block, diskOffset, BLOCK_SIZE);
     }
+}
 
-    // If can not find an open Direct pointer, allocate a new one at lowest possible level
-    if (create_file_in_unavail_direct_loc(_inodeNumF, _inodeNumParentDir, _name, &diskOffset,
-                                          buffer2)) {
-        return True;
+/**
+ * @brief Queues a block to be freed, handing the batch to the SSM when it is full.
+ * @param[in,out] _batch Sectors waiting to be freed.
+ * @param[in] _diskOffset Disk offset of the block.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void sector_batch_add(SectorBatch *_batch, unsigned int _diskOffset) {
+    if (_batch->count == FREE_BATCH_SECTORS) {
+        sector_batch_flush(_batch);
     }
+    _batch->sectors[_batch->count++] = _diskOffset / BLOCK_SIZE;
+}
 
-    // Try to write to the first available indirect memory location
-    // @todo revist the need for this call
-    if (create_file_in_avail_indirect_loc(_inodeNumF, _name, False)) {
-        return True;
+/**
+ * @brief Frees every queued sector with one update of the SSM maps.
+ * @param[in,out] _batch Sectors waiting to be freed; emptied.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void sector_batch_flush(SectorBatch *_batch) {
+    if (_batch->count > 0) {
+        ssm_deallocate_batch(_batch->sectors, _batch->count);
+        _batch->count = 0;
     }
+}
 
-    // If can not find an open Single, Double or Triple Indirect pointer,
-    // allocate a new one at lowest possible level
-    if (create_file_in_avail_indirect_loc(_inodeNumF, _name, True)) {
-        return True;
+/**
+ * @brief Loads the extents of the open extent-mapped file (`inode`).
+ * @param[out] _extents Array of MAX_EXTENTS extents, filled in file order.
+ * @return The number of extents.
+ * @date 2026-10-18 First implementation.
+ */
+static unsigned int extent_load(Extent *_extents) {
+    // the extent count is kept in the last direct pointer
+    unsigned int count = inode.directPtr[INODE_DIRECT_PTRS - 1];
+    if (count > MAX_EXTENTS) count = 0;
+    unsigned int inInode = count < INODE_EXTENT_SLOTS ? count : INODE_EXTENT_SLOTS;
+    memcpy(_extents, inode.directPtr, inInode * sizeof(Extent));
+    if (count > INODE_EXTENT_SLOTS && is_not_null(inode.sIndirect)) {
+        disk_read(&_extents[INODE_EXTENT_SLOTS], inode.sIndirect,
+                  (count - INODE_EXTENT_SLOTS) * sizeof(Extent));
     }
+    return count;
+}
 
-    if (create_file_in_unavail_indirect_loc(SINGLE, _inodeNumF, _name, _inodeNumParentDir,
-                                            &diskOffset, buffer2)) {
-        return True;
+/**
+ * @brief Stores the extents of the open file (`inode`) and writes the inode.
+ * The first INODE_EXTENT_SLOTS extents go in place of the direct pointers, the rest in an
+ * extent block hung off `sIndirect`, which is allocated or freed as needed.
+ * @param[in] _inodeNum Inode number of the open file.
+ * @param[in] _extents Extents in file order.
+ * @param[in] _count Number of extents, at most MAX_EXTENTS.
+ * @return True if the extents were stored, false if no sector was left for the extent block.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool extent_store(unsigned int _inodeNum, const Extent *_extents, unsigned int _count) {
+    unsigned int inInode = _count < INODE_EXTENT_SLOTS ? _count : INODE_EXTENT_SLOTS;
+    memset(inode.directPtr, 0xFF, sizeof(inode.directPtr));
+    memcpy(inode.directPtr, _extents, inInode * sizeof(Extent));
+    inode.directPtr[INODE_DIRECT_PTRS - 1] = _count;
+    if (_count > INODE_EXTENT_SLOTS) {
+        if (is_null(inode.sIndirect)) {
+            inode.sIndirect = ssm_allocate_sectors(1);
+            if (is_null(inode.sIndirect)) {
+                return False;
+            }
+        }
+        disk_write(&_extents[INODE_EXTENT_SLOTS], inode.sIndirect,
+                   (_count - INODE_EXTENT_SLOTS) * sizeof(Extent));
+    } else if (is_not_null(inode.sIndirect)) {
+        ssm_deallocate_sectors(inode.sIndirect / BLOCK_SIZE);
+        inode.sIndirect = (unsigned int)(-1);
     }
+    inode.status |= INODE_EXTENTS;
+    inode_write(&inode, _inodeNum);
+    return True;
+}
 
-    if (create_file_in_unavail_indirect_loc(DOUBLE, _inodeNumF, _name, _inodeNumParentDir,
-                                            &diskOffset, buffer2)) {
-        return True;
-    }
-    if (create_file_in_unavail_indirect_loc(TRIPLE, _inodeNumF, _name, _inodeNumParentDir,
-                                            &diskOffset, buffer2)) {
-        return True;
+/**
+ * @brief Maps a block of the open extent-mapped file (`inode`) to the disk offset of its data.
+ * The extent block is remembered in `_path` like a pointer block.
+ * @param[in] _fileBlock Index of the block within the file.
+ * @param[in,out] _path Extent block read so far.
+ * @param[in] _load Whether the extent block may be read from disk.
+ * @param[out] _pending See `map_file_block`. May be Null.
+ * @return The disk offset of the block, or -1 past the last extent.
+ * @date 2026-10-18 First implementation.
+ */
+static unsigned int extent_map_block(unsigned int _fileBlock, PointerPath *_path, Bool _load,
+                                     unsigned int *_pending) {
+    unsigned int count = inode.directPtr[INODE_DIRECT_PTRS - 1];
+    if (count > MAX_EXTENTS) return (unsigned int)(-1);
+    const Extent *extents = (const Extent *)inode.directPtr;
+    for (unsigned int i = 0; i < count; i++) {
+        if (i == INODE_EXTENT_SLOTS) {
+            // the remaining extents are in the extent block
+            if (_path->offset[0] != inode.sIndirect) {
+                if (_load == False) {
+                    if (_pending != NULL) *_pending = inode.sIndirect;
+                    return (unsigned int)(-1);
+                }
+                disk_read(_path->ptrs[0], inode.sIndirect, BLOCK_SIZE);
+                _path->offset[0] = inode.sIndirect;
+            }
+            extents = (const Extent *)_path->ptrs[0] - INODE_EXTENT_SLOTS;
+        }
+        if (_fileBlock >= extents[i].logical &&
+            _fileBlock - extents[i].logical < extents[i].length) {
+            return extents[i].start + (_fileBlock - extents[i].logical) * BLOCK_SIZE;
+        }
     }
-    return False;
+    return (unsigned int)(-1);
 }
 
 /**
- * @brief Adds a file to a triple indirect pointer.
- * Inserts a file into the structure at the specified triple indirect offset,
- * optionally allocating necessary blocks.
- * @param[in] _inodeNumF Inode number of the file to be added.
- * @param[in] _name Pointer to the name of the file.
- * @param[in] _tIndirectOffset Offset within the triple indirect block.
- * @param[in] _allocate If true, allocate blocks as needed.
- * @return True if the file was added successfully, false otherwise.
- * @date 2010-04-01 First implementation.
+ * @brief Frees the blocks of a file past its first `_blocks` blocks.
+ * @param[in,out] _extents Extents in file order; the last ones are shortened or dropped.
+ * @param[in,out] _count Number of extents.
+ * @param[in] _blocks Number of blocks to keep.
+ * @return void
+ * @date 2026-10-18 First implementation.
  */
-static Bool add_file_to_triple_indirect(unsigned int _inodeNumF, unsigned int *_name,
-                                        unsigned int _tIndirectOffset, Bool _allocate) {
-    unsigned int indirectBlock[BLOCK_SIZE / 4];
-    unsigned int buffer[BLOCK_SIZE / 4];
-    unsigned int diskOffset;
-    Bool success;
-    diskOffset = _tIndirectOffset;
-    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-    fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-
-    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
-        if (is_not_null(indirectBlock[i])) {
-            diskOffset = indirectBlock[i];
-            success = add_file_to_double_indirect(_inodeNumF, _name, diskOffset, _allocate);
-            if (success == True) {
-                return True;
-            }  // end if (success == True)
+static void extent_truncate(Extent *_extents, unsigned int *_count, unsigned int _blocks) {
+    SectorBatch batch;
+    batch.count = 0;
+    while (*_count > 0) {
+        Extent *last = &_extents[*_count - 1];
+        if (last->logical + last->length <= _blocks) {
+            break;
         }
-    }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
-    // Allocate more sectors to write to
-    if (_allocate == True) {
-        for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
-            if (is_null(indirectBlock[i])) {
-                indirectBlock[i] = ssm_allocate_sectors(1);
-                if (is_null(indirectBlock[i])) {
-                    return False;
-                } else {
-                    fseek(fsm->diskHandle, _tIndirectOffset, SEEK_SET);
-                    fwrite(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-                    memset(buffer, 0xFF, BLOCK_SIZE);
-                    fseek(fsm->diskHandle, indirectBlock[i], SEEK_SET);
-
-                    fwrite(buffer, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-                }
-                diskOffset = indirectBlock[i];
-                success = add_file_to_double_indirect(_inodeNumF, _name, diskOffset, _allocate);
-                if (success == True) {
-                    return True;
-                }  // end if(success == True)
-            }  // end else
-        }  // for (i = 0; i < BLOCK_SIZE/4; i++)
-    }  // end if (_allocate == True)
-    return False;
+        unsigned int keep = _blocks > last->logical ? _blocks - last->logical : 0;
+        for (unsigned int i = keep; i < last->length; i++) {
+            sector_batch_add(&batch, last->start + i * BLOCK_SIZE);
+        }
+        last->length = keep;
+        if (keep > 0) {
+            break;
+        }
+        *_count -= 1;
+    }
+    sector_batch_flush(&batch);
 }
 
 /**
- * @brief Adds a file to a double indirect pointer.
- * Inserts a file into the structure at the specified double indirect offset,
- * optionally allocating space as needed.
- * @param[in] _inodeNumF Inode number of the file to be added.
- * @param[in] _name Pointer to the name of the file.
- * @param[in] _dIndirectOffset Offset within the double indirect block.
- * @param[in] _allocate If true, allocate additional space as needed.
- * @return True if the file was added successfully, false otherwise.
- * @date 2010-04-01 First implementation.
+ * @brief Allocates blocks at the end of a file until it has `_blocks` blocks.
+ * Runs of up to EXTENT_MAX_RUN contiguous sectors are requested from the SSM, halving the run
+ * when no such run is free; a run that follows the last extent both in the file and on disk
+ * extends it.
+ * @param[in,out] _extents Extents in file order.
+ * @param[in,out] _count Number of extents.
+ * @param[in] _first First block to allocate; unmapped blocks before it are left as a hole.
+ * @param[in] _blocks Number of blocks the file needs.
+ * @return True if the blocks were allocated, false if the disk or the extent slots ran out.
+ * @date 2026-10-18 First implementation.
  */
-static Bool add_file_to_double_indirect(unsigned int _inodeNumF, unsigned int *_name,
-                                        unsigned int _dIndirectOffset, Bool _allocate) {
-    unsigned int indirectBlock[BLOCK_SIZE / 4];
-    unsigned int buffer[BLOCK_SIZE / 4];
-    unsigned int diskOffset;
-    Bool success;
-    diskOffset = _dIndirectOffset;
-    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-    fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-
-    // Add file to a double indirect pointer
-    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
-        if (is_not_null(indirectBlock[i])) {
-            diskOffset = indirectBlock[i];
-            success = add_file_to_single_indirect(_inodeNumF, _name, diskOffset, _allocate);
-            if (success == True) {
-                return True;
-            }  // end if (success == True)
+static Bool extent_grow(Extent *_extents, unsigned int *_count, unsigned int _first,
+                        unsigned int _blocks) {
+    unsigned int mapped = *_count > 0 ? _extents[*_count - 1].logical + _extents[*_count - 1].length
+                                      : 0;
+    if (mapped < _first) {
+        mapped = _first;
+    }
+    unsigned int run = EXTENT_MAX_RUN;
+    while (mapped < _blocks) {
+        unsigned int remaining = _blocks - mapped;
+        unsigned int n = remaining < run ? remaining : run;
+        unsigned int diskOffset = ssm_allocate_sectors((int)n);
+        if (is_null(diskOffset)) {
+            if (n == 1) {
+                return False;
+            }
+            // no run that long is free, settle for shorter ones
+            run = n / 2;
+            continue;
         }
-    }  // for (i = 0; i < BLOCK_SIZE/4; i++)
-    if (_allocate == True) {
-        for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
-            if (is_null(indirectBlock[i])) {
-                indirectBlock[i] = ssm_allocate_sectors(1);
-                if (is_null(indirectBlock[i])) {
-                    return False;
-                } else {
-                    fseek(fsm->diskHandle, _dIndirectOffset, SEEK_SET);
-                    fwrite(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-                    memset(buffer, 0xFF, BLOCK_SIZE);
-                    fseek(fsm->diskHandle, indirectBlock[i], SEEK_SET);
-
-                    fwrite(buffer, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-                }
-                diskOffset = indirectBlock[i];
-                success = add_file_to_single_indirect(_inodeNumF, _name, diskOffset, _allocate);
-                if (success == True) {
-                    return True;
-                }  // end if (success == True)
+        Extent *last = *_count > 0 ? &_extents[*_count - 1] : Null;
+        if (last != Null && last->logical + last->length == mapped &&
+            last->start + last->length * BLOCK_SIZE == diskOffset) {
+            last->length += n;
+        } else if (*_count < MAX_EXTENTS) {
+            _extents[*_count] = (Extent){mapped, diskOffset, n};
+            *_count += 1;
+        } else {
+            for (unsigned int i = 0; i < n; i++) {
+                ssm_deallocate_sectors(diskOffset / BLOCK_SIZE + i);
             }
-        }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
-    }  // end if (_allocate == True)
-    return False;
+            return False;
+        }
+        mapped += n;
+    }
+    return True;
 }
 
 /**
- * @brief Adds a file to a single indirect pointer without allocation.
- * Inserts a file at the specified single indirect offset, optionally allocating space if required.
- * @param[in] _indirectBlock an indirect block buffer
- * @param[in,out] buffer disk buffer
- * @param[in] _inodeNumF Inode number of the file to be added.
- * @param[in] _name Pointer to the name of the file.
- * @param[in,out] diskOffset Offset within the single indirect block.
- * @return True if the file was added successfully, false otherwise.
- * @date 2010-04-01 First implementation.
+ * @brief Maps one more block of a file, merging it into a neighbouring extent when it can.
+ * @param[in,out] _extents Extents in file order.
+ * @param[in,out] _count Number of extents.
+ * @param[in] _logical Index of the block within the file; it must not be mapped yet.
+ * @param[in] _start Disk offset of the block's data.
+ * @return True if the block was mapped, false if the extent slots ran out.
+ * @date 2026-10-18 First implementation.
  */
-static Bool add_file_to_single_indirect_no_alloc(unsigned int *buffer, unsigned int *indirectBlock,
-                                                 unsigned int _inodeNumF, unsigned int *_name,
-                                                 unsigned int *diskOffset) {
-    Bool status = False;
-    unsigned int j = 0;
-    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
-        if (is_not_null(indirectBlock[i])) {
-            *diskOffset = indirectBlock[i];
-            fseek(fsm->diskHandle, *diskOffset, SEEK_SET);
-            fread(buffer, BLOCK_SIZE, 1, fsm->diskHandle);
-            for (j = 0; j < BLOCK_SIZE / 4; j += 4) {
-                if (buffer[j + 3] == 0) {
-                    buffer[j + 3] = 1;
-                    buffer[j] = _name[0];
-                    buffer[j + 1] = _name[1];
-                    buffer[j + 2] = _inodeNumF;
-                    inode.linkCount += 1;
-                    fseek(fsm->diskHandle, 0, SEEK_SET);
-                    fseek(fsm->diskHandle, *diskOffset, SEEK_SET);
-
-                    fwrite(buffer, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-                    fseek(fsm->diskHandle, 0, SEEK_SET);
-                    status = fs_close_file();
-                    if (status == False) printf("Error closing file\n");
-                    return True;
-                }  // end if (buffer[j+3] == 0)
-            }  // for (j = 0; j < BLOCK_SIZE/4; j += 4)
+static Bool extent_insert(Extent *_extents, unsigned int *_count, unsigned int _logical,
+                          unsigned int _start) {
+    unsigned int i = 0;
+    while (i < *_count && _extents[i].logical < _logical) {
+        i++;
+    }
+    Extent *prev = i > 0 ? &_extents[i - 1] : Null;
+    Extent *next = i < *_count ? &_extents[i] : Null;
+    if (prev != Null && prev->logical + prev->length == _logical &&
+        prev->start + prev->length * BLOCK_SIZE == _start) {
+        prev->length += 1;
+        if (next != Null && _logical + 1 == next->logical &&
+            _start + BLOCK_SIZE == next->start) {
+            // the block closed the gap between two extents
+            prev->length += next->length;
+            memmove(next, next + 1, (*_count - i - 1) * sizeof(Extent));
+            *_count -= 1;
         }
-    }  // for (i = 0; i < BLOCK_SIZE/4; i++)
-    return status;
+        return True;
+    }
+    if (next != Null && _logical + 1 == next->logical && _start + BLOCK_SIZE == next->start) {
+        next->logical = _logical;
+        next->start = _start;
+        next->length += 1;
+        return True;
+    }
+    if (*_count == MAX_EXTENTS) {
+        return False;
+    }
+    memmove(&_extents[i + 1], &_extents[i], (*_count - i) * sizeof(Extent));
+    _extents[i] = (Extent){_logical, _start, 1};
+    *_count += 1;
+    return True;
 }
 
 /**
- * @brief Adds a file to a single indirect pointer.
- * Inserts a file at the specified single indirect offset, optionally allocating space if required.
- * @param[in] _inodeNumF Inode number of the file to be added.
- * @param[in] _name Pointer to the name of the file.
- * @param[in] _sIndirectOffset Offset within the single indirect block.
- * @param[in] _allocate If true, allocate space as needed.
- * @return True if the file was added successfully, false otherwise.
- * @date 2010-04-01 First implementation.
+ * @brief Makes sure blocks `_first` to `_end` - 1 of an extent-mapped file have data blocks.
+ * Gaps inside the mapped part of the file get a block each; the part past the last extent is
+ * allocated in runs by `extent_grow`.
+ * @param[in,out] _extents Extents in file order.
+ * @param[in,out] _count Number of extents.
+ * @param[in] _first Index of the first block of the range.
+ * @param[in] _end Index one past the last block of the range.
+ * @return True if the range is mapped, false if the disk or the extent slots ran out.
+ * @date 2026-10-18 First implementation.
  */
-static Bool add_file_to_single_indirect(unsigned int _inodeNumF, unsigned int *_name,
-                                        unsigned int _sIndirectOffset, Bool _allocate) {
-    unsigned int indirectBlock[BLOCK_SIZE / 4];
-    unsigned int diskOffset;
-    unsigned int buffer[BLOCK_SIZE / 4];
-    diskOffset = _sIndirectOffset;  // inode.sIndirect;
-    Bool status;
-    // Read indirect block
-    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-    fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-
-    if (_allocate == False) {
-        status = add_file_to_single_indirect_no_alloc(buffer, indirectBlock, _inodeNumF, _name,
-                                                      &diskOffset);
-    }  // if (_allocate == False)
-    else {
-        // Allocate space then write
-        for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
-            if (is_null(indirectBlock[i])) {
-                indirectBlock[i] = ssm_allocate_sectors(1);
-                if (is_null(indirectBlock[i])) {
-                    return False;
-                } else {
-                    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-                    fwrite(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-                    memset(buffer, 0, BLOCK_SIZE);
-
-                    buffer[3] = 1;
-                    buffer[0] = _name[0];
-                    buffer[1] = _name[1];
-                    buffer[2] = _inodeNumF;
-                    inode.linkCount += 1;
-                    inode.fileSize += BLOCK_SIZE;
-                    inode.dataBlocks = inode.fileSize / BLOCK_SIZE;
-                    fseek(fsm->diskHandle, indirectBlock[i], SEEK_SET);
+static Bool extent_allocate(Extent *_extents, unsigned int *_count, unsigned int _first,
+                            unsigned int _end) {
+    unsigned int mapped = *_count > 0 ? _extents[*_count - 1].logical + _extents[*_count - 1].length
+                                      : 0;
+    unsigned int i = 0;
+    for (unsigned int block = _first; block < _end && block < mapped; block++) {
+        while (i < *_count && _extents[i].logical + _extents[i].length <= block) {
+            i++;
+        }
+        if (i < *_count && _extents[i].logical <= block) {
+            continue;
+        }
+        unsigned int diskOffset = ssm_allocate_sectors(1);
+        if (is_null(diskOffset)) {
+            return False;
+        }
+        if (extent_insert(_extents, _count, block, diskOffset) == False) {
+            ssm_deallocate_sectors(diskOffset / BLOCK_SIZE);
+            return False;
+        }
+    }
+    return _end > mapped ? extent_grow(_extents, _count, _first, _end) : True;
+}
 
-                    fwrite(buffer, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-                    fseek(fsm->diskHandle, 0, SEEK_SET);
-                    status = fs_close_file();
-                    if (status == False) printf("Error closing file\n");
-                    return True;
-                }
-            }
-        }  // for (i = 0; i < BLOCK_SIZE/4; i++)
-    }  // end else
-    return False;
+/**
+ * @brief Tells whether a block of the data written to an extent-mapped file is all zeros.
+ * @param[in] _buffer Data being written.
+ * @param[in] _size Number of bytes of data; the last block may be partial.
+ * @param[in] _block Index of the block to check.
+ * @return True if the block holds only zeros; false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool extent_block_is_zero(const char *_buffer, unsigned int _size, unsigned int _block) {
+    size_t first = (size_t)_block * BLOCK_SIZE;
+    size_t len = _size - first < BLOCK_SIZE ? _size - first : BLOCK_SIZE;
+    return block_is_zero(_buffer + first, (unsigned int)len);
 }
 
 /**
- * @brief Removes a file from a directory indirect pointers.
- * Removes the file identified by `_inodeNumF`.
- * @param[in] _inodeNumF Inode number of the file to be removed.
- * @param[in] _inodeNumD Inode number of the file's parent directory
- * @return True if the file was successfully removed, false if the file could not be accessed.
- * @date 2010-04-01 First implementation.
+ * @brief Writes the open file (`inode`) as an extent-mapped file.
+ * Blocks past the new size are freed, missing blocks are allocated in runs, and each extent's
+ * data goes out with one write. With sparse files on, the old extents are freed and each run of
+ * non-zero blocks gets extents of its own; runs of zero blocks become gaps between them.
+ * @param[in] _inodeNum Inode number of the open file.
+ * @param[in] _buffer Data to write.
+ * @param[in] _size Number of bytes.
+ * @return True if the data was written, false if the disk or the extent slots ran out.
+ * @date 2026-10-18 First implementation.
  */
-static Bool remove_file_from_dir_indirect_pointers(unsigned int _inodeNumF,
-                                                   unsigned int _inodeNumD) {
-    // if the directory has files in it's sindirect pointer area, remove them
-    Bool success = False;
-    if (is_not_null(inode.sIndirect)) {
-        success = remove_file_from_single_indirect(_inodeNumF, _inodeNumD, (unsigned int)(-1),
-                                                   inode.sIndirect);
-        if (success == True) {
-            return True;
-        }  // end if (success == True)
-    }
-    // if the directory has files in it's dindirect pointer area, remove them
-    if (is_not_null(inode.dIndirect)) {
-        success = remove_file_from_double_indirect(_inodeNumF, _inodeNumD, (unsigned int)(-1),
-                                                   inode.dIndirect);
-        if (success == True) {
-            return True;
-        }  // end if (success == True)
+static Bool write_extents(unsigned int _inodeNum, const void *_buffer, unsigned int _size) {
+    Extent extents[MAX_EXTENTS];
+    unsigned int count = 0;
+    if (is_extent(&inode)) {
+        count = extent_load(extents);
     }
-    // if the directory has files in it's tindirect pointer area, remove them
-    if (is_not_null(inode.tIndirect)) {
-        success = remove_file_from_triple_indirect(_inodeNumF, _inodeNumD, inode.tIndirect);
-        if (success == True) {
-            return True;
-        }  // end if (success == True)
-    }
-    return success;
-}
-
-Bool fs_remove_file_from_dir(unsigned int _inodeNumF, unsigned int _inodeNumD) {
-    unsigned int j, k, diskOffset, sectorNum;
-    unsigned int buffer[BLOCK_SIZE / 4];
-    // open the parent directory inode
-    if (!fs_open_file(_inodeNumD, &inode)) return False;
-    if (inode.fileType == 2) {  // type 2 is directory
-        for (unsigned int i = 0; i < INODE_DIRECT_PTRS; i++) {
-            if (is_not_null(inode.directPtr[i])) {
-                diskOffset = inode.directPtr[i];
-                fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-                fread(buffer, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-                // clear all 4 bytes on each loop
-                for (j = 0; j < BLOCK_SIZE / 4; j += 4) {
-                    if (buffer[j + 3] == 1 && buffer[j + 2] == _inodeNumF) {
-                        memset(&buffer[j], 0, 4 * sizeof(unsigned int));
-                        inode.linkCount -= 1;
-                        if (inode.linkCount == 0) {
-                            // if there is nothing in the directory, set size to 0
-                            inode.fileSize = 0;
-                            if (inode_init_ptrs(&inode) == FAILURE) {
-                                // @todo do something here
-                            }
-                        }
-                        fseek(fsm->diskHandle, 0, SEEK_SET);
-                        fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-
-                        fwrite(buffer, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-                        for (k = 0; k < BLOCK_SIZE / 4; k += 4) {
-                            if (buffer[k + 3] == 1) {
-                                break;
-                            }
-                        }
-                        if (k == BLOCK_SIZE / 4) {
-                            sectorNum = inode.directPtr[i] / BLOCK_SIZE;
-                            ssm_deallocate_sectors(sectorNum);
-                            inode.directPtr[i] = (unsigned int)(-1);
-                            inode.dataBlocks -= 1;
-                            inode_write(&inode, _inodeNumD, fsm->diskHandle);
-                        }
-                        return True;
-                    }
-                }
+    unsigned int blocks = _size / BLOCK_SIZE + (_size % BLOCK_SIZE > 0 ? 1 : 0);
+    const char *buffer = _buffer;
+    Bool status = True;
+    if (fsm->sparseFiles == True) {
+        extent_truncate(extents, &count, 0);
+        unsigned int first = 0;
+        while (first < blocks && status == True) {
+            if (count + 1 >= MAX_EXTENTS) {
+                // out of extent slots for more gaps, the rest of the file is written out whole
+                status = extent_grow(extents, &count, first, blocks);
+                break;
             }
+            if (extent_block_is_zero(buffer, _size, first) == True) {
+                first++;
+                continue;
+            }
+            unsigned int last = first + 1;
+            while (last < blocks && extent_block_is_zero(buffer, _size, last) == False) {
+                last++;
+            }
+            status = extent_grow(extents, &count, first, last);
+            first = last;
         }
-        if (remove_file_from_dir_indirect_pointers(_inodeNumF, _inodeNumD)) {
-            return True;
+    } else {
+        extent_truncate(extents, &count, blocks);
+        status = extent_grow(extents, &count, 0, blocks);
+    }
+    for (unsigned int i = 0; i < count; i++) {
+        size_t first = (size_t)extents[i].logical * BLOCK_SIZE;
+        size_t len = (size_t)extents[i].length * BLOCK_SIZE;
+        if (first + len > _size) {
+            // the last block is partial; pad it with zeros
+            size_t whole = (_size - first) / BLOCK_SIZE * BLOCK_SIZE;
+            unsigned char tail[BLOCK_SIZE];
+            memset(tail, 0, BLOCK_SIZE);
+            memcpy(tail, buffer + first + whole, _size - first - whole);
+            disk_write(buffer + first, extents[i].start, (unsigned int)whole);
+            disk_write(tail, extents[i].start + (unsigned int)whole, BLOCK_SIZE);
+        } else {
+            disk_write(buffer + first, extents[i].start, (unsigned int)len);
         }
     }
-    return False;
+    // on failure the file keeps the blocks that could be allocated
+    unsigned int mapped = count > 0 ? extents[count - 1].logical + extents[count - 1].length : 0;
+    inode.fileSize = status == True || mapped * BLOCK_SIZE >= _size ? _size : mapped * BLOCK_SIZE;
+    inode.dataBlocks = inode.fileSize / BLOCK_SIZE;
+    if (extent_store(_inodeNum, extents, count) == False) {
+        return False;
+    }
+    return status;
 }
 
 /**
- * @brief Removes a file from a triple indirect pointer.
- * Removes the file identified by `_inodeNumF` from the triple indirect block at the specified
- * offset. Internally calls `rmFileFrom_D_Indirect` to complete the operation.
- * @param[in] _inodeNumF Inode number of the file to be removed.
- * @param[in] _inodeNumD Inode number of the file's parent.
- * @param[in] _tIndirectOffset Offset to the triple indirect block containing the file.
- * @return True if the file was successfully removed, false if the file could not be accessed.
- * @date 2010-04-01 First implementation.
+ * @brief Updates the readahead state of a file after a read and prefetches if sequential.
+ * A read that starts where the previous one stopped doubles the window (up to
+ * READAHEAD_MAX_BLOCKS) and prefetches that many blocks past it; any other read halves the
+ * window (down to READAHEAD_MIN_BLOCKS). Blocks behind a pointer block that has not been read
+ * yet are not mapped; the pointer block itself is prefetched instead, so the next read finds it
+ * in memory.
+ * @param[in,out] _state Readahead state of the file (a shared slot or a handle's).
+ * @param[in] _inodeNum Inode number of the file that was read.
+ * @param[in] _firstBlock Index of the first block read.
+ * @param[in] _count Number of blocks read.
+ * @param[in] _map Block map of the file, may be Null.
+ * @param[in,out] _path Pointer blocks read while serving the read.
+ * @return void
+ * @date 2026-10-18 First implementation.
  */
-static Bool remove_file_from_triple_indirect(unsigned int _inodeNumF, unsigned int _inodeNumD,
-                                             unsigned int _tIndirectOffset) {
-    unsigned int indirectBlock[BLOCK_SIZE / 4];
-    unsigned int diskOffset, sectorNum;
-    Bool success;
-    diskOffset = _tIndirectOffset;
-    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-    fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-    unsigned int k;
-    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
-        if (is_not_null(indirectBlock[i])) {
-            diskOffset = indirectBlock[i];
-            success = remove_file_from_double_indirect(_inodeNumF, _inodeNumD, _tIndirectOffset,
-                                                       diskOffset);
-            if (success == True) {
-                diskOffset = _tIndirectOffset;
-                fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-                fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-                for (k = 0; k < BLOCK_SIZE / 4; k++) {
-                    if (is_not_null(indirectBlock[k])) break;
-                }  // end for (k = 0; k < BLOCK_SIZE/4; k++)
-                if (k == BLOCK_SIZE / 4) {
-                    sectorNum = _tIndirectOffset / BLOCK_SIZE;
-                    ssm_deallocate_sectors(sectorNum);
-                    inode.tIndirect = (unsigned int)(-1);
-                    inode_write(&inode, _inodeNumD, fsm->diskHandle);
-                }  // end if (k == BLOCK_SIZE/4)
-                return True;
-            }  // if (success == True)
+static void read_ahead(Readahead *_state, unsigned int _inodeNum, unsigned int _firstBlock,
+                       unsigned int _count, BlockMap *_map, PointerPath *_path) {
+    Readahead *state = _state;
+    if (state->inodeNum != _inodeNum || state->window == 0) {
+        // first read of this file through the slot
+        state->inodeNum = _inodeNum;
+        state->window = READAHEAD_MIN_BLOCKS;
+        state->nextBlock = _firstBlock + _count;
+        return;
+    }
+    Bool sequential = state->nextBlock == _firstBlock;
+    state->nextBlock = _firstBlock + _count;
+    if (sequential == False) {
+        state->window = state->window / 2 < READAHEAD_MIN_BLOCKS ? READAHEAD_MIN_BLOCKS
+                                                                 : state->window / 2;
+        return;
+    }
+    unsigned int offsets[READAHEAD_MAX_BLOCKS + 1];
+    unsigned int count = 0;
+    unsigned int pending = (unsigned int)(-1);
+    for (unsigned int i = 0; i < state->window; i++) {
+        unsigned int diskOffset =
+            block_map_lookup(_map, state->nextBlock + i, _path, False, &pending);
+        if (is_not_null(pending)) {
+            // the next pointer block has not been read yet; fetch it for the next read
+            offsets[count++] = pending;
+            break;
         }
-    }  // for (i = 0; i < BLOCK_SIZE/4; i++)
-    return False;
-}
-
-/**
- * @brief Removes a file from a double indirect pointer.
- * Removes the file identified by `_inodeNumF` from the double indirect block at the specified
- * offset. Typically called by higher-level triple indirect removal logic.
- * @param[in] _inodeNumF Inode number of the file to be removed.
- * @param[in] _inodeNumD Inode number of the file's parent.
- * @param[in] _tIndirectOffset Offset to the parent triple indirect block.
- * @param[in] _dIndirectOffset Offset to the double indirect block containing the file.
- * @return True if the file was successfully removed, false if the file could not be accessed.
- * @date 2010-04-01 First implementation.
- */
-static Bool remove_file_from_double_indirect(unsigned int _inodeNumF, unsigned int _inodeNumD,
-                                             unsigned int _tIndirectOffset,
-                                             unsigned int _dIndirectOffset) {
-    unsigned int indirectBlock[BLOCK_SIZE / 4];
-    unsigned int diskOffset, sectorNum;
-    Bool success;
-    // load next pointer
-    diskOffset = _dIndirectOffset;
-    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-    fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-    unsigned int k;
-    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
-        if (is_not_null(indirectBlock[i])) {
-            diskOffset = indirectBlock[i];
-            success = remove_file_from_single_indirect(_inodeNumF, _inodeNumD, _dIndirectOffset,
-                                                       diskOffset);
-            if (success == True) {
-                diskOffset = _dIndirectOffset;
-                fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-                fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-                for (k = 0; k < BLOCK_SIZE / 4; k++) {
-                    if (is_not_null(indirectBlock[k])) break;
-                }  // end for (k = 0; k < BLOCK_SIZE/4; k++)
-                if (k == BLOCK_SIZE / 4) {
-                    sectorNum = _dIndirectOffset / BLOCK_SIZE;
-                    ssm_deallocate_sectors(sectorNum);
-                    if (is_not_null(_tIndirectOffset)) {
-                        diskOffset = _tIndirectOffset;
-                        fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-                        fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-                        for (k = 0; k < BLOCK_SIZE / 4; k++) {
-                            if (indirectBlock[k] == _dIndirectOffset) {
-                                indirectBlock[k] = (unsigned int)(-1);
-                                break;
-                            }  // end if (indirectBlock[k] == _dIndirectOffset)
-                        }  // end for (k = 0; k < BLOCK_SIZE/4; k++)
-                        fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-                        fwrite(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-                    } else {
-                        inode.dIndirect = (unsigned int)(-1);
-                        inode_write(&inode, _inodeNumD, fsm->diskHandle);
-                    }  // end else
-                }  // if (k == BLOCK_SIZE/4)
-                return True;
-            }  // end if (success == True)
+        if (is_not_null(diskOffset)) {
+            offsets[count++] = diskOffset;
         }
-    }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
-    return False;
+    }
+    disk_prefetch(offsets, count, BLOCK_SIZE);
+    state->window = 2 * state->window > READAHEAD_MAX_BLOCKS ? READAHEAD_MAX_BLOCKS
+                                                              : 2 * state->window;
 }
 
 /**
- * @brief Removes a file from a single indirect pointer.
- * Removes the file identified by `_inodeNumF` from the single indirect block located
- * via the specified double and single indirect offsets.
- * @param[in] _inodeNumF Inode number of the file to be removed.
- * @param[in] _inodeNumD Inode number of the file's parent.
- * @param[in] _dIndirectOffset Offset to the parent double indirect block.
- * @param[in] _sIndirectOffset Offset to the single indirect block containing the file.
- * @return True if the file was successfully removed, false if the file could not be accessed.
- * @date 2010-04-01 First implementation.
+ * @brief Appends a data block to a file's block list.
+ * @param[in,out] _list Block list to grow.
+ * @param[in] _buffer Where the block's data goes in the read buffer.
+ * @param[in] _diskOffset Disk offset of the data block.
+ * @return True if the block was appended, false if the list could not grow.
+ * @date 2026-10-18 First implementation.
  */
-static Bool remove_file_from_single_indirect(unsigned int _inodeNumF, unsigned int _inodeNumD,
-                                             unsigned int _dIndirectOffset,
-                                             unsigned int _sIndirectOffset) {
-    unsigned int indirectBlock[BLOCK_SIZE / 4];
-    unsigned int diskOffset, sectorNum, j, k;
-    unsigned int buffer[BLOCK_SIZE / 4];
-    diskOffset = _sIndirectOffset;
-    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-    fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
-        if (is_not_null(indirectBlock[i])) {
-            diskOffset = indirectBlock[i];
-            fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-            fread(buffer, BLOCK_SIZE, 1, fsm->diskHandle);
-            for (j = 0; j < BLOCK_SIZE / 4; j += 4) {
-                if (buffer[j + 3] == 1 && buffer[j + 2] == _inodeNumF) {
-                    memset(&buffer[j], 0, 4 * sizeof(unsigned int));
-                    inode.linkCount -= 1;
-                    fseek(fsm->diskHandle, 0, SEEK_SET);
-                    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-
-                    fwrite(buffer, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-                    for (k = 0; k < BLOCK_SIZE / 4; k += 4) {
-                        if (buffer[k + 3] == 1) break;
-                    }
-                    if (k == BLOCK_SIZE / 4) {
-                        sectorNum = indirectBlock[i] / BLOCK_SIZE;
-                        ssm_deallocate_sectors(sectorNum);
-                        inode.dataBlocks -= 1;
-                        inode_write(&inode, _inodeNumD, fsm->diskHandle);
-                        indirectBlock[i] = (unsigned int)(-1);
-                        diskOffset = _sIndirectOffset;
-                        fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-                        fwrite(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-                        for (k = 0; k < BLOCK_SIZE / 4; k++) {
-                            if (is_not_null(indirectBlock[k])) break;
-                        }
-                        if (k == BLOCK_SIZE / 4) {
-                            sectorNum = _sIndirectOffset / BLOCK_SIZE;
-                            ssm_deallocate_sectors(sectorNum);
-                            if (is_not_null(_dIndirectOffset)) {
-                                diskOffset = _dIndirectOffset;
-                                fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-                                fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-                                for (k = 0; k < BLOCK_SIZE / 4; k++) {
-                                    if (indirectBlock[k] == _sIndirectOffset) {
-                                        indirectBlock[k] = (unsigned int)(-1);
-                                        break;
-                                    }
-                                }
-                                fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-
-                                fwrite(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-                            } else {
-                                inode.sIndirect = (unsigned int)(-1);
-                                inode_write(&inode, _inodeNumD, fsm->diskHandle);
-                            }
-                        }
-                    }
-                    return True;
-                }
-            }
+static Bool block_list_append(BlockList *_list, void *_buffer, unsigned int _diskOffset) {
+    if (_list->count == _list->capacity) {
+        unsigned int capacity = _list->capacity == 0 ? PTRS_PER_BLOCK : 2 * _list->capacity;
+        DiskRequest *requests = realloc(_list->requests, capacity * sizeof(DiskRequest));
+        if (requests == NULL) {
+            return False;
         }
+        _list->requests = requests;
+        _list->capacity = capacity;
     }
-    return False;
+    _list->requests[_list->count++] = (DiskRequest){_buffer, _diskOffset, BLOCK_SIZE};
+    return True;
 }
 
 /**
- * @brief Reads pointers from a triple indirect block into a buffer.
- * Fills the provided buffer with all pointers from a specified triple indirect block,
- * one block at a time. Internally calls `readFrom_D_IndirectBlocks`.
- * @param[out] _buffer Pointer to the buffer where the read data will be stored.
- * @param[in] _diskOffset Offset to the first usable block on disk.
- * @return void
- * @date 2010-04-12 First implementation.
+ * @brief Accounts for `_blocks` unmapped blocks of a file being listed.
+ * No request reads a hole, so the part of it inside the file is zero-filled in the read buffer
+ * here.
+ * @param[in] _list Block list being built.
+ * @param[in] _buffer Where the first block of the hole goes in the read buffer.
+ * @param[in] _blocks Number of blocks in the hole.
+ * @return True if the hole takes up room in the read buffer, false if unmapped blocks are
+ * skipped (directories).
+ * @date 2026-10-18 First implementation.
  */
-static void read_from_triple_indirect_blocks(void *_buffer, unsigned int _diskOffset) {
-    unsigned int indirectBlock[BLOCK_SIZE / 4];
-    unsigned int diskOffset = _diskOffset;
-    void *buffer = _buffer;
-    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-    fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
-        if (is_not_null(indirectBlock[i])) {
-            diskOffset = indirectBlock[i];
-            read_from_double_indirect_blocks(buffer, diskOffset);
-            buffer = (char *)buffer + BLOCK_SIZE * D_INDIRECT_BLOCKS;
+static Bool block_list_hole(BlockList *_list, void *_buffer, unsigned int _blocks) {
+    if (_list->end == Null) {
+        return False;
+    }
+    char *buffer = _buffer;
+    if (buffer < _list->end) {
+        size_t len = (size_t)_blocks * BLOCK_SIZE;
+        if (len > (size_t)(_list->end - buffer)) {
+            len = (size_t)(_list->end - buffer);
         }
-    }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
+        memset(buffer, 0, len);
+    }
+    return True;
 }
 
 /**
- * @brief Reads pointers from a double indirect block into a buffer.
- * Fills the provided buffer with all pointers from a specified double indirect block,
- * one block at a time. Internally calls `readFrom_S_IndirectBlocks`.
- * @param[out] _buffer Pointer to the buffer where the read data will be stored.
- * @param[in] _diskOffset Offset to the first usable block on disk.
- * @return void
- * @date 2010-04-12 First implementation.
+ * @brief Writes data to a file that uses direct blocks.
+ * Writes the contents of the provided buffer to the file identified by the given inode number.
+ * @param[in,out] _buffer Pointer to the data to be written.
+ * @param[in,out] directPtrs the number of direct blocks
+ * @return the updated buffer address.
+ * @date 2025-06-16 First implementation.
  */
-static void read_from_double_indirect_blocks(void *_buffer, unsigned int _diskOffset) {
-    unsigned int indirectBlock[BLOCK_SIZE / 4];
-    unsigned int diskOffset = _diskOffset;
-    void *buffer = _buffer;
-    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-    fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
-        if (is_not_null(indirectBlock[i])) {
-            diskOffset = indirectBlock[i];
-            read_from_single_indirect_blocks(buffer, diskOffset);
-            buffer = (char *)buffer + BLOCK_SIZE * S_INDIRECT_BLOCKS;
+static void *write_to_file_direct(void *buffer, unsigned int directPtrs) {
+    unsigned int diskOffset;
+    for (unsigned int i = 0; i < directPtrs; i++) {
+        diskOffset = inode.directPtr[i];
+        if (sparse_block(buffer)) {
+            // A block of zeros is left as a hole, freeing the block it had
+            if (is_not_null(diskOffset)) {
+                ssm_deallocate_sectors(diskOffset / BLOCK_SIZE);
+                inode.directPtr[i] = (unsigned int)(-1);
+            }
+            buffer = (char *)buffer + BLOCK_SIZE;
+        } else if (is_null(diskOffset)) {
+            // If direct pointer is empty, get a Sector for it
+            diskOffset = ssm_allocate_sectors(1);
+            if (is_null(diskOffset)) {
+                break;
+            } else {
+                inode.directPtr[i] = diskOffset;
+                disk_write(buffer, diskOffset, BLOCK_SIZE);
+                buffer = (char *)buffer + BLOCK_SIZE;
+            }
+        } else {
+            // Overwrite the data at that location
+            disk_write(buffer, diskOffset, BLOCK_SIZE);
+            buffer = (char *)buffer + BLOCK_SIZE;
         }
-    }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
+    }  // end for (i = 0; i < directPtrs; i++)
+    return buffer;
 }
 
 /**
- * @brief Reads pointers from a single indirect block into a buffer.
- * Fills the provided buffer with all pointers from a specified single indirect block,
- * one block at a time.
- * @param[out] _buffer Pointer to the buffer where the read data will be stored.
+ * @brief Writes data to a file that uses single indirect blocks.
+ * Writes the contents of the provided buffer to the file identified by the given inode number.
+ * @param[in,out] _buffer Pointer to the data to be written.
+ * @param[in,out] _fileSize Size of the data to write, in bytes.
+ * @param[in,out] baseOffset the base offset to write to
+ * @param[in,out] sIndirectPtrs the number of single indirect blocks
+ * @return the updated buffer address.
+ * @date 2025-06-16 First implementation.
+ */
+static void *write_to_file_using_single_indirect_blocks(void *buffer, long long int *fileSize,
+                                                        unsigned int *baseOffset,
+                                                        unsigned int *sIndirectPtrs) {
+    // Calculate number of single indirect pointers needed
+    *sIndirectPtrs = *fileSize / BLOCK_SIZE;
+    if (*fileSize % BLOCK_SIZE > 0) {
+        *sIndirectPtrs += 1;
+    }  // end if (fileSize % BLOCK_SIZE > 0)
+    // Allocate single indirect pointers
+    inode.sIndirect = aloc_single_indirect(*sIndirectPtrs);
+    // Write to single indirect pointers
+    *baseOffset = inode.sIndirect;
+    write_to_single_indirect_blocks(*baseOffset, buffer, *sIndirectPtrs);
+    return buffer;
+}
+
+/**
+ * @brief Writes data to a file that uses double indirect blocks.
+ * Writes the contents of the provided buffer to the file identified by the given inode number.
+ * @param[in,out] _buffer Pointer to the data to be written.
+ * @param[in,out] _fileSize Size of the data to write, in bytes.
+ * @param[in,out] baseOffset the base offset to write to
+ * @param[in,out] sIndirectPtrs the number of single indirect blocks
+ * @param[in,out] dIndirectPtrs the number of double indirect blocks
+ * @return the updated buffer address.
+ * @date 2025-06-16 First implementation.
+ */
+static void *write_to_file_using_double_indirect_blocks(void *buffer, long long int *fileSize,
+                                                        unsigned int *baseOffset,
+                                                        unsigned int *sIndirectPtrs,
+                                                        unsigned int *dIndirectPtrs) {
+    // Allocate single Indirect blocks
+    *sIndirectPtrs = S_INDIRECT_BLOCKS;
+    inode.sIndirect = aloc_single_indirect(*sIndirectPtrs);
+    // Write to single Indirect pointers
+    *baseOffset = inode.sIndirect;
+    write_to_single_indirect_blocks(*baseOffset, buffer, *sIndirectPtrs);
+    buffer = (char *)buffer + BLOCK_SIZE * S_INDIRECT_BLOCKS;
+    // Calculate Remaining filesize
+    *fileSize = *fileSize + (INODE_DIRECT_PTRS * BLOCK_SIZE) - S_INDIRECT_SIZE;
+    // Calculate number of double Indirect Pointrs needed
+    *dIndirectPtrs = *fileSize / BLOCK_SIZE;
+    if (*fileSize % BLOCK_SIZE > 0) {
+        *dIndirectPtrs += 1;
+    }  // end if (fileSize % BLOCK_SIZE > 0)
+    // Allocate double Indirect Pointers
+    inode.dIndirect = aloc_double_indirect(*dIndirectPtrs);
+    *baseOffset = inode.dIndirect;
+    // Write to double Indirect Pointers
+    write_to_double_indirect_blocks(*baseOffset, buffer, *dIndirectPtrs);
+
+    return buffer;
+}
+
+/**
+ * @brief Writes data to a file that uses triple indirect blocks.
+ * Writes the contents of the provided buffer to the file identified by the given inode number.
+ * @param[in,out] _buffer Pointer to the data to be written.
+ * @param[in,out] _fileSize Size of the data to write, in bytes.
+ * @param[in,out] baseOffset the base offset to write to
+ * @param[in,out] sIndirectPtrs the number of single indirect blocks
+ * @param[in,out] dIndirectPtrs the number of double indirect blocks
+ * @param[in,out] tIndirectPtrs the number of triple indirect blocks
+ * @return the updated buffer address.
+ * @date 2025-06-16 First implementation.
+ */
+static void *write_to_file_using_triple_indirect_blocks(void *buffer, long long int *fileSize,
+                                                        unsigned int *baseOffset,
+                                                        unsigned int *sIndirectPtrs,
+                                                        unsigned int *dIndirectPtrs,
+                                                        unsigned int *tIndirectPtrs) {
+    *sIndirectPtrs = S_INDIRECT_BLOCKS;
+    *dIndirectPtrs = D_INDIRECT_BLOCKS;
+    // Allocate Single and double indirect pointers
+    inode.sIndirect = aloc_single_indirect(*sIndirectPtrs);
+    inode.dIndirect = aloc_double_indirect(*dIndirectPtrs);
+    // Write to single indirect blocks
+    *baseOffset = inode.sIndirect;
+    write_to_single_indirect_blocks(*baseOffset, buffer, *sIndirectPtrs);
+    buffer = (char *)buffer + BLOCK_SIZE * S_INDIRECT_BLOCKS;
+    // Write to double indirect blocks
+    *baseOffset = inode.dIndirect;
+    write_to_double_indirect_blocks(*baseOffset, buffer, *dIndirectPtrs);
+    buffer = (char *)buffer + BLOCK_SIZE * D_INDIRECT_BLOCKS;
+    // Calculate remaining filesize
+    *fileSize = *fileSize + (INODE_DIRECT_PTRS * BLOCK_SIZE) - D_INDIRECT_SIZE;
+    // Calculate number of triple Indirect pointers needed
+    *tIndirectPtrs = *fileSize / BLOCK_SIZE;
+    if (*fileSize % BLOCK_SIZE > 0) {
+        *tIndirectPtrs += 1;
+    }  // end if (fileSize % BLOCK_SIZE > 0)
+    // Allocate triple Indirect Pointers
+    inode.tIndirect = aloc_triple_indirect(*tIndirectPtrs);
+    *baseOffset = inode.tIndirect;
+    // Write to tripleIndirectBlocks
+    write_to_triple_indirect_blocks(*baseOffset, buffer, *tIndirectPtrs);
+
+    return buffer;
+}
+
+Bool fs_write_to_file(unsigned int _inodeNum, void *_buffer, long long int _fileSize) {
+    // return false if openFile fails
+    if (!fs_open_file(_inodeNum, &inode)) {
+        return False;
+    }  // end if (success == False)
+    block_map_invalidate(_inodeNum);
+    // Small files that own no blocks are kept inline in the inode
+    if (fsm->inlineData == True && inode.fileType == 1 && _fileSize >= 0 &&
+        _fileSize <= (long long int)inode_inline_capacity() &&
+        (is_inline(&inode) || has_no_blocks(&inode))) {
+        return write_inline(_inodeNum, _buffer, (unsigned int)_fileSize);
+    }
+    if (is_inline(&inode)) {
+        // The data outgrew the inode; its pointers become pointers again
+        inode.status &= ~INODE_INLINE;
+        if (inode_init_ptrs(&inode) == FAILURE) {
+            inode.status |= INODE_INLINE;
+            return False;
+        }
+    }
+    // Extent-mapped files, and new files when extents are selected, are written as extents
+    if (inode.fileType == 1 && _fileSize >= 0 &&
+        (is_extent(&inode) || (fsm->extentFiles == True && has_no_blocks(&inode)))) {
+        return write_extents(_inodeNum, _buffer, (unsigned int)_fileSize);
+    }
+    // set fileSize and inode fileSize
+    long long int fileSize = _fileSize;
+    inode.fileSize = (unsigned int)_fileSize;
+    inode.dataBlocks = inode.fileSize / BLOCK_SIZE;
+    unsigned int directPtrs = 0;
+    // Calculate how many direct pointers needed
+    for (unsigned int i = 0; i < INODE_DIRECT_PTRS; i++) {
+        fileSize -= BLOCK_SIZE;
+        directPtrs++;
+        if (fileSize <= 0) {
+            break;
+        }  // end else (fileSize > 0)
+    }  // end for (i = 0; i < INODE_DIRECT_PTRS; i++)
+    void *buffer = _buffer;
+    // Write to direct pointers
+    buffer = write_to_file_direct(buffer, directPtrs);
+
+    unsigned int sIndirectPtrs = 0;
+    unsigned int dIndirectPtrs = 0;
+    unsigned int tIndirectPtrs = 0;
+    unsigned int baseOffset;
+    // If file is too big for the direct pointers,
+    // begin looking at the indrect pointers
+    if (fileSize > 0) {
+        // Write to file using triple Indirection if file too big for
+        /// double indirection
+        if (fileSize + (INODE_DIRECT_PTRS * BLOCK_SIZE) - D_INDIRECT_SIZE > 0) {
+            buffer = write_to_file_using_triple_indirect_blocks(
+                buffer, &fileSize, &baseOffset, &sIndirectPtrs, &dIndirectPtrs, &tIndirectPtrs);
+
+        }  // end if (fileSize + (INODE_DIRECT_PTRS * BLOCK_SIZE) - D_INDIRECT_SIZE > 0)
+        // Write to file using double Indirection if too big for
+        //   single indirection
+        else if (fileSize + (INODE_DIRECT_PTRS * BLOCK_SIZE) - S_INDIRECT_SIZE > 0) {
+            buffer = write_to_file_using_double_indirect_blocks(buffer, &fileSize, &baseOffset,
+                                                                &sIndirectPtrs, &dIndirectPtrs);
+        }  // end else if (fileSize + (INODE_DIRECT_PTRS * BLOCK_SIZE) - S_INDIRECT_SIZE > 0)
+        // Write to file using single Indirection only
+        else {
+            buffer = write_to_file_using_single_indirect_blocks(buffer, &fileSize, &baseOffset,
+                                                                &sIndirectPtrs);
+        }  // end else
+    }  // end if (fileSize > 0)
+    // Write created inode to disk
+    inode_write(&inode, _inodeNum);
+    return True;
+}
+
+long long int fs_pwrite(unsigned int _inodeNum, const void *_buffer, unsigned int _len,
+                        unsigned int _offset) {
+    if (!fs_open_file(_inodeNum, &inode)) {
+        return -1;
+    }
+    return write_range(_inodeNum, _buffer, _len, _offset, Null);
+}
+
+/**
+ * @brief Writes part of the open file (`inode`), as `fs_pwrite` does.
+ * A range inside the file whose blocks `_map` already maps is overwritten through the map: no
+ * pointer is read or changed and the inode is left as it is.
+ * @param[in] _inodeNum Inode number of the open file.
+ * @param[in] _buffer Data to write.
+ * @param[in] _len Number of bytes to write.
+ * @param[in] _offset Byte offset within the file of the first byte to write.
+ * @param[in] _map Up-to-date block map of the file, or Null.
+ * @return The number of bytes written, or -1 if the file is a directory or the disk ran out of
+ * space.
+ * @date 2026-10-18 First implementation.
+ */
+static long long int write_range(unsigned int _inodeNum, const void *_buffer, unsigned int _len,
+                                 unsigned int _offset, BlockMap *_map) {
+    unsigned int end = _offset + _len;
+    if (inode.fileType == 2 || end < _offset) {
+        // directories change through their entries; the range must fit in a file size
+        return -1;
+    }
+    if (_len == 0) {
+        return 0;
+    }
+    unsigned int first = _offset / BLOCK_SIZE;
+    unsigned int last = (end - 1) / BLOCK_SIZE;
+    Bool inPlace = _map != NULL && !is_inline(&inode) && end <= inode.fileSize &&
+                   last < _map->count;
+    for (unsigned int i = first; inPlace == True && i <= last; i++) {
+        inPlace = is_not_null(_map->blocks[i]);
+    }
+    if (inPlace == False) {
+        block_map_invalidate(_inodeNum);
+        _map = Null;
+    }
+    unsigned int oldSize = inode.fileSize;
+    unsigned int size = end > oldSize ? end : oldSize;
+    // Small files are patched in the inode
+    if (fsm->inlineData == True && inode.fileType == 1 && size <= inode_inline_capacity() &&
+        (is_inline(&inode) || has_no_blocks(&inode))) {
+        unsigned char data[INODE_SIZE];
+        memset(data, 0, sizeof(data));
+        if (is_inline(&inode)) {
+            inode_read_inline(&inode, _inodeNum, data);
+            memset(data + oldSize, 0, sizeof(data) - oldSize);
+        }
+        memcpy(data + _offset, _buffer, _len);
+        write_inline(_inodeNum, data, size);
+        return _len;
+    }
+    // The data outgrew the inode; what it held becomes block 0
+    if (is_inline(&inode) && inline_to_blocks(_inodeNum) == False) {
+        return -1;
+    }
+    PointerPath path;
+    memset(path.offset, 0xFF, sizeof(path.offset));
+    unsigned char edge[BLOCK_SIZE];
+    // Bytes between the old end of the file and the write must read as zeros
+    if (_offset > oldSize && oldSize / BLOCK_SIZE < first) {
+        zero_file_tail(oldSize, &path);
+    }
+    // Only edge blocks that already hold data need to be read before they are written
+    Bool firstMapped = True, lastMapped = True;
+    if (inPlace == False) {
+        firstMapped = is_not_null(map_file_block(first, &path, True, Null));
+        lastMapped = is_not_null(map_file_block(last, &path, True, Null));
+        if (aloc_file_blocks(_inodeNum, first, last + 1) == False) {
+            return -1;
+        }
+    }
+    memset(path.offset, 0xFF, sizeof(path.offset));
+    const char *buffer = _buffer;
+    unsigned int runFirst = 0, runOffset = 0, runBlocks = 0;
+    for (unsigned int i = first; i <= last; i++) {
+        unsigned int diskOffset = block_map_lookup(_map, i, &path, True, Null);
+        unsigned int blockStart = i * BLOCK_SIZE;
+        if (blockStart >= _offset && end - blockStart >= BLOCK_SIZE) {
+            // whole blocks go straight from the caller's buffer, one write per run of blocks
+            // that are adjacent on disk
+            if (runBlocks > 0 && runOffset + runBlocks * BLOCK_SIZE == diskOffset) {
+                runBlocks++;
+                continue;
+            }
+            if (runBlocks > 0) {
+                disk_write(buffer + (runFirst * BLOCK_SIZE - _offset), runOffset,
+                           runBlocks * BLOCK_SIZE);
+            }
+            runFirst = i;
+            runOffset = diskOffset;
+            runBlocks = 1;
+            continue;
+        }
+        // an edge block is read, patched and written back
+        if ((i == first ? firstMapped : lastMapped) == True) {
+            disk_read(edge, diskOffset, BLOCK_SIZE);
+            if (oldSize < blockStart + BLOCK_SIZE) {
+                unsigned int keep = oldSize > blockStart ? oldSize - blockStart : 0;
+                memset(edge + keep, 0, BLOCK_SIZE - keep);
+            }
+        } else {
+            memset(edge, 0, BLOCK_SIZE);
+        }
+        unsigned int from = blockStart > _offset ? blockStart : _offset;
+        unsigned int to = end - blockStart < BLOCK_SIZE ? end : blockStart + BLOCK_SIZE;
+        memcpy(edge + (from - blockStart), buffer + (from - _offset), to - from);
+        disk_write(edge, diskOffset, BLOCK_SIZE);
+    }
+    if (runBlocks > 0) {
+        disk_write(buffer + (runFirst * BLOCK_SIZE - _offset), runOffset, runBlocks * BLOCK_SIZE);
+    }
+    if (size != oldSize) {
+        inode.fileSize = size;
+        inode.dataBlocks = size / BLOCK_SIZE;
+        inode_write(&inode, _inodeNum);
+    }
+    return _len;
+}
+
+long long int fs_append(unsigned int _inodeNum, const void *_buffer, unsigned int _len) {
+    if (!fs_open_file(_inodeNum, &inode)) {
+        return -1;
+    }
+    // a write at the end of the file touches the partial last block and the new tail only; the
+    // inode opened for its size is the one written, so it is not read again
+    return write_range(_inodeNum, _buffer, _len, inode.fileSize, Null);
+}
+
+Bool fs_truncate(unsigned int _inodeNum, unsigned int _size) {
+    if (!fs_open_file(_inodeNum, &inode) || inode.fileType == 2) {
+        return False;
+    }
+    block_map_invalidate(_inodeNum);
+    unsigned int oldSize = inode.fileSize;
+    if (is_inline(&inode) && _size <= inode_inline_capacity()) {
+        // the data stays in the inode; bytes past the new size are zeroed
+        unsigned char data[INODE_SIZE];
+        inode_read_inline(&inode, _inodeNum, data);
+        unsigned int keep = _size < oldSize ? _size : oldSize;
+        memset(data + keep, 0, sizeof(data) - keep);
+        return write_inline(_inodeNum, data, _size);
+    }
+    if (is_inline(&inode) && inline_to_blocks(_inodeNum) == False) {
+        return False;
+    }
+    if (_size >= oldSize) {
+        // growing leaves a hole; only the old last block needs its tail zeroed
+        PointerPath path;
+        memset(path.offset, 0xFF, sizeof(path.offset));
+        zero_file_tail(oldSize, &path);
+    } else if (is_extent(&inode)) {
+        Extent extents[MAX_EXTENTS];
+        unsigned int count = extent_load(extents);
+        extent_truncate(extents, &count, _size / BLOCK_SIZE + (_size % BLOCK_SIZE > 0 ? 1 : 0));
+        if (extent_store(_inodeNum, extents, count) == False) {
+            return False;
+        }
+    } else {
+        // free the blocks past the new end, and the pointer blocks that no longer point anywhere
+        unsigned int blocks = _size / BLOCK_SIZE + (_size % BLOCK_SIZE > 0 ? 1 : 0);
+        SectorBatch batch;
+        batch.count = 0;
+        for (unsigned int i = blocks; i < (unsigned int)INODE_DIRECT_PTRS; i++) {
+            if (is_not_null(inode.directPtr[i])) {
+                sector_batch_add(&batch, inode.directPtr[i]);
+                inode.directPtr[i] = (unsigned int)(-1);
+            }
+        }
+        unsigned int first = INODE_DIRECT_PTRS;
+        if (is_not_null(inode.sIndirect) && blocks < first + S_INDIRECT_BLOCKS &&
+            truncate_single_indirect_blocks(inode.sIndirect, blocks > first ? blocks - first : 0,
+                                            &batch) == True) {
+            inode.sIndirect = (unsigned int)(-1);
+        }
+        first += S_INDIRECT_BLOCKS;
+        if (is_not_null(inode.dIndirect) && blocks < first + D_INDIRECT_BLOCKS &&
+            truncate_double_indirect_blocks(inode.dIndirect, blocks > first ? blocks - first : 0,
+                                            &batch) == True) {
+            inode.dIndirect = (unsigned int)(-1);
+        }
+        first += D_INDIRECT_BLOCKS;
+        if (is_not_null(inode.tIndirect) &&
+            truncate_triple_indirect_blocks(inode.tIndirect, blocks > first ? blocks - first : 0,
+                                            &batch) == True) {
+            inode.tIndirect = (unsigned int)(-1);
+        }
+        sector_batch_flush(&batch);
+    }
+    inode.fileSize = _size;
+    inode.dataBlocks = _size / BLOCK_SIZE;
+    inode_write(&inode, _inodeNum);
+    return True;
+}
+
+int fs_open(unsigned int _inodeNum) {
+    for (int fd = 0; fd < MAX_OPEN_FILES; fd++) {
+        if (handles[fd].open == False) {
+            FileHandle *handle = &handles[fd];
+            if (!fs_open_file(_inodeNum, &handle->inode)) {
+                return -1;
+            }
+            handle->open = True;
+            handle->inodeNum = _inodeNum;
+            handle->stale = False;
+            handle->offset = 0;
+            handle->map.blocks = Null;
+            handle->map.count = 0;
+            memset(&handle->readahead, 0, sizeof(Readahead));
+            return fd;
+        }
+    }
+    return -1;
+}
+
+Bool fs_close(int _fd) {
+    if (_fd < 0 || _fd >= MAX_OPEN_FILES || handles[_fd].open == False) {
+        return False;
+    }
+    free(handles[_fd].map.blocks);
+    handles[_fd].map.blocks = Null;
+    handles[_fd].map.count = 0;
+    handles[_fd].open = False;
+    return True;
+}
+
+long long int fs_read(int _fd, void *_buffer, unsigned int _len) {
+    FileHandle *handle = handle_get(_fd);
+    if (handle == NULL) {
+        return -1;
+    }
+    long long int len = read_range(handle->inodeNum, _buffer, _len, handle->offset,
+                                   &handle->map, &handle->readahead);
+    if (len > 0) {
+        handle->offset += len;
+    }
+    return len;
+}
+
+long long int fs_write(int _fd, const void *_buffer, unsigned int _len) {
+    FileHandle *handle = handle_get(_fd);
+    if (handle == NULL) {
+        return -1;
+    }
+    BlockMap *map = inode.fileType != 2 && !is_inline(&inode)
+                        ? block_map_fill(&handle->map, handle->inodeNum)
+                        : Null;
+    long long int len = write_range(handle->inodeNum, _buffer, _len, handle->offset, map);
+    if (len < 0) {
+        handle->stale = True;
+        return len;
+    }
+    // `inode` holds what the write left on disk, new pointers and size included
+    handle->inode = inode;
+    handle->stale = False;
+    handle->offset += len;
+    return len;
+}
+
+long long int fs_seek(int _fd, long long int _offset, int _whence) {
+    if (_whence != SEEK_SET && _whence != SEEK_CUR && _whence != SEEK_END) {
+        return -1;
+    }
+    FileHandle *handle = handle_get(_fd);
+    if (handle == NULL) {
+        return -1;
+    }
+    long long int base = 0;
+    if (_whence == SEEK_CUR) {
+        base = (long long int)handle->offset;
+    } else if (_whence == SEEK_END) {
+        base = (long long int)handle->inode.fileSize;
+    }
+    if (base + _offset < 0 || base + _offset > (long long int)(unsigned int)(-1)) {
+        return -1;
+    }
+    handle->offset = base + _offset;
+    return handle->offset;
+}
+
+/**
+ * @brief Looks up an open handle and makes its file the open file (`inode`).
+ * The inode is copied from the handle; it is read again only if the file was changed since
+ * through a call other than the handle's own writes.
+ * @param[in] _fd Handle returned by `fs_open`.
+ * @return The handle, or Null if it is not open or its file no longer exists.
+ * @date 2026-10-18 First implementation.
+ */
+static FileHandle *handle_get(int _fd) {
+    if (_fd < 0 || _fd >= MAX_OPEN_FILES || handles[_fd].open == False) {
+        return Null;
+    }
+    FileHandle *handle = &handles[_fd];
+    if (handle->stale == True) {
+        if (!fs_open_file(handle->inodeNum, &handle->inode)) {
+            return Null;
+        }
+        handle->stale = False;
+    }
+    inode = handle->inode;
+    inode_map.id = handle->inodeNum;
+    return handle;
+}
+
+/**
+ * @brief Writes a file to an inode's first available indirect pointer location.
+ * Writes a file into the specified inode memory within the File Sector Manager.
+ * @param[in] _inodeNumF Inode number of the file to be written.
+ * @param[in] _file_name Pointer to the name of the file.
+ * @param[in] _allocate If true, allocate SSM blocks as needed.
+ * @return True if the file was written successfully, false otherwise.
+ * @date 2025-06-17 First implementation.
+ */
+static Bool create_file_in_avail_indirect_loc(unsigned int _inodeNumF, unsigned int *_file_name,
+                                              Bool _allocate) {
+    if (is_not_null(inode.sIndirect)) {
+        if (add_file_to_single_indirect(_inodeNumF, _file_name, inode.sIndirect, _allocate))
+            return True;
+    }
+    if (is_not_null(inode.dIndirect)) {
+        if (add_file_to_double_indirect(_inodeNumF, _file_name, inode.dIndirect, _allocate))
+            return True;
+    }
+    if (is_not_null(inode.tIndirect)) {
+        if (add_file_to_triple_indirect(_inodeNumF, _file_name, inode.tIndirect, _allocate))
+            return True;
+    }
+    return False;
+}
+
+/**
+ * @brief Writes a file to an inode's unset indirect pointer location.
+ * Writes a file into the specified inode memory within the File Sector Manager after setting it.
+ * @param[in] _type the indirect PointerType (SINGLE, DOUBLE, TRIPLE).
+ * @param[in] _inodeNumF Inode number of the file to be written.
+ * @param[in] _file_name Pointer to the name of the file.
+ * @param[in] _inodeNumD Inode number of the directory to store the file in.
+ * @param[in,out] diskOffset Offset within the disk.
+ * @param[in] _file_buffer Pointer to the file data buffer.
+ * @return True if the file was written successfully, false otherwise.
+ * @date 2025-06-17 First implementation.
+ */
+static Bool create_file_in_unavail_indirect_loc(PointerType _type, unsigned int _inodeNumF,
+                                                unsigned int *_file_name, unsigned int _inodeNumD,
+                                                unsigned int *diskOffset,
+                                                unsigned int *file_buffer) {
+    typedef Bool (*WriteFunc)(unsigned int, unsigned int *, unsigned int, Bool);
+
+    unsigned int *indirect = NULL;
+    WriteFunc write_func;
+
+    if (_type == SINGLE) {
+        indirect = &inode.sIndirect;
+        write_func = add_file_to_single_indirect;
+    } else if (_type == DOUBLE) {
+        indirect = &inode.dIndirect;
+        write_func = add_file_to_double_indirect;
+    } else {
+        indirect = &inode.tIndirect;
+        write_func = add_file_to_triple_indirect;
+    }
+
+    // Check if memory has been allocated for this indirect memory
+    if (is_null(*indirect)) {
+        // Allocate memory for the inode's indirect pointer using SSM and update the inode
+        *indirect = ssm_allocate_sectors(1);
+        if (is_null(*indirect)) {
+            return False;
+        } else {
+            memset(file_buffer, 0xFF, BLOCK_SIZE);
+            *diskOffset = *indirect;
+            disk_write(file_buffer, *diskOffset, BLOCK_SIZE);
+            inode_write(&inode, _inodeNumD);
+        }
+        // Write data to this indirect memory location on disk
+        if (write_func(_inodeNumF, _file_name, *diskOffset, True)) {
+            return True;
+        }
+    }
+    return False;
+}
+
+/**
+ * @brief Writes a file to an inode's set direct pointer location.
+ * Writes a file into the specified inode memory within the File Sector Manager after setting it.
+ * @param[in] _inodeNumF Inode number of the file to be written.
+ * @param[in] _file_name Pointer to the name of the file.
+ * @param[in,out] diskOffset Offset within the disk.
+ * @param[in] _disk_buffer Pointer to the disk io buffer.
+ * @return True if the file was written successfully, false otherwise.
+ * @date 2025-06-17 First implementation.
+ */
+static Bool create_file_in_avail_direct_loc(unsigned int _inodeNumF, unsigned int *_file_name,
+                                            unsigned int *diskOffset, unsigned int *disk_buffer) {
+    // Read file's direct pointers from disk
+    unsigned int j;
+    for (unsigned int i = 0; i < INODE_DIRECT_PTRS; i++) {
+        if (is_not_null(inode.directPtr[i])) {
+            *diskOffset = inode.directPtr[i];
+            disk_read(disk_buffer, *diskOffset, BLOCK_SIZE);
+            for (j = 0; j < BLOCK_SIZE / 4; j += 4) {
+                if (disk_buffer[j + 3] == 0) {
+                    disk_buffer[j + 3] = 1;
+                    disk_buffer[j] = _file_name[0];
+                    disk_buffer[j + 1] = _file_name[1];
+                    disk_buffer[j + 2] = _inodeNumF;
+                    dir_entry_offset = *diskOffset + j * 4;
+                    inode.linkCount += 1;
+                    disk_write(disk_buffer, *diskOffset, BLOCK_SIZE);
+                    Bool status = fs_close_file();
+                    if (status == False) printf("Error closing file\n");
+                    return True;
+                }  // end if (disk_buffer[j+3] == 0)
+            }  // end or (j = 0; j < BLOCK_SIZE/4; j += 4)
+        }
+    }  // end for (i = 0; i < INODE_DIRECT_PTRS; i++)
+    return False;
+}
+
+/**
+ * @brief Writes a file to an inode's set direct pointer location.
+ * Writes a file into the specified inode memory within the File Sector Manager after setting it.
+ * @param[in] _inodeNumF Inode number of the file to be written.
+ * @param[in] _inodeNumD Inode number of the target directory.
+ * @param[in] _file_name Pointer to the name of the file.
+ * @param[in,out] diskOffset Offset within the disk.
+ * @param[in] _disk_buffer Pointer to the disk io buffer.
+ * @return True if the file was written successfully, false otherwise.
+ * @date 2025-06-17 First implementation.
+ */
+static Bool create_file_in_unavail_direct_loc(unsigned int _inodeNumF, unsigned int _inodeNumD,
+                                              unsigned int *_file_name, unsigned int *diskOffset,
+                                              unsigned int *disk_buffer) {
+    unsigned int j;
+    for (unsigned int i = 0; i < INODE_DIRECT_PTRS; i++) {
+        if (is_null(inode.directPtr[i])) {
+            // Get sectors for direct pointers
+            *diskOffset = ssm_allocate_sectors(1);
+            if (is_null(*diskOffset)) {
+                // If sectors can't be retrieved, return false
+                return False;
+            } else {
+                inode.directPtr[i] = *diskOffset;
+                // Clear disk_buffer
+                for (j = 0; j < BLOCK_SIZE / 4; j++) {
+                    disk_buffer[j] = 0;
+                }  // end for (j = 0; j < BLOCK_SIZE/4; j++)
+                disk_buffer[3] = 1;
+                disk_buffer[0] = _file_name[0];
+                disk_buffer[1] = _file_name[1];
+                disk_buffer[2] = _inodeNumF;
+                dir_entry_offset = *diskOffset;
+                dir_entry_new_block = True;
+                inode.linkCount += 1;
+                inode.fileSize += BLOCK_SIZE;
+                inode.dataBlocks = inode.fileSize / BLOCK_SIZE;
+
+                disk_write(disk_buffer, *diskOffset, BLOCK_SIZE);
+                // Write file to disk
+                inode_write(&inode, _inodeNumD);
+                Bool status = fs_close_file();
+                if (status == False) printf("Error closing file\n");
+                return True;
+            }
+        }
+    }  // end for (i = 0; i < INODE_DIRECT_PTRS; i++)
+    return False;
+}
+
+/**
+ * @brief Stores the data of a small file inline in its inode.
+ * @param[in] _inodeNum Inode number of the open file (`inode`).
+ * @param[in] _buffer Data to store.
+ * @param[in] _size Number of bytes, at most `inode_inline_capacity()`.
+ * @return True if the data was stored.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool write_inline(unsigned int _inodeNum, const void *_buffer, unsigned int _size) {
+    unsigned char data[INODE_SIZE];
+    memset(data, 0, sizeof(data));
+    memcpy(data, _buffer, _size);
+    inode.status |= INODE_INLINE;
+    inode.fileSize = _size;
+    inode.dataBlocks = 0;
+    inode_write_inline(&inode, _inodeNum, data);
+    return True;
+}
+
+/**
+ * @brief Adds a file to the entries an inline directory keeps in its inode.
+ * @param[in] _inodeNumF Inode number of the file to be added.
+ * @param[in] _name Pointer to the name of the file.
+ * @param[in] _inodeNumD Inode number of the open directory (`inode`).
+ * @return True if the entry was added, false if the inode has no free entry.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool add_inline_entry(unsigned int _inodeNumF, unsigned int *_name,
+                             unsigned int _inodeNumD) {
+    unsigned int entries[INODE_SIZE / 4];
+    inode_read_inline(&inode, _inodeNumD, entries);
+    for (unsigned int j = 0; j < inode.fileSize / 4; j += 4) {
+        if (entries[j + 3] == 0) {
+            entries[j + 3] = 1;
+            entries[j] = _name[0];
+            entries[j + 1] = _name[1];
+            entries[j + 2] = _inodeNumF;
+            inode.linkCount += 1;
+            inode_write_inline(&inode, _inodeNumD, entries);
+            Bool status = fs_close_file();
+            if (status == False) printf("Error closing file\n");
+            return True;
+        }  // end if (entries[j+3] == 0)
+    }  // end for (j = 0; j < inode.fileSize/4; j += 4)
+    return False;
+}
+
+/**
+ * @brief Moves the entries of an inline directory into its first data block.
+ * @param[in] _inodeNumD Inode number of the open directory (`inode`).
+ * @return True if the directory now uses a data block, false if no sector was available.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool expand_inline_dir(unsigned int _inodeNumD) {
+    unsigned int entries[INODE_SIZE / 4];
+    unsigned int buffer[BLOCK_SIZE / 4];
+    unsigned int diskOffset = ssm_allocate_sectors(1);
+    if (is_null(diskOffset)) {
+        return False;
+    }
+    inode_read_inline(&inode, _inodeNumD, entries);
+    memset(buffer, 0, BLOCK_SIZE);
+    memcpy(buffer, entries, inode.fileSize);
+    disk_write(buffer, diskOffset, BLOCK_SIZE);
+    inode.status &= ~INODE_INLINE;
+    if (inode_init_ptrs(&inode) == FAILURE) {
+        // the directory stays inline and the new block goes back
+        inode.status |= INODE_INLINE;
+        ssm_deallocate_sectors(diskOffset / BLOCK_SIZE);
+        return False;
+    }
+    inode.directPtr[0] = diskOffset;
+    inode.fileSize = BLOCK_SIZE;
+    inode.dataBlocks = 1;
+    inode_write(&inode, _inodeNumD);
+    return True;
+}
+
+/**
+ * @brief Write a file.
+ * Inserts a file into the specified directory within the File Sector Manager.
+ * @param[in] _inodeNumF Inode number of the file to be added.
+ * @param[in] _name Pointer to the name of the file.
+ * @param[in] _inodeNumParentDir Inode number of the target directory.
+ * @return True if the file was added successfully, false otherwise.
+ * @date 2010-04-01 First implementation.
+ */
+static Bool create_file(unsigned int _inodeNumF, unsigned int *_name,
+                        unsigned int _inodeNumParentDir) {
+    dir_entry_offset = (unsigned int)(-1);
+    dir_entry_new_block = False;
+    if (place_dir_entry(_inodeNumF, _name, _inodeNumParentDir) == False) {
+        return False;
+    }
+    dentry_store(_inodeNumParentDir, _name, _inodeNumF);
+    if (is_not_null(dir_entry_offset)) {
+        dir_slots_placed(_inodeNumParentDir, dir_entry_offset, dir_entry_new_block);
+    }
+    // An entry written to a block goes into the directory's name index, built on first use
+    if (is_not_null(dir_entry_offset) && fs_open_file(_inodeNumParentDir, &inode)) {
+        if (is_dir_indexed(&inode)) {
+            dir_index_insert(_name, dir_entry_offset);
+        } else if (fsm->dirIndex == True) {
+            dir_index_build();
+        }
+        fs_close_file();
+    }
+    return True;
+}
+
+/**
+ * @brief Writes an entry for a file into the first free slot of a directory.
+ * The directory's inline entries are tried first, then its direct blocks, then its indirect
+ * blocks, allocating a block where none has room. `dir_entry_offset` is set to the disk offset
+ * of an entry written to a block.
+ * @param[in] _inodeNumF Inode number of the file to be added.
+ * @param[in] _name Pointer to the name of the file.
+ * @param[in] _inodeNumParentDir Inode number of the target directory.
+ * @return True if the entry was written, false otherwise.
+ * @date 2010-04-01 First implementation.
+ */
+static Bool place_dir_entry(unsigned int _inodeNumF, unsigned int *_name,
+                            unsigned int _inodeNumParentDir) {
+    unsigned int diskOffset = 0;
+    unsigned int buffer[BLOCK_SIZE / 4];
+    unsigned int buffer2[BLOCK_SIZE / 4];
+
+    // Open the parent directory
+    if (!fs_open_file(_inodeNumParentDir, &inode)) {
+        return False;
+    }
+    block_map_invalidate(_inodeNumParentDir);
+    // Create file within the parent directory
+
+    // An inline directory takes the entry while it has room, then moves to a data block
+    if (is_inline(&inode)) {
+        if (add_inline_entry(_inodeNumF, _name, _inodeNumParentDir)) {
+            return True;
+        }
+        if (!expand_inline_dir(_inodeNumParentDir)) {
+            return False;
+        }
+    }
+
+    // A block known to have a free slot takes the entry without a scan; once every block is
+    // known to be full a new one is added straight away
+    DirSlots *slots = dir_slots_get(_inodeNumParentDir);
+    if (is_not_null(slots->block)) {
+        if (add_file_to_dir_block(_inodeNumF, _name, slots->block, buffer)) {
+            return True;
+        }
+        slots->block = (unsigned int)(-1);
+    }
+    if (slots->othersFull == True &&
+        create_file_in_unavail_direct_loc(_inodeNumF, _inodeNumParentDir, _name, &diskOffset,
+                                          buffer2)) {
+        return True;
+    }
+
+    // Read file's direct pointers from disk
+    if (create_file_in_avail_direct_loc(_inodeNumF, _name, &diskOffset, buffer)) {
+        return True;
+    }
+
+    // Try to write to the first available indirect memory
+    if (create_file_in_avail_indirect_loc(_inodeNumF, _name, False)) {
+        return True;
+    }
+
+    // If can not find an open Direct pointer, allocate a new one at lowest possible level
+    if (create_file_in_unavail_direct_loc(_inodeNumF, _inodeNumParentDir, _name, &diskOffset,
+                                          buffer2)) {
+        return True;
+    }
+
+    // Try to write to the first available indirect memory location
+    // @todo revist the need for this call
+    if (create_file_in_avail_indirect_loc(_inodeNumF, _name, False)) {
+        return True;
+    }
+
+    // If can not find an open Single, Double or Triple Indirect pointer,
+    // allocate a new one at lowest possible level
+    if (create_file_in_avail_indirect_loc(_inodeNumF, _name, True)) {
+        return True;
+    }
+
+    if (create_file_in_unavail_indirect_loc(SINGLE, _inodeNumF, _name, _inodeNumParentDir,
+                                            &diskOffset, buffer2)) {
+        return True;
+    }
+
+    if (create_file_in_unavail_indirect_loc(DOUBLE, _inodeNumF, _name, _inodeNumParentDir,
+                                            &diskOffset, buffer2)) {
+        return True;
+    }
+    if (create_file_in_unavail_indirect_loc(TRIPLE, _inodeNumF, _name, _inodeNumParentDir,
+                                            &diskOffset, buffer2)) {
+        return True;
+    }
+    return False;
+}
+
+/**
+ * @brief Adds a file to a triple indirect pointer.
+ * Inserts a file into the structure at the specified triple indirect offset,
+ * optionally allocating necessary blocks.
+ * @param[in] _inodeNumF Inode number of the file to be added.
+ * @param[in] _name Pointer to the name of the file.
+ * @param[in] _tIndirectOffset Offset within the triple indirect block.
+ * @param[in] _allocate If true, allocate blocks as needed.
+ * @return True if the file was added successfully, false otherwise.
+ * @date 2010-04-01 First implementation.
+ */
+static Bool add_file_to_triple_indirect(unsigned int _inodeNumF, unsigned int *_name,
+                                        unsigned int _tIndirectOffset, Bool _allocate) {
+    unsigned int indirectBlock[BLOCK_SIZE / 4];
+    unsigned int buffer[BLOCK_SIZE / 4];
+    unsigned int diskOffset;
+    Bool success;
+    diskOffset = _tIndirectOffset;
+    disk_read(indirectBlock, diskOffset, BLOCK_SIZE);
+
+    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
+        if (is_not_null(indirectBlock[i])) {
+            diskOffset = indirectBlock[i];
+            success = add_file_to_double_indirect(_inodeNumF, _name, diskOffset, _allocate);
+            if (success == True) {
+                return True;
+            }  // end if (success == True)
+        }
+    }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
+    // Allocate more sectors to write to
+    if (_allocate == True) {
+        for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
+            if (is_null(indirectBlock[i])) {
+                indirectBlock[i] = ssm_allocate_sectors(1);
+                if (is_null(indirectBlock[i])) {
+                    return False;
+                } else {
+                    disk_write(indirectBlock, _tIndirectOffset, BLOCK_SIZE);
+                    memset(buffer, 0xFF, BLOCK_SIZE);
+                    disk_write(buffer, indirectBlock[i], BLOCK_SIZE);
+                }
+                diskOffset = indirectBlock[i];
+                success = add_file_to_double_indirect(_inodeNumF, _name, diskOffset, _allocate);
+                if (success == True) {
+                    return True;
+                }  // end if(success == True)
+            }  // end else
+        }  // for (i = 0; i < BLOCK_SIZE/4; i++)
+    }  // end if (_allocate == True)
+    return False;
+}
+
+/**
+ * @brief Adds a file to a double indirect pointer.
+ * Inserts a file into the structure at the specified double indirect offset,
+ * optionally allocating space as needed.
+ * @param[in] _inodeNumF Inode number of the file to be added.
+ * @param[in] _name Pointer to the name of the file.
+ * @param[in] _dIndirectOffset Offset within the double indirect block.
+ * @param[in] _allocate If true, allocate additional space as needed.
+ * @return True if the file was added successfully, false otherwise.
+ * @date 2010-04-01 First implementation.
+ */
+static Bool add_file_to_double_indirect(unsigned int _inodeNumF, unsigned int *_name,
+                                        unsigned int _dIndirectOffset, Bool _allocate) {
+    unsigned int indirectBlock[BLOCK_SIZE / 4];
+    unsigned int buffer[BLOCK_SIZE / 4];
+    unsigned int diskOffset;
+    Bool success;
+    diskOffset = _dIndirectOffset;
+    disk_read(indirectBlock, diskOffset, BLOCK_SIZE);
+
+    // Add file to a double indirect pointer
+    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
+        if (is_not_null(indirectBlock[i])) {
+            diskOffset = indirectBlock[i];
+            success = add_file_to_single_indirect(_inodeNumF, _name, diskOffset, _allocate);
+            if (success == True) {
+                return True;
+            }  // end if (success == True)
+        }
+    }  // for (i = 0; i < BLOCK_SIZE/4; i++)
+    if (_allocate == True) {
+        for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
+            if (is_null(indirectBlock[i])) {
+                indirectBlock[i] = ssm_allocate_sectors(1);
+                if (is_null(indirectBlock[i])) {
+                    return False;
+                } else {
+                    disk_write(indirectBlock, _dIndirectOffset, BLOCK_SIZE);
+                    memset(buffer, 0xFF, BLOCK_SIZE);
+                    disk_write(buffer, indirectBlock[i], BLOCK_SIZE);
+                }
+                diskOffset = indirectBlock[i];
+                success = add_file_to_single_indirect(_inodeNumF, _name, diskOffset, _allocate);
+                if (success == True) {
+                    return True;
+                }  // end if (success == True)
+            }
+        }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
+    }  // end if (_allocate == True)
+    return False;
+}
+
+/**
+ * @brief Adds a file to a single indirect pointer without allocation.
+ * Inserts a file at the specified single indirect offset, optionally allocating space if required.
+ * @param[in] _indirectBlock an indirect block buffer
+ * @param[in,out] buffer disk buffer
+ * @param[in] _inodeNumF Inode number of the file to be added.
+ * @param[in] _name Pointer to the name of the file.
+ * @param[in,out] diskOffset Offset within the single indirect block.
+ * @return True if the file was added successfully, false otherwise.
+ * @date 2010-04-01 First implementation.
+ */
+static Bool add_file_to_single_indirect_no_alloc(unsigned int *buffer, unsigned int *indirectBlock,
+                                                 unsigned int _inodeNumF, unsigned int *_name,
+                                                 unsigned int *diskOffset) {
+    Bool status = False;
+    unsigned int j = 0;
+    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
+        if (is_not_null(indirectBlock[i])) {
+            *diskOffset = indirectBlock[i];
+            disk_read(buffer, *diskOffset, BLOCK_SIZE);
+            for (j = 0; j < BLOCK_SIZE / 4; j += 4) {
+                if (buffer[j + 3] == 0) {
+                    buffer[j + 3] = 1;
+                    buffer[j] = _name[0];
+                    buffer[j + 1] = _name[1];
+                    buffer[j + 2] = _inodeNumF;
+                    dir_entry_offset = *diskOffset + j * 4;
+                    inode.linkCount += 1;
+                    disk_write(buffer, *diskOffset, BLOCK_SIZE);
+                    status = fs_close_file();
+                    if (status == False) printf("Error closing file\n");
+                    return True;
+                }  // end if (buffer[j+3] == 0)
+            }  // for (j = 0; j < BLOCK_SIZE/4; j += 4)
+        }
+    }  // for (i = 0; i < BLOCK_SIZE/4; i++)
+    return status;
+}
+
+/**
+ * @brief Adds a file to a single indirect pointer.
+ * Inserts a file at the specified single indirect offset, optionally allocating space if required.
+ * @param[in] _inodeNumF Inode number of the file to be added.
+ * @param[in] _name Pointer to the name of the file.
+ * @param[in] _sIndirectOffset Offset within the single indirect block.
+ * @param[in] _allocate If true, allocate space as needed.
+ * @return True if the file was added successfully, false otherwise.
+ * @date 2010-04-01 First implementation.
+ */
+static Bool add_file_to_single_indirect(unsigned int _inodeNumF, unsigned int *_name,
+                                        unsigned int _sIndirectOffset, Bool _allocate) {
+    unsigned int indirectBlock[BLOCK_SIZE / 4];
+    unsigned int diskOffset;
+    unsigned int buffer[BLOCK_SIZE / 4];
+    diskOffset = _sIndirectOffset;  // inode.sIndirect;
+    Bool status;
+    // Read indirect block
+    disk_read(indirectBlock, diskOffset, BLOCK_SIZE);
+
+    if (_allocate == False) {
+        status = add_file_to_single_indirect_no_alloc(buffer, indirectBlock, _inodeNumF, _name,
+                                                      &diskOffset);
+    }  // if (_allocate == False)
+    else {
+        // Allocate space then write
+        for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
+            if (is_null(indirectBlock[i])) {
+                indirectBlock[i] = ssm_allocate_sectors(1);
+                if (is_null(indirectBlock[i])) {
+                    return False;
+                } else {
+                    disk_write(indirectBlock, diskOffset, BLOCK_SIZE);
+                    memset(buffer, 0, BLOCK_SIZE);
+
+                    buffer[3] = 1;
+                    buffer[0] = _name[0];
+                    buffer[1] = _name[1];
+                    buffer[2] = _inodeNumF;
+                    dir_entry_offset = indirectBlock[i];
+                    dir_entry_new_block = True;
+                    inode.linkCount += 1;
+                    inode.fileSize += BLOCK_SIZE;
+                    inode.dataBlocks = inode.fileSize / BLOCK_SIZE;
+                    disk_write(buffer, indirectBlock[i], BLOCK_SIZE);
+                    status = fs_close_file();
+                    if (status == False) printf("Error closing file\n");
+                    return True;
+                }
+            }
+        }  // for (i = 0; i < BLOCK_SIZE/4; i++)
+    }  // end else
+    return False;
+}
+
+/**
+ * @brief Removes a file from a directory indirect pointers.
+ * Removes the file identified by `_inodeNumF`.
+ * @param[in] _inodeNumF Inode number of the file to be removed.
+ * @param[in] _inodeNumD Inode number of the file's parent directory
+ * @return True if the file was successfully removed, false if the file could not be accessed.
+ * @date 2010-04-01 First implementation.
+ */
+static Bool remove_file_from_dir_indirect_pointers(unsigned int _inodeNumF,
+                                                   unsigned int _inodeNumD) {
+    // if the directory has files in it's sindirect pointer area, remove them
+    Bool success = False;
+    if (is_not_null(inode.sIndirect)) {
+        success = remove_file_from_single_indirect(_inodeNumF, _inodeNumD, (unsigned int)(-1),
+                                                   inode.sIndirect);
+        if (success == True) {
+            return True;
+        }  // end if (success == True)
+    }
+    // if the directory has files in it's dindirect pointer area, remove them
+    if (is_not_null(inode.dIndirect)) {
+        success = remove_file_from_double_indirect(_inodeNumF, _inodeNumD, (unsigned int)(-1),
+                                                   inode.dIndirect);
+        if (success == True) {
+            return True;
+        }  // end if (success == True)
+    }
+    // if the directory has files in it's tindirect pointer area, remove them
+    if (is_not_null(inode.tIndirect)) {
+        success = remove_file_from_triple_indirect(_inodeNumF, _inodeNumD, inode.tIndirect);
+        if (success == True) {
+            return True;
+        }  // end if (success == True)
+    }
+    return success;
+}
+
+Bool fs_remove_file_from_dir(unsigned int _inodeNumF, unsigned int _inodeNumD) {
+    unsigned int j;
+    // open the parent directory inode
+    if (!fs_open_file(_inodeNumD, &inode)) return False;
+    block_map_invalidate(_inodeNumD);
+    dentry_forget_inode(_inodeNumF);
+    if (inode.fileType == 2 && is_inline(&inode)) {
+        // clear the entry in the inode
+        unsigned int entries[INODE_SIZE / 4];
+        inode_read_inline(&inode, _inodeNumD, entries);
+        for (j = 0; j < inode.fileSize / 4; j += 4) {
+            if (entries[j + 3] == 1 && entries[j + 2] == _inodeNumF) {
+                memset(&entries[j], 0, 4 * sizeof(unsigned int));
+                inode.linkCount -= 1;
+                inode_write_inline(&inode, _inodeNumD, entries);
+                return True;
+            }
+        }
+        return False;
+    }
+    if (inode.fileType != 2) {  // type 2 is directory
+        return False;
+    }
+    // Only the block the file's back-pointer names is read, unless the entry is not there
+    Bool removed = False;
+    dir_entry_hint = dir_backref_find(_inodeNumF, _inodeNumD);
+    if (is_not_null(dir_entry_hint)) {
+        removed = remove_file_from_dir_blocks(_inodeNumF, _inodeNumD);
+    }
+    dir_entry_hint = (unsigned int)(-1);
+    if (removed == False) {
+        removed = remove_file_from_dir_blocks(_inodeNumF, _inodeNumD);
+    }
+    return removed;
+}
+
+/**
+ * @brief Removes a file's entry from the entry blocks of the open directory (`inode`).
+ * The direct blocks are searched first, then the indirect ones; only the block of
+ * `dir_entry_hint` is searched when it is set. A block left without entries is freed.
+ * @param[in] _inodeNumF Inode number of the file to be removed.
+ * @param[in] _inodeNumD Inode number of the directory.
+ * @return True if the entry was removed, false if it was not found.
+ * @date 2010-04-01 First implementation.
+ */
+static Bool remove_file_from_dir_blocks(unsigned int _inodeNumF, unsigned int _inodeNumD) {
+    unsigned int j, k, diskOffset, sectorNum;
+    unsigned int buffer[BLOCK_SIZE / 4];
+    for (unsigned int i = 0; i < INODE_DIRECT_PTRS; i++) {
+        if (is_not_null(inode.directPtr[i]) && dir_block_hinted(inode.directPtr[i])) {
+            diskOffset = inode.directPtr[i];
+            disk_read(buffer, diskOffset, BLOCK_SIZE);
+            // clear all 4 bytes on each loop
+            for (j = 0; j < BLOCK_SIZE / 4; j += 4) {
+                if (buffer[j + 3] == 1 && buffer[j + 2] == _inodeNumF) {
+                    dir_index_delete(&buffer[j], diskOffset + j * 4);
+                    memset(&buffer[j], 0, 4 * sizeof(unsigned int));
+                    inode.linkCount -= 1;
+                    dir_slots_freed(_inodeNumD, diskOffset);
+                    if (inode.linkCount == 0) {
+                        // if there is nothing in the directory, set size to 0
+                        inode.fileSize = 0;
+                        dir_index_drop();
+                        dir_slots_forget(_inodeNumD);
+                        if (inode_init_ptrs(&inode) == FAILURE) {
+                            // @todo do something here
+                        }
+                    }
+                    disk_write(buffer, diskOffset, BLOCK_SIZE);
+                    for (k = 0; k < BLOCK_SIZE / 4; k += 4) {
+                        if (buffer[k + 3] == 1) {
+                            break;
+                        }
+                    }
+                    if (k == BLOCK_SIZE / 4) {
+                        dir_slots_dropped(_inodeNumD, inode.directPtr[i]);
+                        sectorNum = inode.directPtr[i] / BLOCK_SIZE;
+                        ssm_deallocate_sectors(sectorNum);
+                        inode.directPtr[i] = (unsigned int)(-1);
+                        inode.dataBlocks -= 1;
+                        inode_write(&inode, _inodeNumD);
+                    }
+                    return True;
+                }
+            }
+        }
+    }
+    return remove_file_from_dir_indirect_pointers(_inodeNumF, _inodeNumD);
+}
+
+/**
+ * @brief Removes a file from a triple indirect pointer.
+ * Removes the file identified by `_inodeNumF` from the triple indirect block at the specified
+ * offset. Internally calls `rmFileFrom_D_Indirect` to complete the operation.
+ * @param[in] _inodeNumF Inode number of the file to be removed.
+ * @param[in] _inodeNumD Inode number of the file's parent.
+ * @param[in] _tIndirectOffset Offset to the triple indirect block containing the file.
+ * @return True if the file was successfully removed, false if the file could not be accessed.
+ * @date 2010-04-01 First implementation.
+ */
+static Bool remove_file_from_triple_indirect(unsigned int _inodeNumF, unsigned int _inodeNumD,
+                                             unsigned int _tIndirectOffset) {
+    unsigned int indirectBlock[BLOCK_SIZE / 4];
+    unsigned int diskOffset, sectorNum;
+    Bool success;
+    diskOffset = _tIndirectOffset;
+    disk_read(indirectBlock, diskOffset, BLOCK_SIZE);
+    unsigned int k;
+    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
+        if (is_not_null(indirectBlock[i])) {
+            diskOffset = indirectBlock[i];
+            success = remove_file_from_double_indirect(_inodeNumF, _inodeNumD, _tIndirectOffset,
+                                                       diskOffset);
+            if (success == True) {
+                diskOffset = _tIndirectOffset;
+                disk_read(indirectBlock, diskOffset, BLOCK_SIZE);
+                for (k = 0; k < BLOCK_SIZE / 4; k++) {
+                    if (is_not_null(indirectBlock[k])) break;
+                }  // end for (k = 0; k < BLOCK_SIZE/4; k++)
+                if (k == BLOCK_SIZE / 4) {
+                    sectorNum = _tIndirectOffset / BLOCK_SIZE;
+                    ssm_deallocate_sectors(sectorNum);
+                    inode.tIndirect = (unsigned int)(-1);
+                    inode_write(&inode, _inodeNumD);
+                }  // end if (k == BLOCK_SIZE/4)
+                return True;
+            }  // if (success == True)
+        }
+    }  // for (i = 0; i < BLOCK_SIZE/4; i++)
+    return False;
+}
+
+/**
+ * @brief Removes a file from a double indirect pointer.
+ * Removes the file identified by `_inodeNumF` from the double indirect block at the specified
+ * offset. Typically called by higher-level triple indirect removal logic.
+ * @param[in] _inodeNumF Inode number of the file to be removed.
+ * @param[in] _inodeNumD Inode number of the file's parent.
+ * @param[in] _tIndirectOffset Offset to the parent triple indirect block.
+ * @param[in] _dIndirectOffset Offset to the double indirect block containing the file.
+ * @return True if the file was successfully removed, false if the file could not be accessed.
+ * @date 2010-04-01 First implementation.
+ */
+static Bool remove_file_from_double_indirect(unsigned int _inodeNumF, unsigned int _inodeNumD,
+                                             unsigned int _tIndirectOffset,
+                                             unsigned int _dIndirectOffset) {
+    unsigned int indirectBlock[BLOCK_SIZE / 4];
+    unsigned int diskOffset, sectorNum;
+    Bool success;
+    // load next pointer
+    diskOffset = _dIndirectOffset;
+    disk_read(indirectBlock, diskOffset, BLOCK_SIZE);
+    unsigned int k;
+    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
+        if (is_not_null(indirectBlock[i])) {
+            diskOffset = indirectBlock[i];
+            success = remove_file_from_single_indirect(_inodeNumF, _inodeNumD, _dIndirectOffset,
+                                                       diskOffset);
+            if (success == True) {
+                diskOffset = _dIndirectOffset;
+                disk_read(indirectBlock, diskOffset, BLOCK_SIZE);
+                for (k = 0; k < BLOCK_SIZE / 4; k++) {
+                    if (is_not_null(indirectBlock[k])) break;
+                }  // end for (k = 0; k < BLOCK_SIZE/4; k++)
+                if (k == BLOCK_SIZE / 4) {
+                    sectorNum = _dIndirectOffset / BLOCK_SIZE;
+                    ssm_deallocate_sectors(sectorNum);
+                    if (is_not_null(_tIndirectOffset)) {
+                        diskOffset = _tIndirectOffset;
+                        disk_read(indirectBlock, diskOffset, BLOCK_SIZE);
+                        for (k = 0; k < BLOCK_SIZE / 4; k++) {
+                            if (indirectBlock[k] == _dIndirectOffset) {
+                                indirectBlock[k] = (unsigned int)(-1);
+                                break;
+                            }  // end if (indirectBlock[k] == _dIndirectOffset)
+                        }  // end for (k = 0; k < BLOCK_SIZE/4; k++)
+                        disk_write(indirectBlock, diskOffset, BLOCK_SIZE);
+                    } else {
+                        inode.dIndirect = (unsigned int)(-1);
+                        inode_write(&inode, _inodeNumD);
+                    }  // end else
+                }  // if (k == BLOCK_SIZE/4)
+                return True;
+            }  // end if (success == True)
+        }
+    }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
+    return False;
+}
+
+/**
+ * @brief Removes a file from a single indirect pointer.
+ * Removes the file identified by `_inodeNumF` from the single indirect block located
+ * via the specified double and single indirect offsets.
+ * @param[in] _inodeNumF Inode number of the file to be removed.
+ * @param[in] _inodeNumD Inode number of the file's parent.
+ * @param[in] _dIndirectOffset Offset to the parent double indirect block.
+ * @param[in] _sIndirectOffset Offset to the single indirect block containing the file.
+ * @return True if the file was successfully removed, false if the file could not be accessed.
+ * @date 2010-04-01 First implementation.
+ */
+static Bool remove_file_from_single_indirect(unsigned int _inodeNumF, unsigned int _inodeNumD,
+                                             unsigned int _dIndirectOffset,
+                                             unsigned int _sIndirectOffset) {
+    unsigned int indirectBlock[BLOCK_SIZE / 4];
+    unsigned int diskOffset, sectorNum, j, k;
+    unsigned int buffer[BLOCK_SIZE / 4];
+    diskOffset = _sIndirectOffset;
+    disk_read(indirectBlock, diskOffset, BLOCK_SIZE);
+    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
+        if (is_not_null(indirectBlock[i]) && dir_block_hinted(indirectBlock[i])) {
+            diskOffset = indirectBlock[i];
+            disk_read(buffer, diskOffset, BLOCK_SIZE);
+            for (j = 0; j < BLOCK_SIZE / 4; j += 4) {
+                if (buffer[j + 3] == 1 && buffer[j + 2] == _inodeNumF) {
+                    dir_index_delete(&buffer[j], diskOffset + j * 4);
+                    memset(&buffer[j], 0, 4 * sizeof(unsigned int));
+                    inode.linkCount -= 1;
+                    disk_write(buffer, diskOffset, BLOCK_SIZE);
+                    dir_slots_freed(_inodeNumD, diskOffset);
+                    for (k = 0; k < BLOCK_SIZE / 4; k += 4) {
+                        if (buffer[k + 3] == 1) break;
+                    }
+                    if (k == BLOCK_SIZE / 4) {
+                        dir_slots_dropped(_inodeNumD, indirectBlock[i]);
+                        sectorNum = indirectBlock[i] / BLOCK_SIZE;
+                        ssm_deallocate_sectors(sectorNum);
+                        inode.dataBlocks -= 1;
+                        inode_write(&inode, _inodeNumD);
+                        indirectBlock[i] = (unsigned int)(-1);
+                        diskOffset = _sIndirectOffset;
+                        disk_write(indirectBlock, diskOffset, BLOCK_SIZE);
+                        for (k = 0; k < BLOCK_SIZE / 4; k++) {
+                            if (is_not_null(indirectBlock[k])) break;
+                        }
+                        if (k == BLOCK_SIZE / 4) {
+                            sectorNum = _sIndirectOffset / BLOCK_SIZE;
+                            ssm_deallocate_sectors(sectorNum);
+                            if (is_not_null(_dIndirectOffset)) {
+                                diskOffset = _dIndirectOffset;
+                                disk_read(indirectBlock, diskOffset, BLOCK_SIZE);
+                                for (k = 0; k < BLOCK_SIZE / 4; k++) {
+                                    if (indirectBlock[k] == _sIndirectOffset) {
+                                        indirectBlock[k] = (unsigned int)(-1);
+                                        break;
+                                    }
+                                }
+                                disk_write(indirectBlock, diskOffset, BLOCK_SIZE);
+                            } else {
+                                inode.sIndirect = (unsigned int)(-1);
+                                inode_write(&inode, _inodeNumD);
+                            }
+                        }
+                    }
+                    return True;
+                }
+            }
+        }
+    }
+    return False;
+}
+
+/**
+ * @brief Lists the data blocks under a triple indirect block.
+ * Appends every data block reachable from a specified triple indirect block to the block
+ * list, one pointer block at a time. Internally calls `list_double_indirect_blocks`.
+ * @param[in,out] _list Block list to append to.
+ * @param[in] _buffer Where the first listed block's data goes in the read buffer.
+ * @param[in] _diskOffset Offset to the first usable block on disk.
+ * @return True if every block was listed, false if a pointer block could not be read or the
+ * list could not grow.
+ * @date 2010-04-12 First implementation.
+ */
+static Bool list_triple_indirect_blocks(BlockList *_list, void *_buffer, unsigned int _diskOffset) {
+    unsigned int indirectBlock[BLOCK_SIZE / 4];
+    unsigned int diskOffset = _diskOffset;
+    void *buffer = _buffer;
+    if (!disk_read(indirectBlock, diskOffset, BLOCK_SIZE)) {
+        return False;
+    }
+    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
+        if (is_not_null(indirectBlock[i])) {
+            diskOffset = indirectBlock[i];
+            if (!list_double_indirect_blocks(_list, buffer, diskOffset)) {
+                return False;
+            }
+            buffer = (char *)buffer + BLOCK_SIZE * D_INDIRECT_BLOCKS;
+        } else if (block_list_hole(_list, buffer, D_INDIRECT_BLOCKS)) {
+            buffer = (char *)buffer + BLOCK_SIZE * D_INDIRECT_BLOCKS;
+        }
+    }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
+    return True;
+}
+
+/**
+ * @brief Lists the data blocks under a double indirect block.
+ * Appends every data block reachable from a specified double indirect block to the block
+ * list, one pointer block at a time. Internally calls `list_single_indirect_blocks`.
+ * @param[in,out] _list Block list to append to.
+ * @param[in] _buffer Where the first listed block's data goes in the read buffer.
+ * @param[in] _diskOffset Offset to the first usable block on disk.
+ * @return True if every block was listed, false if a pointer block could not be read or the
+ * list could not grow.
+ * @date 2010-04-12 First implementation.
+ */
+static Bool list_double_indirect_blocks(BlockList *_list, void *_buffer, unsigned int _diskOffset) {
+    unsigned int indirectBlock[BLOCK_SIZE / 4];
+    unsigned int diskOffset = _diskOffset;
+    void *buffer = _buffer;
+    if (!disk_read(indirectBlock, diskOffset, BLOCK_SIZE)) {
+        return False;
+    }
+    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
+        if (is_not_null(indirectBlock[i])) {
+            diskOffset = indirectBlock[i];
+            if (!list_single_indirect_blocks(_list, buffer, diskOffset)) {
+                return False;
+            }
+            buffer = (char *)buffer + BLOCK_SIZE * S_INDIRECT_BLOCKS;
+        } else if (block_list_hole(_list, buffer, S_INDIRECT_BLOCKS)) {
+            buffer = (char *)buffer + BLOCK_SIZE * S_INDIRECT_BLOCKS;
+        }
+    }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
+    return True;
+}
+
+/**
+ * @brief Lists the data blocks named by a single indirect block.
+ * Appends every data block pointed to by a specified single indirect block to the block list.
+ * @param[in,out] _list Block list to append to.
+ * @param[in] _buffer Where the first listed block's data goes in the read buffer.
  * @param[in] _diskOffset Offset to the first usable block on disk.
+ * @return True if every block was listed, false if a pointer block could not be read or the
+ * list could not grow.
+ * @date 2010-04-12 First implementation.
+ */
+static Bool list_single_indirect_blocks(BlockList *_list, void *_buffer, unsigned int _diskOffset) {
+    unsigned int indirectBlock[BLOCK_SIZE / 4];
+    void *buffer = _buffer;
+    if (!disk_read(indirectBlock, _diskOffset, BLOCK_SIZE)) {
+        return False;
+    }
+    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
+        if (is_not_null(indirectBlock[i])) {
+            if (!block_list_append(_list, buffer, indirectBlock[i])) {
+                return False;
+            }
+            buffer = (char *)buffer + BLOCK_SIZE;
+        } else if (block_list_hole(_list, buffer, 1)) {
+            buffer = (char *)buffer + BLOCK_SIZE;
+        }
+    }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
+    return True;
+}
+
+/**
+ * @brief Allocates a triple indirect block and all underlying levels of pointers.
+ * Allocates sectors via the SSM to form a triple indirect structure:
+ * a block pointing to blocks of pointers, which in turn point to more pointer blocks.
+ * Returns the address of the top-level triple indirect block.
+ * @param[in] _blockCount Number of blocks to allocate.
+ * @return The address of the triple indirect block on success, or -1 on failure.
+ * @date 2010-04-12 First implementation.
+ */
+static unsigned int aloc_triple_indirect(long long int _blockCount) {
+    unsigned int baseAddress, address, diskOffset;
+    long long int blockCount = _blockCount;
+    baseAddress = ssm_allocate_sectors(1);
+    if (is_not_null(baseAddress)) {
+        diskOffset = baseAddress;  // inode.tIndirect;
+        // Initialize the indirect block pointers to -1
+        unsigned int base[BLOCK_SIZE / 4];
+        memset(base, 0xFF, BLOCK_SIZE);
+        disk_write(base, diskOffset, BLOCK_SIZE);
+        // Allocate _blockCount blocks and store their pointers in
+        // the indirect block
+        for (unsigned int i = 0; i < PTRS_PER_BLOCK; i++) {
+            address = aloc_double_indirect(_blockCount);
+            // write to buffer
+            disk_write(&address, diskOffset, sizeof(unsigned int));
+            diskOffset += 4;
+            // update block count
+            blockCount -= D_INDIRECT_BLOCKS;
+            if (blockCount < 0) {
+                break;
+            }  // end if (blockCount < 0)
+        }  // end for (i = 0; i < PTRS_PER_BLOCK; i++)
+        // return the address of the tindirect block
+        return baseAddress;
+    } else {
+        return (unsigned int)(-1);
+    }  // end else
+}
+
+/**
+ * @brief Allocates a double indirect block and its underlying pointer blocks.
+ * Allocates sectors via the SSM to form a double indirect structure:
+ * a block pointing to blocks of pointers, which in turn point to data blocks.
+ * Returns the address of the top-level double indirect block.
+ * @param[in] _blockCount Number of blocks to allocate.
+ * @return The address of the double indirect block on success, or -1 on failure.
+ * @date 2010-04-12 First implementation.
+ */
+static unsigned int aloc_double_indirect(long long int _blockCount) {
+    unsigned int baseAddress, address, diskOffset;
+    long long int blockCount = _blockCount;
+    // calculate base address
+    baseAddress = ssm_allocate_sectors(1);
+    if (is_not_null(baseAddress)) {
+        diskOffset = baseAddress;  // inode.sIndirect;
+        // Initialize the indirect block pointers to -1
+        unsigned int base[BLOCK_SIZE / 4];
+        memset(base, 0xFF, BLOCK_SIZE);
+        disk_write(base, diskOffset, BLOCK_SIZE);
+        // Allocate _blockCount blocks and store their pointers in
+        // the indirect block
+        for (unsigned int i = 0; i < PTRS_PER_BLOCK; i++) {
+            address = aloc_single_indirect(_blockCount);
+            // write to buffer
+            disk_write(&address, diskOffset, sizeof(unsigned int));
+            diskOffset += 4;
+            // update block count
+            blockCount -= S_INDIRECT_BLOCKS;
+            if (blockCount < 0) {
+                break;
+            }  // end if (blockCount < 0
+        }  // end for (i = 0; i < PTRS_PER_BLOCK; i++)
+        // return the address of the Dindirect block
+        return baseAddress;
+    } else {
+        return (unsigned int)(-1);
+    }  // end else
+}
+
+/**
+ * @brief Allocates a single indirect block and its associated data blocks.
+ * Allocates a sector from the SSM, fills it with pointers to other sectors,
+ * and returns the address of the allocated single indirect block.
+ * @param[in] _blockCount Number of blocks to allocate.
+ * @return The address of the single indirect block on success, or -1 on failure.
+ * @date 2010-04-12 First implementation.
+ */
+static unsigned int aloc_single_indirect(long long int _blockCount) {
+    unsigned int baseAddress, address, diskOffset;
+    // calculate base address
+    baseAddress = ssm_allocate_sectors(1);
+    if (is_not_null(baseAddress)) {
+        diskOffset = baseAddress;  // inode.sIndirect;
+        // Initialize the indirect block pointers to -1
+        unsigned int base[BLOCK_SIZE / 4];
+        memset(base, 0xFF, BLOCK_SIZE);
+        disk_write(base, diskOffset, BLOCK_SIZE);
+        // Sparse files get their data blocks as they are written, so that zero blocks get none
+        if (sparse_files()) {
+            return baseAddress;
+        }
+        // Allocate _blockCount blocks and store associated pointers in
+        // the indirect block
+        for (unsigned int i = 0; i < _blockCount && i < PTRS_PER_BLOCK; i++) {
+            address = ssm_allocate_sectors(1);
+            if (is_not_null(address)) {
+                // write to buffer
+                disk_write(&address, diskOffset, sizeof(unsigned int));
+                diskOffset += 4;
+            }
+        }  // end for (i = 0; i < _blockCount && i < PTRS_PER_BLOCK; i++
+        // return the address of the sindirect block
+        return baseAddress;
+    } else {
+        return (unsigned int)(-1);
+    }  // end else
+}
+
+/**
+ * @brief Writes data into triple indirect blocks one block at a time.
+ * Writes the contents of the given buffer into a triple indirect structure,
+ * starting at the specified base offset. Internally calls `writeTo_D_IndirectBlocks`
+ * to handle the lower levels.
+ * @param[in] _baseOffset Offset to the first usable data block on disk.
+ * @param[in] _buffer Pointer to the buffer containing data to be written.
+ * @param[in] _tIndirectPtrs Number of blocks to allocate through the triple indirect pointer.
+ * @return void
+ * @date 2010-04-12 First implementation.
+ */
+static void write_to_triple_indirect_blocks(unsigned int _baseOffset, void *_buffer,
+                                            unsigned int _tIndirectPtrs) {
+    unsigned int diskOffset, tIndirectPtrs;
+    unsigned int indirectBlock[BLOCK_SIZE / 4];
+    void *buffer = _buffer;
+    tIndirectPtrs = _tIndirectPtrs;
+    disk_read(indirectBlock, _baseOffset, BLOCK_SIZE);
+    // write to each of the sIndirectPtrs blocks
+    for (unsigned int i = 0; i < PTRS_PER_BLOCK; i++) {
+        diskOffset = indirectBlock[i];
+        if (is_null(diskOffset)) {
+            break;
+        } else {
+            if (tIndirectPtrs - D_INDIRECT_BLOCKS > 0) {
+                // write a dindirect worth of blocks then continue looping
+                write_to_double_indirect_blocks(diskOffset, buffer, D_INDIRECT_BLOCKS);
+                buffer = (char *)buffer + BLOCK_SIZE * D_INDIRECT_BLOCKS;
+                tIndirectPtrs -= D_INDIRECT_BLOCKS;
+            }  // end if (tIndirectPtrs - D_INDIRECT_BLOCKS > 0)
+            else if (tIndirectPtrs - D_INDIRECT_BLOCKS == 0) {
+                // write the rest into a dindirect block
+                write_to_double_indirect_blocks(diskOffset, buffer, D_INDIRECT_BLOCKS);
+                buffer = (char *)buffer + BLOCK_SIZE * D_INDIRECT_BLOCKS;
+                tIndirectPtrs -= D_INDIRECT_BLOCKS;
+                break;
+            } else {
+                // write the rest into a dindirect block
+                write_to_double_indirect_blocks(diskOffset, buffer, tIndirectPtrs);
+                buffer = (char *)buffer + BLOCK_SIZE * tIndirectPtrs;
+                tIndirectPtrs = 0;
+                break;
+            }  // end else
+        }  // end else
+    }  // end for (i = 0; i < PTRS_PER_BLOCK; i++)
+}
+
+/**
+ * @brief Writes data into double indirect blocks one block at a time.
+ * Writes the contents of the given buffer into a double indirect structure,
+ * starting at the specified base offset. Internally calls `writeTo_S_IndirectBlocks`
+ * to handle the single indirect level.
+ * @param[in] _baseOffset Offset to the first usable data block on disk.
+ * @param[in] _buffer Pointer to the buffer containing data to be written.
+ * @param[in] _dIndirectPtrs Number of blocks to allocate through the double indirect pointer.
+ * @return void
+ * @date 2010-04-12 First implementation.
+ */
+static void write_to_double_indirect_blocks(unsigned int _baseOffset, void *_buffer,
+                                            unsigned int _dIndirectPtrs) {
+    unsigned int diskOffset;
+    unsigned int indirectBlock[BLOCK_SIZE / 4];
+    void *buffer = _buffer;
+    unsigned int dIndirectPtrs = _dIndirectPtrs;
+    disk_read(indirectBlock, _baseOffset, BLOCK_SIZE);
+    // write to each of the sIndirectPtrs blocks
+    for (unsigned int i = 0; i < PTRS_PER_BLOCK; i++) {
+        diskOffset = indirectBlock[i];
+        if (is_null(diskOffset)) {
+            break;
+        } else {
+            // write a sindirect block at a time
+            if (dIndirectPtrs - S_INDIRECT_BLOCKS > 0) {
+                write_to_single_indirect_blocks(diskOffset, buffer, S_INDIRECT_BLOCKS);
+                buffer = (char *)buffer + BLOCK_SIZE * S_INDIRECT_BLOCKS;
+                dIndirectPtrs -= S_INDIRECT_BLOCKS;
+            }  // end if (dIndirectPtrs - S_INDIRECT_BLOCKS > 0)
+            // write the rest into a sindirect block
+            else if (dIndirectPtrs - S_INDIRECT_BLOCKS == 0) {
+                write_to_single_indirect_blocks(diskOffset, buffer, S_INDIRECT_BLOCKS);
+                buffer = (char *)buffer + BLOCK_SIZE * S_INDIRECT_BLOCKS;
+                dIndirectPtrs -= S_INDIRECT_BLOCKS;
+                break;
+            }  // end else if (dIndirectPtrs - S_INDIRECT_BLOCKS == 0)
+            // write the rest into a sindirect block
+            else {
+                write_to_single_indirect_blocks(diskOffset, buffer, dIndirectPtrs);
+                buffer = (char *)buffer + BLOCK_SIZE * dIndirectPtrs;
+                dIndirectPtrs = 0;
+                break;
+            }  // end else
+        }  // end else
+    }  // end for (i = 0; i < PTRS_PER_BLOCK; i++)
+}
+
+/**
+ * @brief Writes data into single indirect blocks one block at a time.
+ * Writes the contents of the provided buffer into a single indirect structure,
+ * starting at the specified base offset.
+ * @param[in] _baseOffset Offset to the first usable data block on disk.
+ * @param[in] _buffer Pointer to the buffer containing data to be written.
+ * @param[in] _sIndirectPtrs Number of blocks to allocate through the single indirect pointer.
+ * @return void
+ * @date 2010-04-12 First implementation.
+ */
+static void write_to_single_indirect_blocks(unsigned int _baseOffset, void *_buffer,
+                                            unsigned int _sIndirectPtrs) {
+    unsigned int diskOffset;
+    unsigned int indirectBlock[BLOCK_SIZE / 4];
+    void *buffer = _buffer;
+    Bool allocated = False;
+    // read the single indirect pointer
+    disk_read(indirectBlock, _baseOffset, BLOCK_SIZE);
+    // write to each of the sIndirectPtrs blocks
+    for (unsigned int i = 0; i < _sIndirectPtrs; i++) {
+        // get next pointer
+        diskOffset = indirectBlock[i];
+        if (is_null(diskOffset) && sparse_files()) {
+            // sparse files allocate here, skipping blocks of zeros
+            if (!block_is_zero(buffer, BLOCK_SIZE)) {
+                diskOffset = ssm_allocate_sectors(1);
+                if (is_null(diskOffset)) {
+                    break;
+                }
+                indirectBlock[i] = diskOffset;
+                allocated = True;
+                disk_write(buffer, diskOffset, BLOCK_SIZE);
+            }
+            buffer = (char *)buffer + BLOCK_SIZE;
+        }
+        // if next pointer is unused, break out of loop
+        else if (is_null(diskOffset)) {
+            break;
+        } else {
+            disk_write(buffer, diskOffset, BLOCK_SIZE);
+            buffer = (char *)buffer + BLOCK_SIZE;  // increment buffer
+        }  // end else
+    }  // end for (i = 0; i < _sIndirectPtrs; i++)
+    if (allocated == True) {
+        disk_write(indirectBlock, _baseOffset, BLOCK_SIZE);
+    }
+}
+
+Bool fs_remove_file(unsigned int _inodeNum, unsigned int _inodeNumD) {
+    // Open file at Inode _inodeNum for reading
+    if (!fs_open_file(_inodeNum, &inode)) {
+        return False;
+    }  // end if (success == False)
+    block_map_invalidate(_inodeNum);
+    dentry_forget_inode(_inodeNum);
+    dir_slots_forget(_inodeNum);
+    // A file with other names left only loses this one; its data stays
+    if (inode.fileType != 2 && inode.linkCount > 1) {
+        inode.linkCount -= 1;
+        inode_write(&inode, _inodeNum);
+        return fs_remove_file_from_dir(_inodeNum, _inodeNumD);
+    }
+    unsigned int directPtrs[INODE_DIRECT_PTRS];
+    unsigned int sIndirect = inode.sIndirect;
+    unsigned int dIndirect = inode.dIndirect;
+    unsigned int tIndirect = inode.tIndirect;
+    unsigned int fileType = inode.fileType;
+    unsigned int buffer[BLOCK_SIZE / 4];
+    unsigned int sectorNumber, j, diskOffset;
+    memcpy(directPtrs, inode.directPtr, INODE_DIRECT_PTRS * sizeof(unsigned int));
+    if (is_inline(&inode)) {
+        // An inline file owns no blocks; an inline directory's files are removed here
+        if (fileType == 2) {
+            unsigned int entries[INODE_SIZE / 4];
+            unsigned int entryWords = inode.fileSize / 4;
+            inode_read_inline(&inode, _inodeNum, entries);
+            for (j = 8; j < entryWords; j += 4) {
+                if (entries[j + 3] == 1) {
+                    fs_remove_file(entries[j + 2], _inodeNum);
+                }  // end if (entries[j+3] == 1)
+            }  // end for (j = 8; j < entryWords; j += 4)
+        }
+        memset(directPtrs, 0xFF, INODE_DIRECT_PTRS * sizeof(unsigned int));
+        sIndirect = dIndirect = tIndirect = (unsigned int)(-1);
+    }
+    if (is_extent(&inode)) {
+        // Free every extent and the extent block; there are no pointers to walk
+        Extent extents[MAX_EXTENTS];
+        unsigned int count = extent_load(extents);
+        extent_truncate(extents, &count, 0);
+        if (is_not_null(inode.sIndirect)) {
+            ssm_deallocate_sectors(inode.sIndirect / BLOCK_SIZE);
+        }
+        memset(directPtrs, 0xFF, INODE_DIRECT_PTRS * sizeof(unsigned int));
+        sIndirect = dIndirect = tIndirect = (unsigned int)(-1);
+    }
+    // Read data from direct pointers into buffer _buffer
+    for (unsigned int i = 0; i < INODE_DIRECT_PTRS; i++) {
+        diskOffset = directPtrs[i];
+        if (is_not_null(diskOffset)) {
+            if (fileType == 2) {
+                disk_read(buffer, diskOffset, BLOCK_SIZE);
+                for (j = 8; j < BLOCK_SIZE / 4; j += 4) {
+                    if (buffer[j + 3] == 1) {
+                        fs_remove_file(buffer[j + 2], _inodeNum);
+                    }  // end if (buffer[j+3] == 1)
+                }  // end for (j = 8; j < BLOCK_SIZE/4; j += 4)
+            }  // end if (fileType == 2)
+            sectorNumber = diskOffset / BLOCK_SIZE;
+            ssm_deallocate_sectors(sectorNumber);
+        }
+    }  // end for (i = 0; i < 10; i++)
+
+    // Read data from single indirect pointer into buffer _buffer
+    remove_file_indirect_blocks(SINGLE, sIndirect, fileType, _inodeNum, _inodeNumD);
+    // Read data from double indirect pointer into buffer _buffer
+    remove_file_indirect_blocks(DOUBLE, dIndirect, fileType, _inodeNum, _inodeNumD);
+    // Read data from triple indirect pointer into buffer _buffer
+    remove_file_indirect_blocks(TRIPLE, tIndirect, fileType, _inodeNum, _inodeNumD);
+
+    // Open inode, assign to success whether opening worked. If inode didn't open, return false
+    if (!fs_open_file(_inodeNum, &inode)) {
+        return False;
+    }  // end if (success == False)
+    // A directory's name index goes with it
+    dir_index_drop();
+    // Clear the inode
+    if (inode_init(&inode) == FAILURE) {
+        //@todo do something here
+    }
+    // Write over inode
+    inode_write(&inode, _inodeNum);
+    deallocate_inode(_inodeNum);
+    // Remove the file from its containing directory
+    fs_remove_file_from_dir(_inodeNum, _inodeNumD);
+    // Succeeded so return true
+    return True;
+}
+
+/**
+ * @brief Removes indirect pointers associated with a file.
+ * Clears indirect block references for a file, starting at the specified disk offset.
+ * @param[in] _type the indirect PointerType (SINGLE, DOUBLE, TRIPLE)
+ * @param[in] indirect Offset to the first usable data block on disk.
+ * @param[in] _fileType Type of the file being removed.
+ * @param[in] _inodeNum Inode number of the file.
+ * @param[in] _inodeNumD Inode number of the directory containing the file.
+ * @return void
+ * @date 2010-04-12 First implementation.
+ */
+static inline void remove_file_indirect_blocks(PointerType _type, unsigned int indirect,
+                                               unsigned int fileType, unsigned int _inodeNum,
+                                               unsigned int _inodeNumD) {
+    typedef void (*RemoveFunc)(unsigned int, unsigned int, unsigned int);
+
+    RemoveFunc remove_func;
+
+    if (_type == SINGLE) {
+        remove_func = remove_file_single_indirect_blocks;
+    } else if (_type == DOUBLE) {
+        remove_func = remove_file_double_indirect_blocks;
+    } else {
+        remove_func = remove_file_triple_indirect_blocks;
+    }
+
+    // Read data from single indirect pointer into buffer _buffer
+    unsigned int diskOffset = indirect;
+    if (is_not_null(diskOffset)) {
+        if (fileType == 1) {
+            // If remove directory, pass inodeNumD
+            remove_func(fileType, _inodeNumD, diskOffset);
+        } else if (fileType == 2) {
+            // If remove file, pass inodeNum
+            remove_func(fileType, _inodeNum, diskOffset);
+        }
+    }
+}
+
+/**
+ * @brief Removes triple indirect pointers associated with a file.
+ * Clears triple indirect block references for a file, starting at the specified disk offset.
+ * @param[in] _fileType Type of the file being removed.
+ * @param[in] _inodeNumD Inode number of the directory containing the file.
+ * @param[in] _diskOffset Offset to the first usable data block on disk.
+ * @return void
+ * @date 2010-04-12 First implementation.
+ */
+static void remove_file_triple_indirect_blocks(unsigned int _fileType, unsigned int _inodeNumD,
+                                               unsigned int _diskOffset) {
+    unsigned int indirectBlock[BLOCK_SIZE / 4];
+    unsigned int diskOffset = _diskOffset;
+    // Read disk to indirectBlock
+    disk_read(indirectBlock, diskOffset, BLOCK_SIZE);
+    // Deallocate Double indirect blocks
+    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
+        if (is_not_null(indirectBlock[i])) {
+            diskOffset = indirectBlock[i];
+            remove_file_double_indirect_blocks(_fileType, _inodeNumD, diskOffset);
+        }
+    }  // for (i = 0; i < BLOCK_SIZE/4; i++)
+    // Deallocate T indirect block
+    diskOffset = _diskOffset;
+    unsigned int sectorNumber = diskOffset / BLOCK_SIZE;
+    ssm_deallocate_sectors(sectorNumber);
+}
+
+/**
+ * @brief Removes double indirect pointers associated with a file.
+ * Clears double indirect block references for a file, starting at the specified disk offset.
+ * @param[in] _fileType Type of the file being removed.
+ * @param[in] _inodeNumD Inode number of the directory containing the file.
+ * @param[in] _diskOffset Offset to the first usable data block on disk.
  * @return void
  * @date 2010-04-12 First implementation.
  */
-static void read_from_single_indirect_blocks(void *_buffer, unsigned int _diskOffset) {
+static void remove_file_double_indirect_blocks(unsigned int _fileType, unsigned int _inodeNumD,
+                                               unsigned int _diskOffset) {
     unsigned int indirectBlock[BLOCK_SIZE / 4];
     unsigned int diskOffset = _diskOffset;
-    void *buffer = _buffer;
-    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-    fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
+    // Read disk to indirectBlock
+    disk_read(indirectBlock, diskOffset, BLOCK_SIZE);
+    // Remove all the Single indirect pointers
     for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
         if (is_not_null(indirectBlock[i])) {
             diskOffset = indirectBlock[i];
-            fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-            fread(buffer, BLOCK_SIZE, 1, fsm->diskHandle);
-            buffer = (char *)buffer + BLOCK_SIZE;
+            remove_file_single_indirect_blocks(_fileType, _inodeNumD, diskOffset);
         }
     }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
+    // Deallocate D indirect block
+    diskOffset = _diskOffset;
+    unsigned int sectorNumber = diskOffset / BLOCK_SIZE;
+    ssm_deallocate_sectors(sectorNumber);
 }
 
 /**
- * @brief Allocates a triple indirect block and all underlying levels of pointers.
- * Allocates sectors via the SSM to form a triple indirect structure:
- * a block pointing to blocks of pointers, which in turn point to more pointer blocks.
- * Returns the address of the top-level triple indirect block.
- * @param[in] _blockCount Number of blocks to allocate.
- * @return The address of the triple indirect block on success, or -1 on failure.
+ * @brief Removes single indirect pointers associated with a file.
+ * Clears single indirect block references for a file, starting at the specified disk offset.
+ * @param[in] _fileType Type of the file being removed.
+ * @param[in] _inodeNumD Inode number of the directory containing the file.
+ * @param[in] _diskOffset Offset to the first usable data block on disk.
+ * @return void
  * @date 2010-04-12 First implementation.
  */
-static unsigned int aloc_triple_indirect(long long int _blockCount) {
-    unsigned int baseAddress, address, diskOffset;
-    long long int blockCount = _blockCount;
-    baseAddress = ssm_allocate_sectors(1);
-    if (is_not_null(baseAddress)) {
-        diskOffset = baseAddress;  // inode.tIndirect;
-        // Initialize the indirect block pointers to -1
-        unsigned int base[BLOCK_SIZE / 4];
-        memset(base, 0xFF, BLOCK_SIZE);
-        fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-        fwrite(base, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-        // Allocate _blockCount blocks and store their pointers in
-        // the indirect block
-        for (unsigned int i = 0; i < PTRS_PER_BLOCK; i++) {
-            address = aloc_double_indirect(_blockCount);
-            // write to buffer
-            fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-            fwrite(&address, sizeof(unsigned int), 1, fsm->diskHandle);
-            diskOffset += 4;
-            // update block count
-            blockCount -= D_INDIRECT_BLOCKS;
-            if (blockCount < 0) {
-                break;
-            }  // end if (blockCount < 0)
-        }  // end for (i = 0; i < PTRS_PER_BLOCK; i++)
-        // return the address of the tindirect block
-        return baseAddress;
-    } else {
-        return (unsigned int)(-1);
-    }  // end else
+static void remove_file_single_indirect_blocks(unsigned int _fileType, unsigned int _inodeNumD,
+                                               unsigned int _diskOffset) {
+    unsigned int indirectBlock[BLOCK_SIZE / 4];
+    unsigned int diskOffset = _diskOffset;
+    unsigned int buffer[BLOCK_SIZE / 4];
+    unsigned int sectorNumber, j;
+    // Read disk to indirectBlock
+    disk_read(indirectBlock, diskOffset, BLOCK_SIZE);
+    // Deallocate all Single Indirect Blocks
+    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
+        if (is_not_null(indirectBlock[i])) {
+            diskOffset = indirectBlock[i];
+            // Deallocate Data Blocks
+            if (_fileType == 2) {
+                disk_read(buffer, diskOffset, BLOCK_SIZE);
+                for (j = 8; j < BLOCK_SIZE / 4; j += 4) {
+                    if (buffer[j + 3] == 1) {
+                        fs_remove_file(buffer[j + 2], _inodeNumD);
+                    }  // end if (buffer[j+3] == 1)
+                }  // end for (j = 8; j < BLOCK_SIZE/4; j += 4)
+            }  // end if (_fileType == 2)
+            sectorNumber = diskOffset / BLOCK_SIZE;
+            ssm_deallocate_sectors(sectorNumber);
+        }
+    }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
+    // Deallocate S indirect block
+    diskOffset = _diskOffset;
+    sectorNumber = diskOffset / BLOCK_SIZE;
+    ssm_deallocate_sectors(sectorNumber);
 }
 
 /**
- * @brief Allocates a double indirect block and its underlying pointer blocks.
- * Allocates sectors via the SSM to form a double indirect structure:
- * a block pointing to blocks of pointers, which in turn point to data blocks.
- * Returns the address of the top-level double indirect block.
- * @param[in] _blockCount Number of blocks to allocate.
- * @return The address of the double indirect block on success, or -1 on failure.
- * @date 2010-04-12 First implementation.
+ * @brief Frees the data blocks of a single indirect block from pointer `_keep` on.
+ * Walks the pointers like `remove_file_single_indirect_blocks`, but keeps the first `_keep`
+ * blocks; the block is freed too when nothing is left under it.
+ * @param[in] _diskOffset Offset of the single indirect block on disk.
+ * @param[in] _keep Number of leading blocks to keep.
+ * @param[in,out] _batch Sectors waiting to be freed.
+ * @return True if the single indirect block was freed, false if it still maps blocks.
+ * @date 2026-10-18 First implementation.
  */
-static unsigned int aloc_double_indirect(long long int _blockCount) {
-    unsigned int baseAddress, address, diskOffset;
-    long long int blockCount = _blockCount;
-    // calculate base address
-    baseAddress = ssm_allocate_sectors(1);
-    if (is_not_null(baseAddress)) {
-        diskOffset = baseAddress;  // inode.sIndirect;
-        // Initialize the indirect block pointers to -1
-        unsigned int base[BLOCK_SIZE / 4];
-        memset(base, 0xFF, BLOCK_SIZE);
-        fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-        fwrite(base, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-        // Allocate _blockCount blocks and store their pointers in
-        // the indirect block
-        for (unsigned int i = 0; i < PTRS_PER_BLOCK; i++) {
-            address = aloc_single_indirect(_blockCount);
-            // write to buffer
-            fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-            fwrite(&address, sizeof(unsigned int), 1, fsm->diskHandle);
-            diskOffset += 4;
-            // update block count
-            blockCount -= S_INDIRECT_BLOCKS;
-            if (blockCount < 0) {
+static Bool truncate_single_indirect_blocks(unsigned int _diskOffset, unsigned int _keep,
+                                            SectorBatch *_batch) {
+    unsigned int indirectBlock[BLOCK_SIZE / 4];
+    disk_read(indirectBlock, _diskOffset, BLOCK_SIZE);
+    Bool empty = True, changed = False;
+    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
+        if (is_null(indirectBlock[i])) {
+            continue;
+        }
+        if (i < _keep) {
+            empty = False;
+        } else {
+            sector_batch_add(_batch, indirectBlock[i]);
+            indirectBlock[i] = (unsigned int)(-1);
+            changed = True;
+        }
+    }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
+    if (empty == True) {
+        sector_batch_add(_batch, _diskOffset);
+    } else if (changed == True) {
+        disk_write(indirectBlock, _diskOffset, BLOCK_SIZE);
+    }
+    return empty;
+}
+
+/**
+ * @brief Frees the blocks under a double indirect block from block `_keep` on.
+ * Single indirect blocks that lie wholly before `_keep` are not read.
+ * @param[in] _diskOffset Offset of the double indirect block on disk.
+ * @param[in] _keep Number of leading blocks to keep.
+ * @param[in,out] _batch Sectors waiting to be freed.
+ * @return True if the double indirect block was freed, false if it still maps blocks.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool truncate_double_indirect_blocks(unsigned int _diskOffset, unsigned int _keep,
+                                            SectorBatch *_batch) {
+    unsigned int indirectBlock[BLOCK_SIZE / 4];
+    disk_read(indirectBlock, _diskOffset, BLOCK_SIZE);
+    Bool empty = True, changed = False;
+    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
+        if (is_null(indirectBlock[i])) {
+            continue;
+        }
+        unsigned int first = i * S_INDIRECT_BLOCKS;
+        if (first + S_INDIRECT_BLOCKS <= _keep) {
+            empty = False;
+        } else if (truncate_single_indirect_blocks(indirectBlock[i],
+                                                   _keep > first ? _keep - first : 0,
+                                                   _batch) == True) {
+            indirectBlock[i] = (unsigned int)(-1);
+            changed = True;
+        } else {
+            empty = False;
+        }
+    }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
+    if (empty == True) {
+        sector_batch_add(_batch, _diskOffset);
+    } else if (changed == True) {
+        disk_write(indirectBlock, _diskOffset, BLOCK_SIZE);
+    }
+    return empty;
+}
+
+/**
+ * @brief Frees the blocks under a triple indirect block from block `_keep` on.
+ * Double indirect blocks that lie wholly before `_keep` are not read.
+ * @param[in] _diskOffset Offset of the triple indirect block on disk.
+ * @param[in] _keep Number of leading blocks to keep.
+ * @param[in,out] _batch Sectors waiting to be freed.
+ * @return True if the triple indirect block was freed, false if it still maps blocks.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool truncate_triple_indirect_blocks(unsigned int _diskOffset, unsigned int _keep,
+                                            SectorBatch *_batch) {
+    unsigned int indirectBlock[BLOCK_SIZE / 4];
+    disk_read(indirectBlock, _diskOffset, BLOCK_SIZE);
+    Bool empty = True, changed = False;
+    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
+        if (is_null(indirectBlock[i])) {
+            continue;
+        }
+        unsigned int first = i * D_INDIRECT_BLOCKS;
+        if (first + D_INDIRECT_BLOCKS <= _keep) {
+            empty = False;
+        } else if (truncate_double_indirect_blocks(indirectBlock[i],
+                                                   _keep > first ? _keep - first : 0,
+                                                   _batch) == True) {
+            indirectBlock[i] = (unsigned int)(-1);
+            changed = True;
+        } else {
+            empty = False;
+        }
+    }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
+    if (empty == True) {
+        sector_batch_add(_batch, _diskOffset);
+    } else if (changed == True) {
+        disk_write(indirectBlock, _diskOffset, BLOCK_SIZE);
+    }
+    return empty;
+}
+
+/**
+ * @brief Hashes a file name for a directory's name index (FNV-1a over its up to 8 bytes).
+ * @param[in] _name Pointer to the name of the file.
+ * @return The hash of the name.
+ * @date 2026-10-18 First implementation.
+ */
+static unsigned int dir_name_hash(const unsigned int *_name) {
+    const unsigned char *bytes = (const unsigned char *)_name;
+    unsigned int hash = 2166136261u;
+    for (unsigned int i = 0; i < 2 * sizeof(unsigned int) && bytes[i] != '\0'; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Compares two file names the way a directory entry stores them.
+ * @param[in] _a Pointer to the first name.
+ * @param[in] _b Pointer to the second name.
+ * @return True if the names are the same, false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool dir_name_equal(const unsigned int *_a, const unsigned int *_b) {
+    return strncmp((const char *)_a, (const char *)_b, 2 * sizeof(unsigned int)) == 0 ? True
+                                                                                      : False;
+}
+
+/**
+ * @brief Gets the root node of the name index of the open directory (`inode`).
+ * @return Disk offset of the root node, kept in the first spare word of the inode.
+ * @date 2026-10-18 First implementation.
+ */
+static unsigned int dir_index_root(void) {
+    unsigned int spare[INODE_SIZE / 4];
+    inode_read_spare(inode_map.id, spare);
+    return spare[0];
+}
+
+/**
+ * @brief Sets the root node of the name index of the open directory (`inode`).
+ * @param[in] _diskOffset Disk offset of the root node.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void dir_index_set_root(unsigned int _diskOffset) {
+    unsigned int spare[INODE_SIZE / 4];
+    inode_read_spare(inode_map.id, spare);
+    spare[0] = _diskOffset;
+    inode_write_spare(inode_map.id, spare);
+}
+
+/**
+ * @brief Finds the leaf of the open directory's name index that covers a hash.
+ * At each level the child of the last pair whose hash is not above `_hash` is followed.
+ * @param[in] _hash Hash of a name.
+ * @param[out] _node Buffer of BLOCK_SIZE bytes; receives the leaf.
+ * @param[out] _path Disk offsets of the interior nodes passed, root first (DIR_INDEX_MAX_DEPTH).
+ * @param[out] _depth Number of interior nodes passed.
+ * @return Disk offset of the leaf.
+ * @date 2026-10-18 First implementation.
+ */
+static unsigned int dir_index_leaf(unsigned int _hash, unsigned int *_node, unsigned int *_path,
+                                   unsigned int *_depth) {
+    unsigned int diskOffset = dir_index_root();
+    *_depth = 0;
+    disk_read(_node, diskOffset, BLOCK_SIZE);
+    while (_node[0] > 0 && *_depth < DIR_INDEX_MAX_DEPTH) {
+        unsigned int i = 1;
+        while (i < _node[1] && _node[2 + 2 * i] <= _hash) {
+            i++;
+        }
+        _path[(*_depth)++] = diskOffset;
+        diskOffset = _node[2 + 2 * (i - 1) + 1];
+        disk_read(_node, diskOffset, BLOCK_SIZE);
+    }
+    return diskOffset;
+}
+
+/**
+ * @brief Adds an entry of the open directory (`inode`) to its name index.
+ * A full node is split in two and the new node is added to its parent, up to a new root. Leaves
+ * are split between different hashes so that all entries of one hash stay in one leaf. If the
+ * index cannot take the entry (no free block, or a leaf full of one hash) it is dropped and the
+ * directory goes back to being scanned.
+ * @param[in] _name Pointer to the name of the entry.
+ * @param[in] _entryOffset Disk offset of the entry.
+ * @return True if the entry was indexed or the directory has no index, false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool dir_index_insert(const unsigned int *_name, unsigned int _entryOffset) {
+    unsigned int node[BLOCK_SIZE / 4];
+    unsigned int pairs[2 * (INDEX_PAIRS + 1)];
+    unsigned int path[DIR_INDEX_MAX_DEPTH];
+    unsigned int depth, diskOffset, count, half, i;
+    unsigned int pending = (unsigned int)(-1);
+    if (!is_dir_indexed(&inode)) {
+        return True;
+    }
+    unsigned int key = dir_name_hash(_name);
+    unsigned int value = _entryOffset;
+    diskOffset = dir_index_leaf(key, node, path, &depth);
+    for (;;) {
+        // The new pair goes after every pair of a lower or equal hash
+        count = node[1];
+        for (i = 0; i < count && node[2 + 2 * i] <= key; i++) {
+        }
+        if (count < INDEX_PAIRS) {
+            memmove(&node[2 + 2 * i + 2], &node[2 + 2 * i], (count - i) * 2 * sizeof(unsigned int));
+            node[2 + 2 * i] = key;
+            node[2 + 2 * i + 1] = value;
+            node[1] = count + 1;
+            disk_write(node, diskOffset, BLOCK_SIZE);
+            return True;
+        }
+        memcpy(pairs, &node[2], 2 * i * sizeof(unsigned int));
+        pairs[2 * i] = key;
+        pairs[2 * i + 1] = value;
+        memcpy(&pairs[2 * i + 2], &node[2 + 2 * i], (count - i) * 2 * sizeof(unsigned int));
+        count += 1;
+        half = count / 2;
+        if (node[0] == 0) {
+            // Move the split to the nearest point between two different hashes
+            unsigned int d;
+            for (d = 0; d < count; d++) {
+                if (half > d && pairs[2 * (half - d) - 2] != pairs[2 * (half - d)]) {
+                    half -= d;
+                    break;
+                }
+                if (half + d < count && pairs[2 * (half + d) - 2] != pairs[2 * (half + d)]) {
+                    half += d;
+                    break;
+                }
+            }
+            if (d == count) {
                 break;
-            }  // end if (blockCount < 0
-        }  // end for (i = 0; i < PTRS_PER_BLOCK; i++)
-        // return the address of the Dindirect block
-        return baseAddress;
-    } else {
-        return (unsigned int)(-1);
-    }  // end else
+            }
+        }
+        unsigned int right = ssm_allocate_sectors(1);
+        if (is_null(right) || (depth == 0 && node[0] + 1 > DIR_INDEX_MAX_DEPTH)) {
+            if (is_not_null(right)) {
+                ssm_deallocate_sectors(right / BLOCK_SIZE);
+            }
+            break;
+        }
+        unsigned int level = node[0];
+        memset(node, 0, BLOCK_SIZE);
+        node[0] = level;
+        node[1] = count - half;
+        memcpy(&node[2], &pairs[2 * half], (count - half) * 2 * sizeof(unsigned int));
+        disk_write(node, right, BLOCK_SIZE);
+        pending = right;
+        memset(node, 0, BLOCK_SIZE);
+        node[0] = level;
+        node[1] = half;
+        memcpy(&node[2], pairs, half * 2 * sizeof(unsigned int));
+        disk_write(node, diskOffset, BLOCK_SIZE);
+        key = pairs[2 * half];
+        value = right;
+        if (depth == 0) {
+            // The root was split: a new root takes both halves
+            unsigned int root = ssm_allocate_sectors(1);
+            if (is_null(root)) {
+                break;
+            }
+            memset(node, 0, BLOCK_SIZE);
+            node[0] = level + 1;
+            node[1] = 2;
+            node[2] = 0;
+            node[3] = diskOffset;
+            node[4] = key;
+            node[5] = value;
+            disk_write(node, root, BLOCK_SIZE);
+            dir_index_set_root(root);
+            return True;
+        }
+        diskOffset = path[--depth];
+        disk_read(node, diskOffset, BLOCK_SIZE);
+    }
+    // A half written out but not linked is not reached from the root
+    SectorBatch batch;
+    batch.count = 0;
+    if (is_not_null(pending)) {
+        dir_index_free(pending, &batch);
+    }
+    sector_batch_flush(&batch);
+    dir_index_drop();
+    return False;
+}
+
+/**
+ * @brief Removes an entry of the open directory (`inode`) from its name index.
+ * @param[in] _name Pointer to the name the entry has in the index.
+ * @param[in] _entryOffset Disk offset of the entry.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void dir_index_delete(const unsigned int *_name, unsigned int _entryOffset) {
+    unsigned int node[BLOCK_SIZE / 4];
+    unsigned int path[DIR_INDEX_MAX_DEPTH];
+    unsigned int depth;
+    if (!is_dir_indexed(&inode)) {
+        return;
+    }
+    unsigned int hash = dir_name_hash(_name);
+    unsigned int diskOffset = dir_index_leaf(hash, node, path, &depth);
+    for (unsigned int i = 0; i < node[1]; i++) {
+        if (node[2 + 2 * i] == hash && node[2 + 2 * i + 1] == _entryOffset) {
+            memmove(&node[2 + 2 * i], &node[2 + 2 * i + 2],
+                    (node[1] - i - 1) * 2 * sizeof(unsigned int));
+            node[1] -= 1;
+            disk_write(node, diskOffset, BLOCK_SIZE);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Looks a name up in the name index of the open directory (`inode`).
+ * Only the entries whose name has the same hash are read.
+ * @param[in] _name Pointer to the name of the file.
+ * @return Inode number of the file, -1 if the directory has no entry of that name.
+ * @date 2026-10-18 First implementation.
+ */
+static unsigned int dir_index_find(const unsigned int *_name) {
+    unsigned int node[BLOCK_SIZE / 4];
+    unsigned int path[DIR_INDEX_MAX_DEPTH];
+    unsigned int entry[DIR_ENTRY_SIZE / 4];
+    unsigned int depth;
+    unsigned int hash = dir_name_hash(_name);
+    dir_index_leaf(hash, node, path, &depth);
+    for (unsigned int i = 0; i < node[1] && node[2 + 2 * i] <= hash; i++) {
+        if (node[2 + 2 * i] == hash) {
+            disk_read(entry, node[2 + 2 * i + 1], DIR_ENTRY_SIZE);
+            if (entry[3] == 1 && dir_name_equal(entry, _name)) {
+                return entry[2];
+            }
+        }
+    }
+    return (unsigned int)(-1);
+}
+
+/**
+ * @brief Builds a name index for the open directory (`inode`) from its entry blocks.
+ * The directory keeps its entries where they are; the index lives in blocks of its own, with
+ * the root's offset in the inode's spare bytes.
+ * @return True if the directory is now indexed, false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool dir_index_build(void) {
+    unsigned int node[BLOCK_SIZE / 4];
+    if (inode_spare_size() < sizeof(unsigned int) || inode.fileType != 2 || is_inline(&inode)) {
+        return False;
+    }
+    unsigned int root = ssm_allocate_sectors(1);
+    if (is_null(root)) {
+        return False;
+    }
+    memset(node, 0, BLOCK_SIZE);
+    disk_write(node, root, BLOCK_SIZE);
+    dir_index_set_root(root);
+    inode.status |= INODE_DIR_INDEX;
+    inode_write(&inode, inode_map.id);
+    dir_walk(index_entry, NULL);
+    return is_dir_indexed(&inode);
+}
+
+/**
+ * @brief Frees the name index of the open directory (`inode`), if it has one.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void dir_index_drop(void) {
+    if (!is_dir_indexed(&inode)) {
+        return;
+    }
+    SectorBatch batch;
+    batch.count = 0;
+    dir_index_free(dir_index_root(), &batch);
+    sector_batch_flush(&batch);
+    inode.status &= ~INODE_DIR_INDEX;
+    inode_write(&inode, inode_map.id);
+}
+
+/**
+ * @brief Queues a node of a name index and every node below it to be freed.
+ * @param[in] _diskOffset Disk offset of the node.
+ * @param[in,out] _batch Sectors waiting to be freed.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void dir_index_free(unsigned int _diskOffset, SectorBatch *_batch) {
+    unsigned int node[BLOCK_SIZE / 4];
+    disk_read(node, _diskOffset, BLOCK_SIZE);
+    if (node[0] > 0) {
+        for (unsigned int i = 0; i < node[1]; i++) {
+            dir_index_free(node[2 + 2 * i + 1], _batch);
+        }
+    }
+    sector_batch_add(_batch, _diskOffset);
+}
+
+/**
+ * @brief Calls a visitor on every used entry the open directory (`inode`) keeps in blocks.
+ * @param[in] _visit Visitor; returning True stops the walk.
+ * @param[in] _arg Argument handed to the visitor.
+ * @return True if the visitor stopped the walk, false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool dir_walk(EntryVisitor _visit, void *_arg) {
+    for (unsigned int i = 0; i < (unsigned int)INODE_DIRECT_PTRS; i++) {
+        if (is_not_null(inode.directPtr[i]) &&
+            dir_walk_blocks(inode.directPtr[i], 0, _visit, _arg)) {
+            return True;
+        }
+    }
+    if (is_not_null(inode.sIndirect) && dir_walk_blocks(inode.sIndirect, 1, _visit, _arg)) {
+        return True;
+    }
+    if (is_not_null(inode.dIndirect) && dir_walk_blocks(inode.dIndirect, 2, _visit, _arg)) {
+        return True;
+    }
+    if (is_not_null(inode.tIndirect) && dir_walk_blocks(inode.tIndirect, 3, _visit, _arg)) {
+        return True;
+    }
+    return False;
+}
+
+/**
+ * @brief Calls a visitor on every used entry under a block of a directory.
+ * @param[in] _diskOffset Disk offset of the block.
+ * @param[in] _level 0 for an entry block, 1 to 3 for a single to triple indirect block.
+ * @param[in] _visit Visitor; returning True stops the walk.
+ * @param[in] _arg Argument handed to the visitor.
+ * @return True if the visitor stopped the walk, false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool dir_walk_blocks(unsigned int _diskOffset, unsigned int _level, EntryVisitor _visit,
+                            void *_arg) {
+    unsigned int buffer[BLOCK_SIZE / 4];
+    disk_read(buffer, _diskOffset, BLOCK_SIZE);
+    for (unsigned int j = 0; j < BLOCK_SIZE / 4; j += _level == 0 ? 4 : 1) {
+        if (_level == 0) {
+            if (buffer[j + 3] == 1 && _visit(&buffer[j], _diskOffset + j * 4, _arg)) {
+                return True;
+            }
+        } else if (is_not_null(buffer[j]) &&
+                   dir_walk_blocks(buffer[j], _level - 1, _visit, _arg)) {
+            return True;
+        }
+    }
+    return False;
+}
+
+/**
+ * @brief Directory walk visitor adding each entry to the directory's name index.
+ * @param[in] _entry The entry.
+ * @param[in] _entryOffset Disk offset of the entry.
+ * @param[in] _arg Unused.
+ * @return True to stop the walk once the index has been dropped.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool index_entry(const unsigned int *_entry, unsigned int _entryOffset, void *_arg) {
+    (void)_arg;
+    return dir_index_insert(_entry, _entryOffset) == True ? False : True;
 }
 
 /**
- * @brief Allocates a single indirect block and its associated data blocks.
- * Allocates a sector from the SSM, fills it with pointers to other sectors,
- * and returns the address of the allocated single indirect block.
- * @param[in] _blockCount Number of blocks to allocate.
- * @return The address of the single indirect block on success, or -1 on failure.
- * @date 2010-04-12 First implementation.
+ * @brief Directory walk visitor looking for an entry by name.
+ * @param[in] _entry The entry.
+ * @param[in] _entryOffset Unused.
+ * @param[in,out] _arg The NameSearch; its inode number is set when the name matches.
+ * @return True to stop the walk once the name is found.
+ * @date 2026-10-18 First implementation.
  */
-static unsigned int aloc_single_indirect(long long int _blockCount) {
-    unsigned int baseAddress, address, diskOffset;
-    // calculate base address
-    baseAddress = ssm_allocate_sectors(1);
-    if (is_not_null(baseAddress)) {
-        diskOffset = baseAddress;  // inode.sIndirect;
-        // Initialize the indirect block pointers to -1
-        unsigned int base[BLOCK_SIZE / 4];
-        memset(base, 0xFF, BLOCK_SIZE);
-        fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-        fwrite(base, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-        // Allocate _blockCount blocks and store associated pointers in
-        // the indirect block
-        for (unsigned int i = 0; i < _blockCount && i < PTRS_PER_BLOCK; i++) {
-            address = ssm_allocate_sectors(1);
-            if (is_not_null(address)) {
-                // write to buffer
-                fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-                fwrite(&address, sizeof(unsigned int), 1, fsm->diskHandle);
-                diskOffset += 4;
+static Bool find_name(const unsigned int *_entry, unsigned int _entryOffset, void *_arg) {
+    NameSearch *search = (NameSearch *)_arg;
+    (void)_entryOffset;
+    if (dir_name_equal(_entry, search->name)) {
+        search->inodeNum = _entry[2];
+        return True;
+    }
+    return False;
+}
+
+/**
+ * @brief Looks a name up in the entries of the open directory (`inode`).
+ * @param[in] _inodeNumD Inode number of the directory.
+ * @param[in] _name Pointer to the name of the file.
+ * @return Inode number of the file, -1 if the directory has no entry of that name.
+ * @date 2026-10-18 First implementation.
+ */
+static unsigned int dir_lookup(unsigned int _inodeNumD, const unsigned int *_name) {
+    if (is_dir_indexed(&inode)) {
+        return dir_index_find(_name);
+    }
+    if (is_inline(&inode)) {
+        unsigned int entries[INODE_SIZE / 4];
+        inode_read_inline(&inode, _inodeNumD, entries);
+        for (unsigned int j = 0; j < inode.fileSize / 4; j += 4) {
+            if (entries[j + 3] == 1 && dir_name_equal(&entries[j], _name)) {
+                return entries[j + 2];
             }
-        }  // end for (i = 0; i < _blockCount && i < PTRS_PER_BLOCK; i++
-        // return the address of the sindirect block
-        return baseAddress;
-    } else {
+        }
         return (unsigned int)(-1);
-    }  // end else
+    }
+    NameSearch search;
+    search.name = _name;
+    search.inodeNum = (unsigned int)(-1);
+    dir_walk(find_name, &search);
+    return search.inodeNum;
 }
 
 /**
- * @brief Writes data into triple indirect blocks one block at a time.
- * Writes the contents of the given buffer into a triple indirect structure,
- * starting at the specified base offset. Internally calls `writeTo_D_IndirectBlocks`
- * to handle the lower levels.
- * @param[in] _baseOffset Offset to the first usable data block on disk.
- * @param[in] _buffer Pointer to the buffer containing data to be written.
- * @param[in] _tIndirectPtrs Number of blocks to allocate through the triple indirect pointer.
+ * @brief Gets the slot of the dentry cache a name in a directory hashes to.
+ * @param[in] _inodeNumD Inode number of the directory.
+ * @param[in] _name Pointer to the name of the file.
+ * @return The slot; it may hold another name.
+ * @date 2026-10-18 First implementation.
+ */
+static Dentry *dentry_slot(unsigned int _inodeNumD, const unsigned int *_name) {
+    unsigned int hash = dir_name_hash(_name) ^ (_inodeNumD * 2654435761u);
+    return &dentries[hash % DENTRY_CACHE_SIZE];
+}
+
+/**
+ * @brief Looks a name up in the dentry cache.
+ * @param[in] _inodeNumD Inode number of the directory.
+ * @param[in] _name Pointer to the name of the file.
+ * @param[out] _inodeNum Inode number of the file, -1 if the name is known not to be there.
+ * @return True if the cache knows the name, false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool dentry_find(unsigned int _inodeNumD, const unsigned int *_name,
+                        unsigned int *_inodeNum) {
+    Dentry *dentry = dentry_slot(_inodeNumD, _name);
+    if (dentry->used == True && dentry->inodeNumD == _inodeNumD &&
+        dir_name_equal(dentry->name, _name)) {
+        *_inodeNum = dentry->inodeNum;
+        return True;
+    }
+    return False;
+}
+
+/**
+ * @brief Remembers what a name in a directory refers to, replacing whatever was in its slot.
+ * @param[in] _inodeNumD Inode number of the directory.
+ * @param[in] _name Pointer to the name of the file.
+ * @param[in] _inodeNum Inode number of the file, -1 to remember that there is no such name.
  * @return void
- * @date 2010-04-12 First implementation.
+ * @date 2026-10-18 First implementation.
  */
-static void write_to_triple_indirect_blocks(unsigned int _baseOffset, void *_buffer,
-                                            unsigned int _tIndirectPtrs) {
-    unsigned int diskOffset, tIndirectPtrs;
-    unsigned int indirectBlock[BLOCK_SIZE / 4];
-    void *buffer = _buffer;
-    tIndirectPtrs = _tIndirectPtrs;
-    fseek(fsm->diskHandle, _baseOffset, SEEK_SET);
-    fread(&indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-    // write to each of the sIndirectPtrs blocks
-    for (unsigned int i = 0; i < PTRS_PER_BLOCK; i++) {
-        diskOffset = indirectBlock[i];
-        if (is_null(diskOffset)) {
-            break;
-        } else {
-            if (tIndirectPtrs - D_INDIRECT_BLOCKS > 0) {
-                // write a dindirect worth of blocks then continue looping
-                write_to_double_indirect_blocks(diskOffset, buffer, D_INDIRECT_BLOCKS);
-                buffer = (char *)buffer + BLOCK_SIZE * D_INDIRECT_BLOCKS;
-                tIndirectPtrs -= D_INDIRECT_BLOCKS;
-            }  // end if (tIndirectPtrs - D_INDIRECT_BLOCKS > 0)
-            else if (tIndirectPtrs - D_INDIRECT_BLOCKS == 0) {
-                // write the rest into a dindirect block
-                write_to_double_indirect_blocks(diskOffset, buffer, D_INDIRECT_BLOCKS);
-                buffer = (char *)buffer + BLOCK_SIZE * D_INDIRECT_BLOCKS;
-                tIndirectPtrs -= D_INDIRECT_BLOCKS;
-                break;
-            } else {
-                // write the rest into a dindirect block
-                write_to_double_indirect_blocks(diskOffset, buffer, tIndirectPtrs);
-                buffer = (char *)buffer + BLOCK_SIZE * tIndirectPtrs;
-                tIndirectPtrs = 0;
-                break;
-            }  // end else
-        }  // end else
-    }  // end for (i = 0; i < PTRS_PER_BLOCK; i++)
+static void dentry_store(unsigned int _inodeNumD, const unsigned int *_name,
+                         unsigned int _inodeNum) {
+    Dentry *dentry = dentry_slot(_inodeNumD, _name);
+    dentry->used = True;
+    dentry->inodeNumD = _inodeNumD;
+    memcpy(dentry->name, _name, sizeof(dentry->name));
+    dentry->inodeNum = _inodeNum;
 }
 
 /**
- * @brief Writes data into double indirect blocks one block at a time.
- * Writes the contents of the given buffer into a double indirect structure,
- * starting at the specified base offset. Internally calls `writeTo_S_IndirectBlocks`
- * to handle the single indirect level.
- * @param[in] _baseOffset Offset to the first usable data block on disk.
- * @param[in] _buffer Pointer to the buffer containing data to be written.
- * @param[in] _dIndirectPtrs Number of blocks to allocate through the double indirect pointer.
+ * @brief Forgets a name in a directory, whether the cache had it as present or absent.
+ * @param[in] _inodeNumD Inode number of the directory.
+ * @param[in] _name Pointer to the name of the file.
  * @return void
- * @date 2010-04-12 First implementation.
+ * @date 2026-10-18 First implementation.
  */
-static void write_to_double_indirect_blocks(unsigned int _baseOffset, void *_buffer,
-                                            unsigned int _dIndirectPtrs) {
-    unsigned int diskOffset;
-    unsigned int indirectBlock[BLOCK_SIZE / 4];
-    void *buffer = _buffer;
-    unsigned int dIndirectPtrs = _dIndirectPtrs;
-    fseek(fsm->diskHandle, _baseOffset, SEEK_SET);
-    fread(&indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-    // write to each of the sIndirectPtrs blocks
-    for (unsigned int i = 0; i < PTRS_PER_BLOCK; i++) {
-        diskOffset = indirectBlock[i];
-        if (is_null(diskOffset)) {
-            break;
-        } else {
-            // write a sindirect block at a time
-            if (dIndirectPtrs - S_INDIRECT_BLOCKS > 0) {
-                write_to_single_indirect_blocks(diskOffset, buffer, S_INDIRECT_BLOCKS);
-                buffer = (char *)buffer + BLOCK_SIZE * S_INDIRECT_BLOCKS;
-                dIndirectPtrs -= S_INDIRECT_BLOCKS;
-            }  // end if (dIndirectPtrs - S_INDIRECT_BLOCKS > 0)
-            // write the rest into a sindirect block
-            else if (dIndirectPtrs - S_INDIRECT_BLOCKS == 0) {
-                write_to_single_indirect_blocks(diskOffset, buffer, S_INDIRECT_BLOCKS);
-                buffer = (char *)buffer + BLOCK_SIZE * S_INDIRECT_BLOCKS;
-                dIndirectPtrs -= S_INDIRECT_BLOCKS;
-                break;
-            }  // end else if (dIndirectPtrs - S_INDIRECT_BLOCKS == 0)
-            // write the rest into a sindirect block
-            else {
-                write_to_single_indirect_blocks(diskOffset, buffer, dIndirectPtrs);
-                buffer = (char *)buffer + BLOCK_SIZE * dIndirectPtrs;
-                dIndirectPtrs = 0;
-                break;
-            }  // end else
-        }  // end else
-    }  // end for (i = 0; i < PTRS_PER_BLOCK; i++)
+static void dentry_forget(unsigned int _inodeNumD, const unsigned int *_name) {
+    unsigned int inodeNum;
+    if (dentry_find(_inodeNumD, _name, &inodeNum) == True) {
+        dentry_slot(_inodeNumD, _name)->used = False;
+    }
 }
 
 /**
- * @brief Writes data into single indirect blocks one block at a time.
- * Writes the contents of the provided buffer into a single indirect structure,
- * starting at the specified base offset.
- * @param[in] _baseOffset Offset to the first usable data block on disk.
- * @param[in] _buffer Pointer to the buffer containing data to be written.
- * @param[in] _sIndirectPtrs Number of blocks to allocate through the single indirect pointer.
+ * @brief Forgets every name of a file and, for a directory, every name cached inside it.
+ * @param[in] _inodeNum Inode number of the file or directory.
  * @return void
- * @date 2010-04-12 First implementation.
+ * @date 2026-10-18 First implementation.
  */
-static void write_to_single_indirect_blocks(unsigned int _baseOffset, void *_buffer,
-                                            unsigned int _sIndirectPtrs) {
-    unsigned int diskOffset;
-    unsigned int indirectBlock[BLOCK_SIZE / 4];
-    void *buffer = _buffer;
-    // read the single indirect pointer
-    fseek(fsm->diskHandle, _baseOffset, SEEK_SET);
-    fread(&indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-    // write to each of the sIndirectPtrs blocks
-    for (unsigned int i = 0; i < _sIndirectPtrs; i++) {
-        // get next pointer
-        diskOffset = indirectBlock[i];
-        // if next pointer is unused, break out of loop
-        if (is_null(diskOffset)) {
-            break;
-        } else {
-            fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-            fwrite(buffer, BLOCK_SIZE, 1, fsm->diskHandle);
-            buffer = (char *)buffer + BLOCK_SIZE;  // increment buffer
-        }  // end else
-    }  // end for (i = 0; i < _sIndirectPtrs; i++)
+static void dentry_forget_inode(unsigned int _inodeNum) {
+    for (unsigned int i = 0; i < DENTRY_CACHE_SIZE; i++) {
+        if (dentries[i].inodeNum == _inodeNum || dentries[i].inodeNumD == _inodeNum) {
+            dentries[i].used = False;
+        }
+    }
 }
 
-Bool fs_remove_file(unsigned int _inodeNum, unsigned int _inodeNumD) {
-    // Open file at Inode _inodeNum for reading
-    if (!fs_open_file(_inodeNum, &inode)) {
-        return False;
-    }  // end if (success == False)
-    unsigned int directPtrs[INODE_DIRECT_PTRS];
-    unsigned int sIndirect = inode.sIndirect;
-    unsigned int dIndirect = inode.dIndirect;
-    unsigned int tIndirect = inode.tIndirect;
-    unsigned int fileType = inode.fileType;
-    unsigned int buffer[BLOCK_SIZE / 4];
-    unsigned int sectorNumber, j, diskOffset;
-    memcpy(directPtrs, inode.directPtr, INODE_DIRECT_PTRS * sizeof(unsigned int));
-    // Read data from direct pointers into buffer _buffer
-    for (unsigned int i = 0; i < INODE_DIRECT_PTRS; i++) {
-        diskOffset = directPtrs[i];
-        if (is_not_null(diskOffset)) {
-            if (fileType == 2) {
-                fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-                fread(buffer, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-                for (j = 8; j < BLOCK_SIZE / 4; j += 4) {
-                    if (buffer[j + 3] == 1) {
-                        fs_remove_file(buffer[j + 2], _inodeNum);
-                    }  // end if (buffer[j+3] == 1)
-                }  // end for (j = 8; j < BLOCK_SIZE/4; j += 4)
-            }  // end if (fileType == 2)
-            sectorNumber = diskOffset / BLOCK_SIZE;
-            ssm_deallocate_sectors(sectorNumber);
+/**
+ * @brief Empties the dentry cache, e.g. when another image is made or mounted.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void dentry_forget_all(void) {
+    for (unsigned int i = 0; i < DENTRY_CACHE_SIZE; i++) {
+        dentries[i].used = False;
+    }
+}
+
+/**
+ * @brief Writes an entry into the first free slot of one entry block of a directory.
+ * @param[in] _inodeNumF Inode number of the file to be added.
+ * @param[in] _name Pointer to the name of the file.
+ * @param[in] _diskOffset Disk offset of the entry block.
+ * @param[in] _buffer Buffer of BLOCK_SIZE bytes for the block.
+ * @return True if the block had a free slot, false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool add_file_to_dir_block(unsigned int _inodeNumF, unsigned int *_name,
+                                  unsigned int _diskOffset, unsigned int *_buffer) {
+    disk_read(_buffer, _diskOffset, BLOCK_SIZE);
+    for (unsigned int j = 0; j < BLOCK_SIZE / 4; j += 4) {
+        if (_buffer[j + 3] == 0) {
+            _buffer[j + 3] = 1;
+            _buffer[j] = _name[0];
+            _buffer[j + 1] = _name[1];
+            _buffer[j + 2] = _inodeNumF;
+            dir_entry_offset = _diskOffset + j * 4;
+            disk_write(_buffer, _diskOffset, BLOCK_SIZE);
+            Bool status = fs_close_file();
+            if (status == False) printf("Error closing file\n");
+            return True;
         }
-    }  // end for (i = 0; i < 10; i++)
+    }
+    return False;
+}
 
-    // Read data from single indirect pointer into buffer _buffer
-    remove_file_indirect_blocks(SINGLE, sIndirect, fileType, _inodeNum, _inodeNumD);
-    // Read data from double indirect pointer into buffer _buffer
-    remove_file_indirect_blocks(DOUBLE, dIndirect, fileType, _inodeNum, _inodeNumD);
-    // Read data from triple indirect pointer into buffer _buffer
-    remove_file_indirect_blocks(TRIPLE, tIndirect, fileType, _inodeNum, _inodeNumD);
+/**
+ * @brief Gets the free-slot record of a directory, starting an empty one if it has none.
+ * @param[in] _inodeNumD Inode number of the directory.
+ * @return The directory's record.
+ * @date 2026-10-18 First implementation.
+ */
+static DirSlots *dir_slots_get(unsigned int _inodeNumD) {
+    DirSlots *slots = &dir_slots[_inodeNumD % DIR_SLOT_DIRS];
+    if (slots->used == False || slots->inodeNumD != _inodeNumD) {
+        slots->used = True;
+        slots->inodeNumD = _inodeNumD;
+        slots->block = (unsigned int)(-1);
+        slots->othersFull = False;
+    }
+    return slots;
+}
 
-    // Open inode, assign to success whether opening worked. If inode didn't open, return false
-    if (!fs_open_file(_inodeNum, &inode)) {
-        return False;
-    }  // end if (success == False)
-    // Clear the inode
-    if (inode_init(&inode) == FAILURE) {
-        //@todo do something here
+/**
+ * @brief Finds the free-slot record of a directory.
+ * @param[in] _inodeNumD Inode number of the directory.
+ * @return The directory's record, Null if it has none.
+ * @date 2026-10-18 First implementation.
+ */
+static DirSlots *dir_slots_find(unsigned int _inodeNumD) {
+    DirSlots *slots = &dir_slots[_inodeNumD % DIR_SLOT_DIRS];
+    return slots->used == True && slots->inodeNumD == _inodeNumD ? slots : Null;
+}
+
+/**
+ * @brief Records the block an entry was just written to as the directory's next place to insert.
+ * An entry that needed a new block means every other block was full; one found by a scan says
+ * nothing about the blocks after it.
+ * @param[in] _inodeNumD Inode number of the directory.
+ * @param[in] _entryOffset Disk offset of the entry.
+ * @param[in] _newBlock True if the entry's block was added to the directory for it.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void dir_slots_placed(unsigned int _inodeNumD, unsigned int _entryOffset, Bool _newBlock) {
+    DirSlots *slots = dir_slots_get(_inodeNumD);
+    unsigned int block = _entryOffset - _entryOffset % BLOCK_SIZE;
+    if (_newBlock == True) {
+        slots->othersFull = True;
+    } else if (slots->block != block) {
+        slots->othersFull = False;
+    }
+    slots->block = block;
+}
+
+/**
+ * @brief Records that an entry of a directory's block was cleared, so the block has room.
+ * @param[in] _inodeNumD Inode number of the directory.
+ * @param[in] _diskOffset Disk offset of the entry block.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void dir_slots_freed(unsigned int _inodeNumD, unsigned int _diskOffset) {
+    DirSlots *slots = dir_slots_find(_inodeNumD);
+    if (slots == Null) {
+        return;
+    }
+    if (is_null(slots->block)) {
+        slots->block = _diskOffset;
+    } else if (slots->block != _diskOffset) {
+        // two blocks have room now and only one is remembered
+        slots->othersFull = False;
+    }
+}
+
+/**
+ * @brief Records that an entry block was freed, so it can no longer take entries.
+ * @param[in] _inodeNumD Inode number of the directory.
+ * @param[in] _diskOffset Disk offset of the entry block.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void dir_slots_dropped(unsigned int _inodeNumD, unsigned int _diskOffset) {
+    DirSlots *slots = dir_slots_find(_inodeNumD);
+    if (slots != Null && slots->block == _diskOffset) {
+        slots->block = (unsigned int)(-1);
+    }
+}
+
+/**
+ * @brief Forgets the free-slot record of a directory, e.g. when its blocks are freed.
+ * @param[in] _inodeNumD Inode number of the directory.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void dir_slots_forget(unsigned int _inodeNumD) {
+    DirSlots *slots = dir_slots_find(_inodeNumD);
+    if (slots != Null) {
+        slots->used = False;
     }
-    // Write over inode
-    fseek(fsm->diskHandle, 0, SEEK_SET);
-    inode_write(&inode, _inodeNum, fsm->diskHandle);
-    deallocate_inode(_inodeNum);
-    // Remove the file from its containing directory
-    fs_remove_file_from_dir(_inodeNum, _inodeNumD);
-    // Succeeded so return true
-    return True;
 }
 
 /**
- * @brief Removes indirect pointers associated with a file.
- * Clears indirect block references for a file, starting at the specified disk offset.
- * @param[in] _type the indirect PointerType (SINGLE, DOUBLE, TRIPLE)
- * @param[in] indirect Offset to the first usable data block on disk.
- * @param[in] _fileType Type of the file being removed.
- * @param[in] _inodeNum Inode number of the file.
- * @param[in] _inodeNumD Inode number of the directory containing the file.
+ * @brief Forgets every free-slot record, e.g. when another image is made or mounted.
  * @return void
- * @date 2010-04-12 First implementation.
+ * @date 2026-10-18 First implementation.
  */
-static inline void remove_file_indirect_blocks(PointerType _type, unsigned int indirect,
-                                               unsigned int fileType, unsigned int _inodeNum,
-                                               unsigned int _inodeNumD) {
-    typedef void (*RemoveFunc)(unsigned int, unsigned int, unsigned int);
-
-    RemoveFunc remove_func;
-
-    if (_type == SINGLE) {
-        remove_func = remove_file_single_indirect_blocks;
-    } else if (_type == DOUBLE) {
-        remove_func = remove_file_double_indirect_blocks;
-    } else {
-        remove_func = remove_file_triple_indirect_blocks;
+static void dir_slots_forget_all(void) {
+    for (unsigned int i = 0; i < DIR_SLOT_DIRS; i++) {
+        dir_slots[i].used = False;
     }
+}
 
-    // Read data from single indirect pointer into buffer _buffer
-    unsigned int diskOffset = indirect;
-    if (is_not_null(diskOffset)) {
-        if (fileType == 1) {
-            // If remove directory, pass inodeNumD
-            remove_func(fileType, _inodeNumD, diskOffset);
-        } else if (fileType == 2) {
-            // If remove file, pass inodeNum
-            remove_func(fileType, _inodeNum, diskOffset);
-        }
+/**
+ * @brief Records in a file's inode where its entry is: the directory and the entry's offset.
+ * They go in the last two spare words of the file's slot, past the root of a directory's name
+ * index, so this is only for a file that is not inline.
+ * @param[in] _inodeNumF Inode number of the file.
+ * @param[in] _inodeNumD Inode number of the directory holding the entry.
+ * @param[in] _entryOffset Disk offset of the entry, -1 if it is in an inline directory.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void dir_backref_store(unsigned int _inodeNumF, unsigned int _inodeNumD,
+                              unsigned int _entryOffset) {
+    unsigned int spare[INODE_SIZE / 4];
+    unsigned int words = inode_spare_size() / 4;
+    if (words < 3 || is_null(_entryOffset)) {
+        return;
     }
+    inode_read_spare(_inodeNumF, spare);
+    spare[words - 2] = _inodeNumD;
+    spare[words - 1] = _entryOffset;
+    inode_write_spare(_inodeNumF, spare);
 }
 
 /**
- * @brief Removes triple indirect pointers associated with a file.
- * Clears triple indirect block references for a file, starting at the specified disk offset.
- * @param[in] _fileType Type of the file being removed.
- * @param[in] _inodeNumD Inode number of the directory containing the file.
- * @param[in] _diskOffset Offset to the first usable data block on disk.
- * @return void
- * @date 2010-04-12 First implementation.
+ * @brief Gets the entry a file's inode says it has in a directory.
+ * The entry itself is not checked: it may have been removed, and the spare words of an inline
+ * file hold data instead. A caller looks for the file in that entry's block first and goes
+ * through the directory's other blocks if it is not there.
+ * @param[in] _inodeNumF Inode number of the file.
+ * @param[in] _inodeNumD Inode number of the directory.
+ * @return Disk offset of the entry, -1 if the file has no back-pointer into `_inodeNumD`.
+ * @date 2026-10-18 First implementation.
  */
-static void remove_file_triple_indirect_blocks(unsigned int _fileType, unsigned int _inodeNumD,
-                                               unsigned int _diskOffset) {
-    unsigned int indirectBlock[BLOCK_SIZE / 4];
-    unsigned int diskOffset = _diskOffset;
-    // Read disk to indirectBlock
-    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-    fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-    // Deallocate Double indirect blocks
-    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
-        if (is_not_null(indirectBlock[i])) {
-            diskOffset = indirectBlock[i];
-            remove_file_double_indirect_blocks(_fileType, _inodeNumD, diskOffset);
-        }
-    }  // for (i = 0; i < BLOCK_SIZE/4; i++)
-    // Deallocate T indirect block
-    diskOffset = _diskOffset;
-    unsigned int sectorNumber = diskOffset / BLOCK_SIZE;
-    ssm_deallocate_sectors(sectorNumber);
+static unsigned int dir_backref_find(unsigned int _inodeNumF, unsigned int _inodeNumD) {
+    unsigned int spare[INODE_SIZE / 4];
+    unsigned int words = inode_spare_size() / 4;
+    if (words < 3) {
+        return (unsigned int)(-1);
+    }
+    inode_read_spare(_inodeNumF, spare);
+    if (spare[words - 2] != _inodeNumD || spare[words - 1] % DIR_ENTRY_SIZE != 0) {
+        return (unsigned int)(-1);
+    }
+    return spare[words - 1];
 }
 
 /**
- * @brief Removes double indirect pointers associated with a file.
- * Clears double indirect block references for a file, starting at the specified disk offset.
- * @param[in] _fileType Type of the file being removed.
- * @param[in] _inodeNumD Inode number of the directory containing the file.
- * @param[in] _diskOffset Offset to the first usable data block on disk.
- * @return void
- * @date 2010-04-12 First implementation.
+ * @brief Verify if an entry block is to be searched for the entry being removed or renamed.
+ * @param[in] _diskOffset Disk offset of the entry block.
+ * @return True if no block is hinted or `_diskOffset` holds `dir_entry_hint`; false otherwise.
+ * @date 2026-10-18 First implementation.
  */
-static void remove_file_double_indirect_blocks(unsigned int _fileType, unsigned int _inodeNumD,
-                                               unsigned int _diskOffset) {
-    unsigned int indirectBlock[BLOCK_SIZE / 4];
-    unsigned int diskOffset = _diskOffset;
-    // Read disk to indirectBlock
-    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-    fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-    // Remove all the Single indirect pointers
-    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
-        if (is_not_null(indirectBlock[i])) {
-            diskOffset = indirectBlock[i];
-            remove_file_single_indirect_blocks(_fileType, _inodeNumD, diskOffset);
-        }
-    }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
-    // Deallocate D indirect block
-    diskOffset = _diskOffset;
-    unsigned int sectorNumber = diskOffset / BLOCK_SIZE;
-    ssm_deallocate_sectors(sectorNumber);
+static Bool dir_block_hinted(unsigned int _diskOffset) {
+    if (is_null(dir_entry_hint)) {
+        return True;
+    }
+    return _diskOffset == dir_entry_hint - dir_entry_hint % BLOCK_SIZE ? True : False;
+}
+
+unsigned int fs_lookup(unsigned int _inodeNumD, const unsigned int *_name) {
+    unsigned int inodeNum;
+    if (dentry_find(_inodeNumD, _name, &inodeNum) == True) {
+        return inodeNum;
+    }
+    if (!fs_open_file(_inodeNumD, &inode) || inode.fileType != 2) {
+        return (unsigned int)(-1);
+    }
+    inodeNum = dir_lookup(_inodeNumD, _name);
+    dentry_store(_inodeNumD, _name, inodeNum);
+    return inodeNum;
 }
 
 /**
- * @brief Removes single indirect pointers associated with a file.
- * Clears single indirect block references for a file, starting at the specified disk offset.
- * @param[in] _fileType Type of the file being removed.
- * @param[in] _inodeNumD Inode number of the directory containing the file.
- * @param[in] _diskOffset Offset to the first usable data block on disk.
- * @return void
- * @date 2010-04-12 First implementation.
+ * @brief Walks a path from a directory, following the symbolic links met on the way.
+ * A link's target is read with `fs_read_link`; an absolute target is walked from the root
+ * directory, a relative one from the directory that holds the link.
+ * @param[in] _inodeNumD Inode number of the directory a relative path starts from.
+ * @param[in] _path Path to walk.
+ * @param[in,out] _hops Links followed so far, shared by the nested walks of link targets.
+ * @return Inode number of the file, -1 if a component is missing, too long or not a directory,
+ * or if more than SYMLINK_MAX_HOPS links were followed.
+ * @date 2026-10-18 First implementation.
  */
-static void remove_file_single_indirect_blocks(unsigned int _fileType, unsigned int _inodeNumD,
-                                               unsigned int _diskOffset) {
-    unsigned int indirectBlock[BLOCK_SIZE / 4];
-    unsigned int diskOffset = _diskOffset;
-    unsigned int buffer[BLOCK_SIZE / 4];
-    unsigned int sectorNumber, j;
-    // Read disk to indirectBlock
-    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-    fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
-    // Deallocate all Single Indirect Blocks
-    for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
-        if (is_not_null(indirectBlock[i])) {
-            diskOffset = indirectBlock[i];
-            // Deallocate Data Blocks
-            if (_fileType == 2) {
-                fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-                fread(buffer, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-                for (j = 8; j < BLOCK_SIZE / 4; j += 4) {
-                    if (buffer[j + 3] == 1) {
-                        fs_remove_file(buffer[j + 2], _inodeNumD);
-                    }  // end if (buffer[j+3] == 1)
-                }  // end for (j = 8; j < BLOCK_SIZE/4; j += 4)
-            }  // end if (_fileType == 2)
-            sectorNumber = diskOffset / BLOCK_SIZE;
-            ssm_deallocate_sectors(sectorNumber);
+static unsigned int resolve_from(unsigned int _inodeNumD, const char *_path, unsigned int *_hops) {
+    unsigned int inodeNum = *_path == '/' ? ROOT_DIR_INODE : _inodeNumD;
+    unsigned int name[2];
+    char target[MAX_BLOCK_SIZE + 1];
+    while (*_path != '\0') {
+        if (*_path == '/') {
+            _path++;
+            continue;
         }
-    }  // end for (i = 0; i < BLOCK_SIZE/4; i++)
-    // Deallocate S indirect block
-    diskOffset = _diskOffset;
-    sectorNumber = diskOffset / BLOCK_SIZE;
-    ssm_deallocate_sectors(sectorNumber);
+        size_t length = strcspn(_path, "/");
+        if (length > sizeof(name)) {
+            return (unsigned int)(-1);
+        }
+        memset(name, 0, sizeof(name));
+        memcpy(name, _path, length);
+        unsigned int inodeNumD = inodeNum;
+        inodeNum = fs_lookup(inodeNumD, name);
+        if (is_null(inodeNum) || !fs_open_file(inodeNum, &inode)) {
+            return (unsigned int)(-1);
+        }
+        if (inode.fileType == 3) {
+            // a loop of links ends here instead of walking forever
+            if (++*_hops > SYMLINK_MAX_HOPS ||
+                fs_read_link(inodeNum, target, sizeof(target)) == False) {
+                return (unsigned int)(-1);
+            }
+            inodeNum = resolve_from(inodeNumD, target, _hops);
+            if (is_null(inodeNum)) {
+                return (unsigned int)(-1);
+            }
+        }
+        _path += length;
+    }
+    return inodeNum;
+}
+
+unsigned int fs_resolve(const char *_path) {
+    unsigned int hops = 0;
+    return resolve_from(ROOT_DIR_INODE, _path, &hops);
 }
 
 Bool fs_rename_file(unsigned int _inodeNumF, unsigned int *_name, unsigned int _inodeNumD) {
-    Bool success;
-    unsigned int j, diskOffset;
-    unsigned int buffer[BLOCK_SIZE / 4];
+    Bool success = False;
+    unsigned int j;
+    // the file's old name goes away and the new one may have been cached as absent
+    dentry_forget_inode(_inodeNumF);
+    dentry_forget(_inodeNumD, _name);
     // Attempt to open directory
     if (fs_open_file(_inodeNumD, &inode)) {
-        if (inode.fileType == 2) {
-            for (unsigned int i = 0; i < 10; i++) {
-                if (is_not_null(inode.directPtr[i])) {
-                    diskOffset = inode.directPtr[i];
-                    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-
-                    fread(buffer, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-                    for (j = 0; j < BLOCK_SIZE / 4; j += 4) {
-                        if (buffer[j + 3] == 1 && buffer[j + 2] == _inodeNumF) {
-                            buffer[j] = _name[0];
-                            buffer[j + 1] = _name[1];
-                            fseek(fsm->diskHandle, 0, SEEK_SET);
-                            fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-                            fwrite(buffer, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
-                            return True;
-                        }  // end if (buffer[j+3] == 1 && buffer[j+2] == _inodeNumF)
-                    }  // end for (j = 0; j < BLOCK_SIZE/4; j += 4)
-                }
-            }  // end for (i = 0; i < 10; i++)
-            // Rename all the Single Indirect blocks
-            if (is_not_null(inode.sIndirect)) {
-                success = rename_file_in_single_indirect(_inodeNumF, _name, inode.sIndirect);
-                if (success == True) {
+        if (inode.fileType == 2 && is_inline(&inode)) {
+            // Rename the entry in the inode
+            unsigned int entries[INODE_SIZE / 4];
+            inode_read_inline(&inode, _inodeNumD, entries);
+            for (j = 0; j < inode.fileSize / 4; j += 4) {
+                if (entries[j + 3] == 1 && entries[j + 2] == _inodeNumF) {
+                    entries[j] = _name[0];
+                    entries[j + 1] = _name[1];
+                    inode_write_inline(&inode, _inodeNumD, entries);
                     return True;
-                }  // end if (success == True)
+                }
             }
-            // Rename all Double Indirect block references
-            if (is_not_null(inode.dIndirect)) {
-                success = rename_file_in_double_indirect(_inodeNumF, _name, inode.dIndirect);
-                if (success == True) {
-                    return True;
-                }  // end if (success == True)
+            return False;
+        }
+        if (inode.fileType == 2) {
+            // Only the block the file's back-pointer names is read, unless the entry is not there
+            dir_entry_hint = dir_backref_find(_inodeNumF, _inodeNumD);
+            if (is_not_null(dir_entry_hint)) {
+                success = rename_file_in_dir_blocks(_inodeNumF, _name);
             }
-            // Rename all Triple Indirect block references
-            if (is_not_null(inode.tIndirect)) {
-                success = rename_file_in_triple_indirect(_inodeNumF, _name, inode.tIndirect);
-                if (success == True) {
-                    return True;
-                }  // end if (success == True)
+            dir_entry_hint = (unsigned int)(-1);
+            if (success == False) {
+                success = rename_file_in_dir_blocks(_inodeNumF, _name);
             }
         }  // end if (inode.fileType == 2)
     }  // end if (success == True)
+    return success;
+}
+
+/**
+ * @brief Renames a file's entry in the entry blocks of the open directory (`inode`).
+ * The direct blocks are searched first, then the indirect ones; only the block of
+ * `dir_entry_hint` is searched when it is set.
+ * @param[in] _inodeNumF Inode number of the file to rename.
+ * @param[in] _name Pointer to the new name for the file.
+ * @return True if the entry was renamed, false if it was not found.
+ * @date 2010-04-12 First implementation.
+ */
+static Bool rename_file_in_dir_blocks(unsigned int _inodeNumF, unsigned int *_name) {
+    Bool success;
+    unsigned int j, diskOffset;
+    unsigned int buffer[BLOCK_SIZE / 4];
+    for (unsigned int i = 0; i < 10; i++) {
+        if (is_not_null(inode.directPtr[i]) && dir_block_hinted(inode.directPtr[i])) {
+            diskOffset = inode.directPtr[i];
+            disk_read(buffer, diskOffset, BLOCK_SIZE);
+            for (j = 0; j < BLOCK_SIZE / 4; j += 4) {
+                if (buffer[j + 3] == 1 && buffer[j + 2] == _inodeNumF) {
+                    dir_index_delete(&buffer[j], diskOffset + j * 4);
+                    buffer[j] = _name[0];
+                    buffer[j + 1] = _name[1];
+                    disk_write(buffer, diskOffset, BLOCK_SIZE);
+                    dir_index_insert(_name, diskOffset + j * 4);
+                    return True;
+                }  // end if (buffer[j+3] == 1 && buffer[j+2] == _inodeNumF)
+            }  // end for (j = 0; j < BLOCK_SIZE/4; j += 4)
+        }
+    }  // end for (i = 0; i < 10; i++)
+    // Rename all the Single Indirect blocks
+    if (is_not_null(inode.sIndirect)) {
+        success = rename_file_in_single_indirect(_inodeNumF, _name, inode.sIndirect);
+        if (success == True) {
+            return True;
+        }  // end if (success == True)
+    }
+    // Rename all Double Indirect block references
+    if (is_not_null(inode.dIndirect)) {
+        success = rename_file_in_double_indirect(_inodeNumF, _name, inode.dIndirect);
+        if (success == True) {
+            return True;
+        }  // end if (success == True)
+    }
+    // Rename all Triple Indirect block references
+    if (is_not_null(inode.tIndirect)) {
+        success = rename_file_in_triple_indirect(_inodeNumF, _name, inode.tIndirect);
+        if (success == True) {
+            return True;
+        }  // end if (success == True)
+    }
     // Returns false if none of the renames successful
     return False;
 }
@@ -1775,8 +4594,7 @@ static Bool rename_file_in_triple_indirect(unsigned int _inodeNumF, unsigned int
     unsigned int diskOffset = _tIndirectOffset;
     Bool success;
     // Read disk to indirectBlock
-    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-    fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
+    disk_read(indirectBlock, diskOffset, BLOCK_SIZE);
     // Loop through indirect block, follow the Double indirect pointers
     for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
         if (is_not_null(indirectBlock[i])) {
@@ -1807,8 +4625,7 @@ static Bool rename_file_in_double_indirect(unsigned int _inodeNumF, unsigned int
     unsigned int diskOffset = _dIndirectOffset;
     Bool success;
     // Read disk to indirectBlock
-    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-    fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
+    disk_read(indirectBlock, diskOffset, BLOCK_SIZE);
     // Loop through indirect block, follow the Single indirect pointers
     for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
         if (is_not_null(indirectBlock[i])) {
@@ -1839,25 +4656,22 @@ static Bool rename_file_in_single_indirect(unsigned int _inodeNumF, unsigned int
     unsigned int diskOffset = _sIndirectOffset;
     unsigned int buffer[BLOCK_SIZE / 4];
     // Read disk to indirectBlock
-    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-    fread(indirectBlock, BLOCK_SIZE, 1, fsm->diskHandle);
+    disk_read(indirectBlock, diskOffset, BLOCK_SIZE);
     unsigned int j;
     // Loop through indirect blocks
     for (unsigned int i = 0; i < BLOCK_SIZE / 4; i++) {
-        if (is_not_null(indirectBlock[i])) {
+        if (is_not_null(indirectBlock[i]) && dir_block_hinted(indirectBlock[i])) {
             diskOffset = indirectBlock[i];
-            fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-            fread(buffer, BLOCK_SIZE, 1, fsm->diskHandle);
+            disk_read(buffer, diskOffset, BLOCK_SIZE);
             // Go through buffer, find name portion
             for (j = 0; j < BLOCK_SIZE / 4; j += 4) {
                 if (buffer[j + 3] == 1 && buffer[j + 2] == _inodeNumF) {
                     // Write name to data
+                    dir_index_delete(&buffer[j], diskOffset + j * 4);
                     buffer[j] = _name[0];
                     buffer[j + 1] = _name[1];
-                    fseek(fsm->diskHandle, 0, SEEK_SET);
-                    fseek(fsm->diskHandle, diskOffset, SEEK_SET);
-
-                    fwrite(buffer, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
+                    disk_write(buffer, diskOffset, BLOCK_SIZE);
+                    dir_index_insert(_name, diskOffset + j * 4);
                     return True;
                 }  // end if (buffer[j+3] == 1 && buffer[j+2] == _inodeNumF)
             }  // end for (j = 0; j < BLOCK_SIZE/4; j += 4)
@@ -1867,45 +4681,214 @@ static Bool rename_file_in_single_indirect(unsigned int _inodeNumF, unsigned int
     return False;
 }
 
+Bool fs_link(unsigned int _inodeNumF, unsigned int *_name, unsigned int _inodeNumD) {
+    // Directories cannot be linked, their entries would form cycles
+    if (!fs_open_file(_inodeNumF, &inode) || inode.fileType == 2) {
+        return False;
+    }
+    // files made before links were counted have a count of 0 for their one name
+    unsigned int linkCount = inode.linkCount == 0 ? 1 : inode.linkCount;
+    Bool isInline = is_inline(&inode);
+    inode.linkCount = linkCount + 1;
+    inode_write(&inode, _inodeNumF);
+    if (create_file(_inodeNumF, _name, _inodeNumD) == False) {
+        if (fs_open_file(_inodeNumF, &inode)) {
+            inode.linkCount = linkCount;
+            inode_write(&inode, _inodeNumF);
+        }
+        return False;
+    }
+    // the newest name is the one the file's back-pointer leads to
+    if (isInline == False) {
+        dir_backref_store(_inodeNumF, _inodeNumD, dir_entry_offset);
+    }
+    return True;
+}
+
+unsigned int fs_symlink(const char *_target, unsigned int *_name, unsigned int _inodeNumD) {
+    size_t length = strlen(_target);
+    if (length == 0 || length > BLOCK_SIZE) {
+        return (unsigned int)(-1);
+    }
+    unsigned int inodeNum = fs_create_file(0, _name, _inodeNumD);
+    if (!fs_open_file(inodeNum, &inode)) {
+        return (unsigned int)(-1);
+    }
+    inode.fileType = 3;  // type 3 is symbolic link
+    Bool status;
+    // A short target is kept in the inode, so following the link reads no data block
+    if (length <= inode_inline_capacity()) {
+        status = write_inline(inodeNum, _target, (unsigned int)length);
+    } else {
+        inode_write(&inode, inodeNum);
+        unsigned char block[MAX_BLOCK_SIZE];
+        memset(block, 0, sizeof(block));
+        memcpy(block, _target, length);
+        status = fs_write_to_file(inodeNum, block, (long long int)length);
+    }
+    // a link whose target was not stored goes away again
+    if (status == False) {
+        fs_remove_file(inodeNum, _inodeNumD);
+        return (unsigned int)(-1);
+    }
+    return inodeNum;
+}
+
+Bool fs_read_link(unsigned int _inodeNum, char *_target, unsigned int _size) {
+    if (!fs_open_file(_inodeNum, &inode) || inode.fileType != 3 || inode.fileSize >= _size) {
+        return False;
+    }
+    unsigned char block[MAX_BLOCK_SIZE];
+    unsigned int length = inode.fileSize;
+    if (fs_read_from_file(_inodeNum, block) == False) {
+        return False;
+    }
+    memcpy(_target, block, length);
+    _target[length] = '\0';
+    return True;
+}
+
 Bool fs_make(unsigned int _DISK_SIZE, unsigned int _BLOCK_SIZE, unsigned int _INODE_SIZE,
              unsigned int _INODE_BLOCKS, unsigned int _INODE_COUNT, int _initSsmMaps) {
     init_fsm_constants(_DISK_SIZE, _BLOCK_SIZE, _INODE_SIZE, _INODE_BLOCKS, _INODE_COUNT);
+    block_map_invalidate_all();
+    dentry_forget_all();
+    dir_slots_forget_all();
+    // Open the disk image through the configured backend
+    if (!disk_open(HARD_DISK, fsm->diskMode)) {
+        printf("Error opening disk image %s\n", HARD_DISK);
+    }
+    // Maps kept in the image go right after the inode table
+    unsigned int mapsOffset = 0;
+    if (fsm->embeddedMaps == True) {
+        mapsOffset = (2 + INODE_BLOCKS / INODE_CHUNK_BLOCKS * INODE_CHUNK_BLOCKS) * BLOCK_SIZE;
+    }
+    place_maps(mapsOffset);
+    // A RAM disk or an image holding its maps starts out blank, there are no SSM maps to keep
+    if (disk->mode == DISK_RAM || mapsOffset != 0) _initSsmMaps = 1;
     init_fsm_maps();
     init_file_sector_mgr(_initSsmMaps);
     // Allocate the boot and super block sectors on disk
     ssm_allocate_sectors(2);
     // Create INODE_COUNT Inodes
-    int factorsOf_32 = INODE_BLOCKS / 32;
+    unsigned int factorsOf_32 = INODE_BLOCKS / INODE_CHUNK_BLOCKS;
     // int remainder = INODE_BLOCKS % 32;
+    superblock_format(factorsOf_32, mapsOffset, fsm->lazyInodes);
     // get 32 sectors at a time and make them inode sectors
     unsigned int diskOffset;
-    for (int i = 0; i < factorsOf_32; i++) {
-        diskOffset = ssm_allocate_sectors(32);
+    for (unsigned int i = 0; i < factorsOf_32; i++) {
+        diskOffset = ssm_allocate_sectors(INODE_CHUNK_BLOCKS);
+        // with lazy inodes the chunk is written when first used
+        if (fsm->lazyInodes == True) continue;
         // take the 32 sectors and make inodes
-        inode_make(32, fsm->diskHandle, diskOffset);
+        inode_make(INODE_CHUNK_BLOCKS, diskOffset);
+        superblock_chunk_set_ready(i);
     }  // end for (i = 0; i < factorsOf_32; i++)
+    // Reserve the sectors holding the maps
+    if (mapsOffset != 0 && ssm_allocate_sectors((int)maps_blocks()) != mapsOffset) {
+        printf("Error reserving the map sectors\n");
+    }
     unsigned int name[2];
     // Set inode 0 for boot sector
     fs_create_file(0, name, (unsigned int)(-1));
     if (!fs_open_file(0, &inode))
         printf("Corruption during file system creation");  // Failed to open inode 0
     inode.directPtr[0] = 0;
-    inode_write(&inode, 0, fsm->diskHandle);
+    inode_write(&inode, 0);
     // Set inode 1 for super block
     fs_create_file(0, name, (unsigned int)(-1));
     if (!fs_open_file(1, &inode))
         printf("Corruption during file system creation");  // Failed to open inode 0
     inode.directPtr[0] = BLOCK_SIZE * (1);
-    inode_write(&inode, 1, fsm->diskHandle);
+    inode_write(&inode, 1);
     // make root directory with inode 2
     fs_create_file(1, name, (unsigned int)(-1));
     return True;
 }
 
+Bool fs_mount(void) {
+    block_map_invalidate_all();
+    dentry_forget_all();
+    dir_slots_forget_all();
+    // a RAM disk keeps nothing between runs; it is brought back with fs_load_snapshot
+    if (fsm->diskMode == DISK_RAM) {
+        return False;
+    }
+    // The geometry is in the super block, which sits one block into the image; look for it
+    // through plain stdio before the backend is sized for a block size
+    if (!disk_open(HARD_DISK, DISK_STDIO)) {
+        printf("Error opening disk image %s\n", HARD_DISK);
+        return False;
+    }
+    Bool found = superblock_find();
+    disk_close();
+    if (found == False) {
+        return False;
+    }
+    init_fsm_constants(superblock.diskSize, superblock.blockSize, superblock.inodeSize,
+                       superblock.inodeBlocks, superblock.inodeCount);
+    if (!disk_open(HARD_DISK, fsm->diskMode)) {
+        printf("Error opening disk image %s\n", HARD_DISK);
+        return False;
+    }
+    // Load the maps, the super block and (if resident) the inode table as they are on disk
+    init_file_sector_mgr(0);
+    return superblock.magic == SUPERBLOCK_MAGIC ? True : False;
+}
+
 Bool fs_remove(void) {
-    if (fsm->diskHandle) {
-        fclose(fsm->diskHandle);
-        fsm->diskHandle = Null;
+    block_map_invalidate_all();
+    dentry_forget_all();
+    dir_slots_forget_all();
+    Bool status = inode_table_unload();
+    return disk_close() && status;
+}
+
+Bool fs_set_disk_mode(DiskMode _mode) {
+    if (_mode != DISK_STDIO && _mode != DISK_MMAP && _mode != DISK_URING && _mode != DISK_DIRECT &&
+        _mode != DISK_RAM) {
+        return False;
+    }
+    fsm->diskMode = _mode;
+    return True;
+}
+
+void fs_set_resident_inodes(Bool _resident) { fsm->residentInodes = _resident; }
+
+void fs_set_inline_data(Bool _inline) { fsm->inlineData = _inline; }
+
+void fs_set_extent_files(Bool _extents) { fsm->extentFiles = _extents; }
+
+void fs_set_lazy_inodes(Bool _lazy) { fsm->lazyInodes = _lazy; }
+
+void fs_set_embedded_maps(Bool _embedded) { fsm->embeddedMaps = _embedded; }
+
+void fs_set_sparse_files(Bool _sparse) { fsm->sparseFiles = _sparse; }
+
+void fs_set_dir_index(Bool _index) { fsm->dirIndex = _index; }
+
+unsigned int fs_init_inodes(unsigned int _chunks) { return inode_chunks_init(_chunks); }
+
+Bool fs_sync(void) {
+    Bool status = inode_table_flush();
+    return disk_sync() && status;
+}
+
+Bool fs_snapshot(const char *_path) {
+    if (inode_table_flush() == False) {
+        return False;
+    }
+    return disk_snapshot(_path);
+}
+
+Bool fs_load_snapshot(const char *_path) {
+    if (disk_restore(_path) == False) {
+        return False;
     }
+    // Reload the SSM maps and the iMap that came with the snapshot
+    block_map_invalidate_all();
+    dentry_forget_all();
+    dir_slots_forget_all();
+    init_file_sector_mgr(0);
     return True;
 }
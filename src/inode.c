@@ -5,12 +5,16 @@
 #include "inode.h"
 
 #include <math.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "config.h"
+#include "disk.h"
 #include "fsm_constants.h"
 #include "global_constants.h"
+#include "superblock.h"
 
 Inode inode = {.dataBlocks = 0,
                .dIndirect = 0,
@@ -24,10 +28,15 @@ Inode inode = {.dataBlocks = 0,
                .status = 0,
                .tIndirect = 0};
 
-InodeMap inode_map = {.id = 0, .iMap = {0}, .iMapHandle = NULL, .iMapOffset = {0, 0}};
+InodeMap inode_map = {.id = 0, .iMap = {0}, .iMapOffset = {0, 0}};
+
+InodeTable inode_table = {.inodes = NULL, .dirty = NULL, .count = 0};
 
 //========================= FSM FUNCTION PROTOTYPES =======================//
 static Bool is_not_null(unsigned int _ptr);
+static void inode_table_release(void);
+static void inode_chunk_prepare(unsigned int _inodeNum);
+static void inode_chunk_init(unsigned int _chunk);
 
 //========================= FSM FUNCTION DEFINITIONS =======================//
 /**
@@ -60,7 +69,7 @@ int inode_init(Inode *_inode) {
     return inode_init_ptrs(_inode);
 }
 
-void inode_make(unsigned int _count, FILE *_fileStream, unsigned int _diskOffset) {
+void inode_make(unsigned int _count, unsigned int _diskOffset) {
     // before writing default iNodes, store values in a buffer
     unsigned int buffer[_count][32];
     typedef unsigned int UI;
@@ -76,68 +85,198 @@ void inode_make(unsigned int _count, FILE *_fileStream, unsigned int _diskOffset
                                 (UI)-3, (UI)-3, (UI)-3, (UI)-3},
                sizeof(unsigned int) * 12);
     }  // end for (i = 0; i < _count; i++)
-    // locate the requested offset within the disk file
-    if (fseek(_fileStream, _diskOffset, SEEK_SET) != SUCCESS) {
-        // @todo do something here
-    }
     // write the array of iNodes to the disk file
-    unsigned int len = _count * 32;
-    if (fwrite(buffer, sizeof(unsigned int), len, _fileStream) != len) {
+    if (disk_write(buffer, _diskOffset, _count * 32 * sizeof(unsigned int)) == False) {
         // @todo something here
     }
-    // move to the beginning of the disk file
-    if (fseek(_fileStream, 0, SEEK_SET) != SUCCESS) {
-        // @todo something here
+    // keep a resident table in step with the part of it just written
+    if (inode_table.inodes != NULL) {
+        unsigned int tableOffset = 2 * BLOCK_SIZE;
+        unsigned int tableEnd = tableOffset + inode_table.count * INODE_SIZE;
+        unsigned int end = _diskOffset + _count * 32 * sizeof(unsigned int);
+        unsigned int first = _diskOffset > tableOffset ? _diskOffset : tableOffset;
+        unsigned int last = end < tableEnd ? end : tableEnd;
+        if (first < last) {
+            memcpy(inode_table.inodes + (first - tableOffset),
+                   (unsigned char *)buffer + (first - _diskOffset), last - first);
+        }
     }
 }
 
-void inode_read(Inode *_inode, unsigned int _inodeNum, FILE *_fileStream) {
+void inode_read(Inode *_inode, unsigned int _inodeNum) {
+    inode_chunk_prepare(_inodeNum);
+    // a resident table serves the inode from memory
+    if (inode_table.inodes != NULL && _inodeNum < inode_table.count) {
+        memcpy(_inode, inode_table.inodes + (size_t)_inodeNum * INODE_SIZE, sizeof(Inode));
+        return;
+    }
     // array buffer to hold values from the iNode buffer passed into function
     Inode buffer;
     // will need to determine an offset from the first iNode to the iNode we want to read from
     // generate the offset based on the size of the block, size of the iNode
     // and the iNode number in which we will read from
     int offset = (2 * BLOCK_SIZE) + (_inodeNum * INODE_SIZE);
-    // move to the offset location of the filestream
-    if (fseek(_fileStream, offset, SEEK_SET) != SUCCESS) {
-        // @todo do something here
-    }
-    // read the offset location in the filestream
-    size_t res = fread(&buffer, sizeof(Inode), 1, _fileStream);
-    if (res == 0) {
+    // read the offset location in the disk image
+    if (disk_read(&buffer, offset, sizeof(Inode)) == False) {
         printf("Error reading inode %d from file stream.\n", _inodeNum);
         return;
     }
-    // move to the start of the filestream
-    if (fseek(_fileStream, 0, SEEK_SET) != SUCCESS) {
-        // @todo do something here
-    }
     // store buffer for:
     // fileType, fileSize, permissions, linkCount, dataBlocks, owner,
     // status, directPtr[10], sIndirect, dIndirect, tIndirect
     memcpy(_inode, &buffer, sizeof(Inode));
 }
 
-void inode_write(Inode *_inode, unsigned int _inodeNum, FILE *_fileStream) {
+void inode_write(Inode *_inode, unsigned int _inodeNum) {
+    inode_chunk_prepare(_inodeNum);
+    // a resident table takes the inode and writes it back on the next flush
+    if (inode_table.inodes != NULL && _inodeNum < inode_table.count) {
+        memcpy(inode_table.inodes + (size_t)_inodeNum * INODE_SIZE, _inode, sizeof(Inode));
+        inode_table.dirty[_inodeNum / BITS_PER_BYTE] |= 1u << (_inodeNum % BITS_PER_BYTE);
+        return;
+    }
     // will need to determine an offset from the first iNode to the iNode we want to write to
     // generate the offset based on the size of the block, size of the iNode
     // and the iNode number in which we will write to
     int offset = (2 * BLOCK_SIZE) + (_inodeNum * INODE_SIZE);
-    // move to the offset location of the filestream
-    if (fseek(_fileStream, offset, SEEK_SET) != SUCCESS) {
+    // write to the offset location in the disk image
+    if (disk_write(_inode, offset, sizeof(Inode)) == False) {
         // @todo do something here
     }
-    // write to the offset location in the filestream
-    unsigned int len = 1;
-    if (fwrite(_inode, sizeof(Inode), len, _fileStream) != len) {
+}
+
+unsigned int inode_inline_capacity(void) {
+    return INODE_SIZE - (unsigned int)offsetof(Inode, directPtr);
+}
+
+void inode_read_inline(const Inode *_inode, unsigned int _inodeNum, void *_data) {
+    // the pointer words hold the start of the data
+    unsigned int head = sizeof(Inode) - offsetof(Inode, directPtr);
+    memcpy(_data, _inode->directPtr, head);
+    // the spare bytes past the inode struct hold the rest
+    unsigned int spare = INODE_SIZE - sizeof(Inode);
+    unsigned char *rest = (unsigned char *)_data + head;
+    if (inode_table.inodes != NULL && _inodeNum < inode_table.count) {
+        memcpy(rest, inode_table.inodes + (size_t)_inodeNum * INODE_SIZE + sizeof(Inode), spare);
+        return;
+    }
+    int offset = (2 * BLOCK_SIZE) + (_inodeNum * INODE_SIZE) + sizeof(Inode);
+    if (disk_read(rest, offset, spare) == False) {
+        printf("Error reading inline data of inode %d.\n", _inodeNum);
+    }
+}
+
+void inode_write_inline(Inode *_inode, unsigned int _inodeNum, const void *_data) {
+    unsigned int head = sizeof(Inode) - offsetof(Inode, directPtr);
+    memcpy(_inode->directPtr, _data, head);
+    inode_write(_inode, _inodeNum);
+    unsigned int spare = INODE_SIZE - sizeof(Inode);
+    const unsigned char *rest = (const unsigned char *)_data + head;
+    if (inode_table.inodes != NULL && _inodeNum < inode_table.count) {
+        memcpy(inode_table.inodes + (size_t)_inodeNum * INODE_SIZE + sizeof(Inode), rest, spare);
+        return;
+    }
+    int offset = (2 * BLOCK_SIZE) + (_inodeNum * INODE_SIZE) + sizeof(Inode);
+    if (disk_write(rest, offset, spare) == False) {
         // @todo do something here
     }
-    // move to the start of the filestream
-    if (fseek(_fileStream, 0, SEEK_SET) != SUCCESS) {
+}
+
+unsigned int inode_spare_size(void) { return INODE_SIZE - sizeof(Inode); }
+
+void inode_read_spare(unsigned int _inodeNum, void *_data) {
+    inode_chunk_prepare(_inodeNum);
+    unsigned int spare = INODE_SIZE - sizeof(Inode);
+    if (inode_table.inodes != NULL && _inodeNum < inode_table.count) {
+        memcpy(_data, inode_table.inodes + (size_t)_inodeNum * INODE_SIZE + sizeof(Inode), spare);
+        return;
+    }
+    int offset = (2 * BLOCK_SIZE) + (_inodeNum * INODE_SIZE) + sizeof(Inode);
+    if (disk_read(_data, offset, spare) == False) {
+        printf("Error reading spare bytes of inode %d.\n", _inodeNum);
+    }
+}
+
+void inode_write_spare(unsigned int _inodeNum, const void *_data) {
+    inode_chunk_prepare(_inodeNum);
+    unsigned int spare = INODE_SIZE - sizeof(Inode);
+    if (inode_table.inodes != NULL && _inodeNum < inode_table.count) {
+        memcpy(inode_table.inodes + (size_t)_inodeNum * INODE_SIZE + sizeof(Inode), _data, spare);
+        inode_table.dirty[_inodeNum / BITS_PER_BYTE] |= 1u << (_inodeNum % BITS_PER_BYTE);
+        return;
+    }
+    int offset = (2 * BLOCK_SIZE) + (_inodeNum * INODE_SIZE) + sizeof(Inode);
+    if (disk_write(_data, offset, spare) == False) {
         // @todo do something here
     }
 }
 
+unsigned int inode_chunks_init(unsigned int _max) {
+    for (unsigned int chunk = 0; chunk < superblock.inodeChunks && _max > 0; chunk++) {
+        if (superblock_chunk_ready(chunk) == False) {
+            inode_chunk_init(chunk);
+            _max--;
+        }
+    }
+    return superblock.pendingChunks;
+}
+
+Bool inode_table_load(void) {
+    inode_table_release();
+    unsigned int count = INODE_COUNT;
+    inode_table.inodes = malloc((size_t)count * INODE_SIZE);
+    inode_table.dirty = calloc((count + BITS_PER_BYTE - 1) / BITS_PER_BYTE, 1);
+    if (inode_table.inodes == NULL || inode_table.dirty == NULL ||
+        disk_read(inode_table.inodes, 2 * BLOCK_SIZE, count * INODE_SIZE) == False) {
+        inode_table_release();
+        return False;
+    }
+    inode_table.count = count;
+    return True;
+}
+
+Bool inode_table_flush(void) {
+    Bool status = True;
+    unsigned int i = 0;
+    while (i < inode_table.count) {
+        if ((inode_table.dirty[i / BITS_PER_BYTE] & (1u << (i % BITS_PER_BYTE))) == 0) {
+            i++;
+            continue;
+        }
+        // extend the run over the dirty inodes that follow
+        unsigned int first = i;
+        while (i < inode_table.count &&
+               (inode_table.dirty[i / BITS_PER_BYTE] & (1u << (i % BITS_PER_BYTE)))) {
+            inode_table.dirty[i / BITS_PER_BYTE] &= ~(1u << (i % BITS_PER_BYTE));
+            i++;
+        }
+        if (disk_write(inode_table.inodes + (size_t)first * INODE_SIZE,
+                       2 * BLOCK_SIZE + first * INODE_SIZE, (i - first) * INODE_SIZE) == False) {
+            status = False;
+        }
+    }
+    return status;
+}
+
+Bool inode_table_unload(void) {
+    Bool status = inode_table_flush();
+    inode_table_release();
+    return status;
+}
+
+/**
+ * @brief Frees the resident inode table without writing it back.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void inode_table_release(void) {
+    free(inode_table.inodes);
+    free(inode_table.dirty);
+    inode_table.inodes = Null;
+    inode_table.dirty = Null;
+    inode_table.count = 0;
+}
+
 Bool allocate_inode(void) {
     if (is_not_null(inode_map.iMapOffset[0])) {
         int bit = inode_map.iMapOffset[1];
@@ -158,15 +297,10 @@ Bool allocate_inode(void) {
     }
     inode_map.iMapOffset[0] = (unsigned int)(-1);
     inode_map.iMapOffset[1] = (unsigned int)(-1);
-    // Write the newly allocated inode to the iMapHandler
-    inode_map.iMapHandle = fopen(FSM_INODE_MAP, "r+");
-    if (fwrite(inode_map.iMap, 1, INODE_BLOCKS, inode_map.iMapHandle) != INODE_BLOCKS) {
-        // @todo do something here
-    }
-    if (fclose(inode_map.iMapHandle) != SUCCESS) {
+    // Store the iMap with the newly allocated inode
+    if (disk_map_write(FSM_INODE_MAP, inode_map.iMap, INODE_BLOCKS) == False) {
         // @todo do something here
     }
-    inode_map.iMapHandle = Null;
     return True;
 }
 
@@ -192,15 +326,10 @@ Bool deallocate_inode(unsigned int _inodeNum) {
     }
     inode_map.iMapOffset[0] = (unsigned int)(-1);
     inode_map.iMapOffset[1] = (unsigned int)(-1);
-    // Write iMap to its Handler
-    inode_map.iMapHandle = fopen(FSM_INODE_MAP, "r+");
-    if (fwrite(inode_map.iMap, 1, INODE_BLOCKS, inode_map.iMapHandle) != INODE_BLOCKS) {
-        // @todo do something here
-    }
-    if (fclose(inode_map.iMapHandle) != SUCCESS) {
+    // Store the updated iMap
+    if (disk_map_write(FSM_INODE_MAP, inode_map.iMap, INODE_BLOCKS) == False) {
         // @todo do something here
     }
-    inode_map.iMapHandle = Null;
     return True;
 }
 
@@ -250,3 +379,27 @@ Bool get_inode(int _n) {
     }  // end if (_n < 33 && _n > 0)
     return False;
 }
+
+/**
+ * @brief Writes the chunk of the inode table holding an inode if it has not been written yet.
+ * @param[in] _inodeNum The index of the inode about to be read or written.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void inode_chunk_prepare(unsigned int _inodeNum) {
+    unsigned int chunk = _inodeNum * INODE_SIZE / (INODE_CHUNK_BLOCKS * BLOCK_SIZE);
+    if (superblock_chunk_ready(chunk) == False) {
+        inode_chunk_init(chunk);
+    }
+}
+
+/**
+ * @brief Writes the default inodes of a chunk of the inode table and records it as written.
+ * @param[in] _chunk Index of the chunk.
+ * @return void
+ * @date 2026-10-18 First implementation.
+ */
+static void inode_chunk_init(unsigned int _chunk) {
+    inode_make(INODE_CHUNK_BLOCKS, 2 * BLOCK_SIZE + _chunk * INODE_CHUNK_BLOCKS * BLOCK_SIZE);
+    superblock_chunk_set_ready(_chunk);
+}
@@ -119,6 +119,9 @@ static void print_inode(void) {
     }  // end if (inode.fileType == 1)
     else if (inode.fileType == 2) {
         printf("-> fileType = DIRECTORY\n");
+    }  // end else if (inode.fileType == 2)
+    else if (inode.fileType == 3) {
+        printf("-> fileType = SYMLINK\n");
     }  // end else
     printf("-> fileSize = %d\n", inode.fileSize);
     printf("-> permissions = %d\n", inode.permissions);
@@ -126,14 +129,27 @@ static void print_inode(void) {
     printf("-> dataBlocks = %d\n", inode.dataBlocks);
     printf("-> owner = %d\n", inode.owner);
     printf("-> status = %d\n\n", inode.status);
-    for (int i = 0; i < 10; i++) {
-        if (inode.directPtr[i] == (unsigned int)(-1)) {
-            printf("-> directPtr[%d] = %d\n", i, inode.directPtr[i]);
-        }  // end if(inode.directPtr[i] = (unsigned int))
-        else {
-            printf("-> directPtr[%d] = %d\n", i, inode.directPtr[i] / BLOCK_SIZE);
-        }  // end else
-    }  // end for (i = 0; i < 10; i++)
+    if ((inode.status & INODE_EXTENTS) != 0) {
+        // the direct pointers hold (first block, disk offset, length) runs and the last one
+        // counts them; runs past INODE_EXTENT_SLOTS are in the block at sIndirect
+        unsigned int count = inode.directPtr[9];
+        printf("-> extents = %d\n", count);
+        for (unsigned int i = 0; i < count && i < INODE_EXTENT_SLOTS; i++) {
+            const unsigned int *run = &inode.directPtr[3 * i];
+            printf("-> extent[%d] = blocks %d-%d at %d\n", i, run[0], run[0] + run[2] - 1,
+                   run[1] / BLOCK_SIZE);
+        }  // end for (i = 0; i < count && i < INODE_EXTENT_SLOTS; i++)
+    }  // end if ((inode.status & INODE_EXTENTS) != 0)
+    else {
+        for (int i = 0; i < 10; i++) {
+            if (inode.directPtr[i] == (unsigned int)(-1)) {
+                printf("-> directPtr[%d] = %d\n", i, inode.directPtr[i]);
+            }  // end if(inode.directPtr[i] = (unsigned int))
+            else {
+                printf("-> directPtr[%d] = %d\n", i, inode.directPtr[i] / BLOCK_SIZE);
+            }  // end else
+        }  // end for (i = 0; i < 10; i++)
+    }  // end else
     if (inode.sIndirect == (unsigned int)(-1)) {
         printf("\n-> sIndirect = %d\n", inode.sIndirect);
     }  // end if if(inode.sIndirect == (unsigned int)(-1)
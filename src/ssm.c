@@ -11,14 +11,13 @@
 #include <string.h>
 
 #include "config.h"
+#include "disk.h"
 #include "fsm_constants.h"
 #include "global_constants.h"
 #include "ssm_constants.h"
 
 //============================== SSM STRUCT =====================================//
 static SSM ssm_instance = {
-    .alocMapHandle = NULL,
-    .freeMapHandle = NULL,
     .alocMap = {0},  // initialize first element with 0 and the rest are implicitly initialized to 0
     .freeMap = {0},  // initialize first element with 0 and the rest are implicitly initialized to 0
     .contSectors = 0,
@@ -48,14 +47,8 @@ void ssm_init(int _init_maps) {
     // assign -1 to all unsigned int in badSector
     memset(ssm->badSector, 0xFF, sizeof(ssm->badSector));
     ssm->fragmented = 0;
-    ssm->alocMapHandle = fopen(SSM_ALLOCATE_MAP, "r+");
-    ssm->freeMapHandle = fopen(SSM_FREE_MAP, "r+");
-    fread(ssm->alocMap, 1, SECTOR_BYTES, ssm->alocMapHandle);
-    fread(ssm->freeMap, 1, SECTOR_BYTES, ssm->freeMapHandle);
-    fclose(ssm->alocMapHandle);
-    fclose(ssm->freeMapHandle);
-    ssm->alocMapHandle = Null;
-    ssm->freeMapHandle = Null;
+    disk_map_read(SSM_ALLOCATE_MAP, ssm->alocMap, SECTOR_BYTES);
+    disk_map_read(SSM_FREE_MAP, ssm->freeMap, SECTOR_BYTES);
 }
 
 /**
@@ -67,15 +60,9 @@ void ssm_init(int _init_maps) {
 static void ssm_init_maps(void) {
     unsigned char map[SECTOR_BYTES];
     memset(map, 0, SECTOR_BYTES);
-    ssm->alocMapHandle = fopen(SSM_ALLOCATE_MAP, "r+");
-    fwrite(map, 1, SECTOR_BYTES, ssm->alocMapHandle);
+    disk_map_write(SSM_ALLOCATE_MAP, map, SECTOR_BYTES);
     memset(map, UINT8_MAX, SECTOR_BYTES);
-    ssm->freeMapHandle = fopen(SSM_FREE_MAP, "r+");
-    fwrite(map, 1, SECTOR_BYTES, ssm->freeMapHandle);
-    fclose(ssm->alocMapHandle);
-    fclose(ssm->freeMapHandle);
-    ssm->alocMapHandle = Null;
-    ssm->freeMapHandle = Null;
+    disk_map_write(SSM_FREE_MAP, map, SECTOR_BYTES);
 }
 
 unsigned int ssm_allocate_sectors(int _n) {
@@ -101,14 +88,8 @@ unsigned int ssm_allocate_sectors(int _n) {
 
     Bool integrity = check_integrity();
     if (integrity == False) return -1;
-    ssm->alocMapHandle = fopen(SSM_ALLOCATE_MAP, "r+");
-    ssm->freeMapHandle = fopen(SSM_FREE_MAP, "r+");
-    fwrite(ssm->alocMap, 1, SECTOR_BYTES, ssm->alocMapHandle);
-    fwrite(ssm->freeMap, 1, SECTOR_BYTES, ssm->freeMapHandle);
-    fclose(ssm->alocMapHandle);
-    fclose(ssm->freeMapHandle);
-    ssm->alocMapHandle = Null;
-    ssm->freeMapHandle = Null;
+    disk_map_write(SSM_ALLOCATE_MAP, ssm->alocMap, SECTOR_BYTES);
+    disk_map_write(SSM_FREE_MAP, ssm->freeMap, SECTOR_BYTES);
     return ssm_get_sector_offset();
 }
 
@@ -142,14 +123,25 @@ Bool ssm_deallocate_sectors(int _sectorNum) {
     ssm->index[0] = (unsigned int)(-1);
     ssm->index[1] = (unsigned int)(-1);
     ssm->contSectors = 0;
-    ssm->alocMapHandle = fopen(SSM_ALLOCATE_MAP, "r+");
-    ssm->freeMapHandle = fopen(SSM_FREE_MAP, "r+");
-    fwrite(ssm->alocMap, 1, SECTOR_BYTES, ssm->alocMapHandle);
-    fwrite(ssm->freeMap, 1, SECTOR_BYTES, ssm->freeMapHandle);
-    fclose(ssm->alocMapHandle);
-    fclose(ssm->freeMapHandle);
-    ssm->alocMapHandle = Null;
-    ssm->freeMapHandle = Null;
+    disk_map_write(SSM_ALLOCATE_MAP, ssm->alocMap, SECTOR_BYTES);
+    disk_map_write(SSM_FREE_MAP, ssm->freeMap, SECTOR_BYTES);
+    return True;
+}
+
+Bool ssm_deallocate_batch(const unsigned int *_sectorNums, unsigned int _count) {
+    for (unsigned int i = 0; i < _count; i++) {
+        unsigned int byte = _sectorNums[i] / BITS_PER_BYTE;
+        if (byte >= SECTOR_BYTES) {
+            continue;
+        }
+        unsigned char bit = (unsigned char)(1 << (_sectorNums[i] % BITS_PER_BYTE));
+        ssm->freeMap[byte] |= bit;
+        ssm->alocMap[byte] &= (unsigned char)~bit;
+    }
+    Bool integrity = check_integrity();
+    if (integrity == False) return False;
+    disk_map_write(SSM_ALLOCATE_MAP, ssm->alocMap, SECTOR_BYTES);
+    disk_map_write(SSM_FREE_MAP, ssm->freeMap, SECTOR_BYTES);
     return True;
 }
 
@@ -290,14 +282,8 @@ static void set_aloc_sector(int _byte, int _bit) {
         ssm->alocMap[_byte] += pow(2, _bit);
     else
         ssm->alocMap[_byte] -= pow(2, _bit);
-    ssm->alocMapHandle = fopen(SSM_ALLOCATE_MAP, "r+");
-    ssm->freeMapHandle = fopen(SSM_FREE_MAP, "r+");
-    fwrite(ssm->alocMap, 1, SECTOR_BYTES, ssm->alocMapHandle);
-    fwrite(ssm->freeMap, 1, SECTOR_BYTES, ssm->freeMapHandle);
-    fclose(ssm->alocMapHandle);
-    fclose(ssm->freeMapHandle);
-    ssm->alocMapHandle = Null;
-    ssm->freeMapHandle = Null;
+    disk_map_write(SSM_ALLOCATE_MAP, ssm->alocMap, SECTOR_BYTES);
+    disk_map_write(SSM_FREE_MAP, ssm->freeMap, SECTOR_BYTES);
 }
 
 /**
@@ -316,12 +302,6 @@ static void set_free_sector(int _byte, int _bit) {
         ssm->freeMap[_byte] += pow(2, _bit);
     else
         ssm->freeMap[_byte] -= pow(2, _bit);
-    ssm->alocMapHandle = fopen(SSM_ALLOCATE_MAP, "r+");
-    ssm->freeMapHandle = fopen(SSM_FREE_MAP, "r+");
-    fwrite(ssm->alocMap, 1, SECTOR_BYTES, ssm->alocMapHandle);
-    fwrite(ssm->freeMap, 1, SECTOR_BYTES, ssm->freeMapHandle);
-    fclose(ssm->alocMapHandle);
-    fclose(ssm->freeMapHandle);
-    ssm->alocMapHandle = Null;
-    ssm->freeMapHandle = Null;
+    disk_map_write(SSM_ALLOCATE_MAP, ssm->alocMap, SECTOR_BYTES);
+    disk_map_write(SSM_FREE_MAP, ssm->freeMap, SECTOR_BYTES);
 }
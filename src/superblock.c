@@ -0,0 +1,92 @@
+/*******************************************************************************
+ * File Sector Manager (FSM) - Super Block
+ * Author: Michael Lombardi
+ *******************************************************************************/
+#include "superblock.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "config.h"
+#include "disk.h"
+#include "fsm_constants.h"
+#include "global_constants.h"
+
+SuperBlock superblock = {.magic = 0, .flags = 0, .inodeChunks = 0, .pendingChunks = 0};
+
+//========================= SUPER BLOCK FUNCTION PROTOTYPES ===================//
+static Bool superblock_valid(unsigned int _blockSize);
+
+//========================= SUPER BLOCK FUNCTION DEFINITIONS ==================//
+Bool superblock_format(unsigned int _inodeChunks, unsigned int _mapsOffset, Bool _lazy) {
+    memset(&superblock, 0, sizeof(SuperBlock));
+    superblock.magic = SUPERBLOCK_MAGIC;
+    superblock.diskSize = DISK_SIZE;
+    superblock.blockSize = BLOCK_SIZE;
+    superblock.inodeSize = INODE_SIZE;
+    superblock.inodeBlocks = INODE_BLOCKS;
+    superblock.inodeCount = INODE_COUNT;
+    superblock.mapsOffset = _mapsOffset;
+    superblock.inodeChunks =
+        _inodeChunks < SUPERBLOCK_MAX_CHUNKS ? _inodeChunks : SUPERBLOCK_MAX_CHUNKS;
+    superblock.pendingChunks = superblock.inodeChunks;
+    superblock.flags = _lazy == True ? SUPERBLOCK_LAZY_INODES : 0;
+    return superblock_write();
+}
+
+Bool superblock_read(void) {
+    if (disk_read(&superblock, BLOCK_SIZE, sizeof(SuperBlock)) == False ||
+        superblock_valid(BLOCK_SIZE) == False) {
+        memset(&superblock, 0, sizeof(SuperBlock));
+        return False;
+    }
+    return True;
+}
+
+Bool superblock_find(void) {
+    for (unsigned int blockSize = MAX_BLOCK_SIZE; blockSize >= SUPERBLOCK_MIN_BLOCK_SIZE;
+         blockSize /= 2) {
+        if (disk_read(&superblock, blockSize, sizeof(SuperBlock)) == True &&
+            superblock_valid(blockSize) == True) {
+            return True;
+        }
+    }
+    memset(&superblock, 0, sizeof(SuperBlock));
+    return False;
+}
+
+Bool superblock_write(void) { return disk_write(&superblock, BLOCK_SIZE, sizeof(SuperBlock)); }
+
+Bool superblock_chunk_ready(unsigned int _chunk) {
+    if (_chunk >= superblock.inodeChunks) return True;
+    return (superblock.chunkReady[_chunk / BITS_PER_BYTE] & (1u << (_chunk % BITS_PER_BYTE))) != 0
+               ? True
+               : False;
+}
+
+void superblock_chunk_set_ready(unsigned int _chunk) {
+    if (superblock_chunk_ready(_chunk) == True) return;
+    superblock.chunkReady[_chunk / BITS_PER_BYTE] |= 1u << (_chunk % BITS_PER_BYTE);
+    superblock.pendingChunks--;
+    if (superblock.pendingChunks == 0) {
+        superblock.flags &= ~SUPERBLOCK_LAZY_INODES;
+    }
+    if (superblock_write() == False) {
+        printf("Error writing the super block\n");
+    }
+}
+
+/**
+ * @brief Verify that the loaded super block is one this build can mount.
+ * @param[in] _blockSize Block size of the offset the super block was read from.
+ * @return True if the magic matches and the geometry fits the compiled limits; false otherwise.
+ * @date 2026-10-18 First implementation.
+ */
+static Bool superblock_valid(unsigned int _blockSize) {
+    return superblock.magic == SUPERBLOCK_MAGIC && superblock.blockSize == _blockSize &&
+                   superblock.diskSize <= MAX_DISK_SIZE && superblock.inodeSize > 0 &&
+                   superblock.inodeBlocks <= MAX_INODE_BLOCKS &&
+                   superblock.inodeChunks <= SUPERBLOCK_MAX_CHUNKS
+               ? True
+               : False;
+}
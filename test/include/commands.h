@@ -56,6 +56,66 @@ int create_command(char* input, int i);
  */
 int rename_command(char* input, int i);
 
+/**
+ * @brief Writes or reads a byte range of a file with `fs_pwrite`/`fs_pread`.
+ * A write is checked by reading the range back with a byte either side.
+ * @param input Input buffer (max 10,000 characters).
+ * @param i Current index in the input buffer.
+ * @return Updated input buffer index.
+ */
+int range_command(char* input, int i);
+
+/**
+ * @brief Appends bytes to a file with `fs_append` and reads them back.
+ * @param input Input buffer (max 10,000 characters).
+ * @param i Current index in the input buffer.
+ * @return Updated input buffer index.
+ */
+int append_command(char* input, int i);
+
+/**
+ * @brief Shrinks or extends a file with `fs_truncate` and checks what it reads afterwards.
+ * @param input Input buffer (max 10,000 characters).
+ * @param i Current index in the input buffer.
+ * @return Updated input buffer index.
+ */
+int truncate_command(char* input, int i);
+
+/**
+ * @brief Works a file through an open handle: `fs_open`, `fs_write`, `fs_read`, `fs_seek` and
+ * `fs_close`.
+ * @param input Input buffer (max 10,000 characters).
+ * @param i Current index in the input buffer.
+ * @return Updated input buffer index.
+ */
+int handle_command(char* input, int i);
+
+/**
+ * @brief Turns a file system option on or off between commands: extent-mapped files, sparse
+ * files or the directory index.
+ * @param input Input buffer (max 10,000 characters).
+ * @param i Current index in the input buffer.
+ * @return Updated input buffer index.
+ */
+int option_command(char* input, int i);
+
+/**
+ * @brief Adds another name for a file (a hard link) in a directory, or with a count that many
+ * names, numbered after the first 4 bytes of the name given.
+ * @param input Input buffer (max 10,000 characters).
+ * @param i Current index in the input buffer.
+ * @return Updated input buffer index.
+ */
+int link_command(char* input, int i);
+
+/**
+ * @brief Creates a symbolic link and reads its target back.
+ * @param input Input buffer (max 10,000 characters).
+ * @param i Current index in the input buffer.
+ * @return Updated input buffer index.
+ */
+int symlink_command(char* input, int i);
+
 /**
  * @brief Writes data to a file.
  * @param input Input buffer (max 10,000 characters).
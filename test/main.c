@@ -43,6 +43,30 @@ static void process_input(int argc, char** argv, char* input) {
             case 'N':
                 i = rename_command(input, i);
                 break;
+            // case 'A' appends data to the end of a file
+            case 'A':
+                i = append_command(input, i);
+                break;
+            // case 'B' writes or reads a byte range of a file
+            case 'B':
+                i = range_command(input, i);
+                break;
+            // case 'F' works a file through an open handle
+            case 'F':
+                i = handle_command(input, i);
+                break;
+            // case 'H' adds a hard link to a file
+            case 'H':
+                i = link_command(input, i);
+                break;
+            // case 'O' turns a file system option on or off
+            case 'O':
+                i = option_command(input, i);
+                break;
+            // case 'S' creates a symbolic link
+            case 'S':
+                i = symlink_command(input, i);
+                break;
             // case 'W' will write data to a file
             case 'W':
                 i = write_command(input, i);
@@ -51,6 +75,10 @@ static void process_input(int argc, char** argv, char* input) {
             case 'R':
                 i = read_command(input, i);
                 break;
+            // case 'U' truncates or extends a file
+            case 'U':
+                i = truncate_command(input, i);
+                break;
             // case 'V' removes a file from a folder
             case 'V':
                 i = remove_command(input, i);
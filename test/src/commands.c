@@ -8,6 +8,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "disk.h"
 #include "fsm.h"
 #include "global_constants.h"
 #include "inode.h"
@@ -18,6 +19,46 @@
 // buffer for holding block information
 static unsigned int buffer[600 * (MAX_BLOCK_SIZE / 4)];
 
+// number of blocks the read command streams at a time
+#define READ_CHUNK_BLOCKS (16)
+
+// fill for the chunk buffer, so a word the stream never delivered is recognisable
+#define READ_SENTINEL (0xFFFFFFFFu)
+
+// buffer the read command streams a file through
+static unsigned int chunk[READ_CHUNK_BLOCKS * (MAX_BLOCK_SIZE / 4)];
+
+// most bytes a byte-range command handles at once
+#define RANGE_BYTES (16 * MAX_BLOCK_SIZE)
+
+// buffers the byte-range commands write from and read back into, with a byte to spare either side
+static unsigned char range[RANGE_BYTES + 2];
+static unsigned char rangeExpected[RANGE_BYTES + 2];
+
+/**
+ * @brief Fills a buffer with the test pattern of the bytes of a file from an offset on.
+ * Each byte depends on its offset within the file, so data landing in the wrong place shows.
+ * @param bytes Buffer to fill.
+ * @param offset Offset within the file of the first byte.
+ * @param len Number of bytes.
+ * @return void
+ */
+static void fill_pattern(unsigned char* bytes, unsigned int offset, unsigned int len) {
+    for (unsigned int k = 0; k < len; k++) bytes[k] = (unsigned char)((offset + k) * 7 + 1);
+}
+
+/**
+ * @brief Adds up the bytes of a buffer, a short fingerprint of data read back.
+ * @param bytes Buffer to add up.
+ * @param len Number of bytes.
+ * @return The sum of the bytes.
+ */
+static unsigned int byte_sum(const unsigned char* bytes, long long int len) {
+    unsigned int sum = 0;
+    for (long long int k = 0; k < len; k++) sum += bytes[k];
+    return sum;
+}
+
 int init_command(int _argc, char** _argv, char* input, int i) {
     // vars for holding the disk, block, iNode, iNode-block, iNode-count sizes for the file system
     unsigned int _DISK_SIZE, _BLOCK_SIZE, _INODE_SIZE, _INODE_BLOCKS, _INODE_COUNT;
@@ -67,9 +108,32 @@ int init_command(int _argc, char** _argv, char* input, int i) {
     if (digit > 0)
         // fifth parameter is iNodes per block, store value
         _INODE_COUNT = atoi(&input[i]);
+    // an optional third argument selects the disk backend (0 stdio, 1 mmap, 2 io_uring, 3 direct,
+    // 4 ram)
+    if (_argc > 3 && fs_set_disk_mode((DiskMode)atoi(_argv[3])) == False)
+        printf("Error: Unsupported disk mode, using stdio.\n");
+    // an optional fourth argument keeps the inode table resident in memory (1)
+    if (_argc > 4) fs_set_resident_inodes(atoi(_argv[4]) == 1 ? True : False);
+    // an optional fifth argument keeps small files and directories inline in the inode (1)
+    if (_argc > 5) fs_set_inline_data(atoi(_argv[5]) == 1 ? True : False);
+    // an optional sixth argument maps new regular files with extents (1)
+    if (_argc > 6) fs_set_extent_files(atoi(_argv[6]) == 1 ? True : False);
+    // an optional seventh argument leaves the image sparse and the inode table lazy (1)
+    if (_argc > 7) fs_set_lazy_inodes(atoi(_argv[7]) == 1 ? True : False);
+    // an optional eighth argument keeps the maps inside the image (1)
+    if (_argc > 8) fs_set_embedded_maps(atoi(_argv[8]) == 1 ? True : False);
+    // an optional ninth argument leaves the zero blocks of files as holes (1)
+    if (_argc > 9) fs_set_sparse_files(atoi(_argv[9]) == 1 ? True : False);
+    // an optional tenth argument gives directories a name index (1)
+    if (_argc > 10) fs_set_dir_index(atoi(_argv[10]) == 1 ? True : False);
     // if correct parameters, create the file system
     Bool status = True;
-    if (_argc > 1 && atoi(_argv[1]) == 1)
+    if (_argc > 1 && atoi(_argv[1]) == 2) {
+        // mount the file system already on the image, making one only if there is none
+        status = fs_mount();
+        if (status == False)
+            status = fs_make(_DISK_SIZE, _BLOCK_SIZE, _INODE_SIZE, _INODE_BLOCKS, _INODE_COUNT, 1);
+    } else if (_argc > 1 && atoi(_argv[1]) == 1)
         // call to mkfs, initializing the SSM values
         status = fs_make(_DISK_SIZE, _BLOCK_SIZE, _INODE_SIZE, _INODE_BLOCKS, _INODE_COUNT, 1);
     else
@@ -91,17 +155,44 @@ void end_command(void) {
     if (status == False) printf("Error: Could not remove file system.\n");
 }
 
+/**
+ * @brief Reads a file argument, an iNode number or a path resolved with `fs_resolve`.
+ * A path runs up to the next ':' or the end of the line, e.g. I:/docs/notes or R:/docs/notes:10.
+ * @param input Input buffer (max 10,000 characters).
+ * @param i Index of the argument in the input buffer.
+ * @param inodeNum Set to the file's iNode number, -1 if the path does not resolve.
+ * @return 1 if there was a file argument, 0 otherwise.
+ */
+static int file_argument(char* input, int i, unsigned int* inodeNum) {
+    if (input[i] == '/') {
+        char path[256];
+        int length = 0;
+        while (input[i + length] != '\n' && input[i + length] != '\0' &&
+               input[i + length] != ':' && length < 255) {
+            path[length] = input[i + length];
+            length++;
+        }
+        path[length] = '\0';
+        *inodeNum = fs_resolve(path);
+        if (*inodeNum == (unsigned int)(-1)) printf("Error: No file at %s\n", path);
+        return 1;
+    }
+    if (isdigit(input[i]) > 0) {
+        *inodeNum = atoi(&input[i]);
+        return 1;
+    }
+    return 0;
+}
+
 int info_command(char* input, int i) {
     // iNode number dealing with files
     unsigned int inodeNumF;
     // move to retrieve the iNode number
     i += 2;
-    // ensure that the character is a digit
-    int digit = isdigit(input[i]);
+    // the file is given by its iNode number or its path
+    int digit = file_argument(input, i, &inodeNumF);
     // if the character is a digit, attempt to locate iNode
     if (digit > 0) {
-        // convert the character to a digit
-        inodeNumF = atoi(&input[i]);
         // Attempt to open the file located at inodeNumF. If the iNode was successfully opened,
         // print the appropriate message
         if (fs_open_file(inodeNumF, &inode)) {
@@ -254,6 +345,398 @@ int rename_command(char* input, int i) {
     return i;
 }
 
+int range_command(char* input, int i) {
+    // iNode number dealing with files
+    unsigned int inodeNumF;
+    // move to retrieve the operation, W to write and R to read
+    i += 2;
+    char c = input[i];
+    // move to retrieve the file's iNode
+    i = advance_to_char(input, ':', i);
+    i += 1;
+    // ensure that the character is a digit
+    int digit = isdigit(input[i]);
+    // if the character is a digit, proceed
+    if (digit > 0) {
+        inodeNumF = atoi(&input[i]);
+        // find next input, the offset within the file
+        i = advance_to_char(input, ':', i);
+        i += 1;
+        unsigned int offset = atoi(&input[i]);
+        // find next input, the number of bytes
+        i = advance_to_char(input, ':', i);
+        i += 1;
+        unsigned int len = atoi(&input[i]);
+        if (len > RANGE_BYTES) len = RANGE_BYTES;
+        // print debug information
+        printf("\nDEBUG_LEVEL > 0:\n");
+        printf("//%s %d bytes at byte %d of File (Inode %d)\n", c == 'W' ? "Writing" : "Reading",
+               len, offset, inodeNumF);
+        printf("//B:%c:%d:%d:%d\n\n", c, inodeNumF, offset, len);
+        if (c == 'W') {
+            // the range and a byte either side are read before and after the write
+            unsigned int from = offset > 0 ? offset - 1 : 0;
+            unsigned int span = len + (offset - from) + 1;
+            memset(rangeExpected, 0, sizeof(rangeExpected));
+            long long int before = fs_pread(inodeNumF, rangeExpected, span, from);
+            fill_pattern(range, offset, len);
+            long long int written = fs_pwrite(inodeNumF, range, len, offset);
+            memcpy(rangeExpected + (offset - from), range, len);
+            long long int expected = before > offset - from + len ? before : offset - from + len;
+            long long int after = fs_pread(inodeNumF, range, span, from);
+            printf("-> Wrote %lld bytes at byte %d of File (Inode %d)\n", written, offset,
+                   inodeNumF);
+            fs_open_file(inodeNumF, &inode);
+            printf("-> File (Inode %d) is %d bytes\n", inodeNumF, inode.fileSize);
+            printf("** Expected Result: range read back, bytes around it unchanged: %s\n",
+                   after == expected && memcmp(range, rangeExpected, after) == 0
+                       ? "matches"
+                       : "DOES NOT MATCH");
+        } else {
+            long long int read = fs_pread(inodeNumF, range, len, offset);
+            printf("-> Read %lld bytes at byte %d of File (Inode %d)\n", read, offset, inodeNumF);
+            printf("** Note: sum of the bytes read = %d\n", byte_sum(range, read));
+        }
+        // print section break
+        printf("- - - - - - - - - - - - - - - - - - - - - - -");
+        printf(" - - - - - - - - - - - - -\n\n");
+    }  // end if (digit > 0)
+    // find the next line of input
+    i = advance_to_char(input, '\n', i);
+    return i;
+}
+
+int append_command(char* input, int i) {
+    // iNode number dealing with files
+    unsigned int inodeNumF;
+    // move to retrieve the file's iNode
+    i += 2;
+    // ensure that the character is a digit
+    int digit = isdigit(input[i]);
+    // if the character is a digit, proceed
+    if (digit > 0) {
+        inodeNumF = atoi(&input[i]);
+        // find next input, the number of bytes
+        i = advance_to_char(input, ':', i);
+        i += 1;
+        unsigned int len = atoi(&input[i]);
+        if (len > RANGE_BYTES) len = RANGE_BYTES;
+        // print debug information
+        printf("\nDEBUG_LEVEL > 0:\n");
+        printf("//Appending %d bytes to File (Inode %d)\n", len, inodeNumF);
+        printf("//A:%d:%d\n\n", inodeNumF, len);
+        fs_open_file(inodeNumF, &inode);
+        unsigned int size = inode.fileSize;
+        // the last byte before the append must stay as it was
+        unsigned int from = size > 0 ? size - 1 : 0;
+        memset(rangeExpected, 0, sizeof(rangeExpected));
+        fs_pread(inodeNumF, rangeExpected, 1, from);
+        fill_pattern(range, size, len);
+        long long int written = fs_append(inodeNumF, range, len);
+        memcpy(rangeExpected + (size - from), range, len);
+        long long int after = fs_pread(inodeNumF, range, len + (size - from), from);
+        printf("-> Appended %lld bytes to File (Inode %d)\n", written, inodeNumF);
+        fs_open_file(inodeNumF, &inode);
+        printf("-> File (Inode %d) grew from %d to %d bytes\n", inodeNumF, size, inode.fileSize);
+        printf("** Expected Result: appended bytes read back after the old end: %s\n",
+               after == len + (size - from) && memcmp(range, rangeExpected, after) == 0
+                   ? "matches"
+                   : "DOES NOT MATCH");
+        // print section break
+        printf("- - - - - - - - - - - - - - - - - - - - - - -");
+        printf(" - - - - - - - - - - - - -\n\n");
+    }  // end if (digit > 0)
+    // find the next line of input
+    i = advance_to_char(input, '\n', i);
+    return i;
+}
+
+int truncate_command(char* input, int i) {
+    // iNode number dealing with files
+    unsigned int inodeNumF;
+    // move to retrieve the file's iNode
+    i += 2;
+    // ensure that the character is a digit
+    int digit = isdigit(input[i]);
+    // if the character is a digit, proceed
+    if (digit > 0) {
+        inodeNumF = atoi(&input[i]);
+        // find next input, the new size
+        i = advance_to_char(input, ':', i);
+        i += 1;
+        unsigned int size = atoi(&input[i]);
+        // print debug information
+        printf("\nDEBUG_LEVEL > 0:\n");
+        printf("//Truncating File (Inode %d) to %d bytes\n", inodeNumF, size);
+        printf("//U:%d:%d\n\n", inodeNumF, size);
+        fs_open_file(inodeNumF, &inode);
+        unsigned int oldSize = inode.fileSize;
+        // the last bytes that stay in the file are read before and after
+        unsigned int keep = oldSize < size ? oldSize : size;
+        unsigned int from = keep > RANGE_BYTES ? keep - RANGE_BYTES : 0;
+        long long int before = fs_pread(inodeNumF, rangeExpected, keep - from, from);
+        Bool status = fs_truncate(inodeNumF, size);
+        long long int after = fs_pread(inodeNumF, range, keep - from, from);
+        Bool same = before == after && memcmp(range, rangeExpected, after) == 0;
+        // an extended file reads as zeros past its old end
+        unsigned int grown = size - keep > RANGE_BYTES ? RANGE_BYTES : size - keep;
+        long long int tail = fs_pread(inodeNumF, range, grown, keep);
+        for (long long int k = 0; k < tail; k++) same = same == True && range[k] == 0;
+        same = same == True && tail == grown && fs_pread(inodeNumF, range, 1, size) == 0;
+        if (status == False) printf("Error: Could not truncate File (Inode %d)\n", inodeNumF);
+        fs_open_file(inodeNumF, &inode);
+        printf("-> File (Inode %d) went from %d to %d bytes\n", inodeNumF, oldSize,
+               inode.fileSize);
+        printf("** Expected Result: kept bytes unchanged, new bytes zero, none past the end: %s\n",
+               same == True ? "matches" : "DOES NOT MATCH");
+        // print section break
+        printf("- - - - - - - - - - - - - - - - - - - - - - -");
+        printf(" - - - - - - - - - - - - -\n\n");
+    }  // end if (digit > 0)
+    // find the next line of input
+    i = advance_to_char(input, '\n', i);
+    return i;
+}
+
+int handle_command(char* input, int i) {
+    // move to retrieve the operation: O open, W write, R read, S seek, C close
+    i += 2;
+    char c = input[i];
+    // move to retrieve the iNode (open) or the handle (every other operation)
+    i = advance_to_char(input, ':', i);
+    i += 1;
+    // ensure that the character is a digit
+    int digit = isdigit(input[i]);
+    // if the character is a digit, proceed
+    if (digit > 0) {
+        int number = atoi(&input[i]);
+        // print debug information
+        printf("\nDEBUG_LEVEL > 0:\n");
+        if (c == 'O') {
+            printf("//Opening a handle on File (Inode %d)\n", number);
+            printf("//F:O:%d\n\n", number);
+            printf("-> Opened handle %d\n", fs_open((unsigned int)number));
+        } else if (c == 'W' || c == 'R') {
+            // find next input, the number of bytes
+            i = advance_to_char(input, ':', i);
+            i += 1;
+            unsigned int len = atoi(&input[i]);
+            if (len > RANGE_BYTES) len = RANGE_BYTES;
+            printf("//%s %d bytes through handle %d\n", c == 'W' ? "Writing" : "Reading", len,
+                   number);
+            printf("//F:%c:%d:%d\n\n", c, number, len);
+            // the data written follows the pattern of the bytes it lands on
+            long long int offset = fs_seek(number, 0, SEEK_CUR);
+            long long int done;
+            if (c == 'W') {
+                fill_pattern(range, (unsigned int)offset, len);
+                done = fs_write(number, range, len);
+            } else {
+                done = fs_read(number, range, len);
+            }
+            printf("-> %s %lld bytes at byte %lld\n", c == 'W' ? "Wrote" : "Read", done, offset);
+            if (c == 'R') printf("** Note: sum of the bytes read = %d\n", byte_sum(range, done));
+            printf("-> Handle %d is now at byte %lld\n", number, fs_seek(number, 0, SEEK_CUR));
+        } else if (c == 'S') {
+            // find next inputs, the offset and where it counts from (0 start, 1 current, 2 end)
+            i = advance_to_char(input, ':', i);
+            i += 1;
+            long long int offset = atoi(&input[i]);
+            i = advance_to_char(input, ':', i);
+            i += 1;
+            int whence = atoi(&input[i]);
+            printf("//Seeking handle %d by %lld bytes from %s\n", number, offset,
+                   whence == SEEK_SET   ? "the start"
+                   : whence == SEEK_CUR ? "its offset"
+                   : whence == SEEK_END ? "the end"
+                                        : "an unknown origin");
+            printf("//F:S:%d:%lld:%d\n\n", number, offset, whence);
+            printf("-> Seek returned %lld\n", fs_seek(number, offset, whence));
+        } else if (c == 'C') {
+            printf("//Closing handle %d\n", number);
+            printf("//F:C:%d\n\n", number);
+            Bool status = fs_close(number);
+            printf("-> %s handle %d\n", status == True ? "Closed" : "Could not close", number);
+        }
+        // print section break
+        printf("- - - - - - - - - - - - - - - - - - - - - - -");
+        printf(" - - - - - - - - - - - - -\n\n");
+    }  // end if (digit > 0)
+    // find the next line of input
+    i = advance_to_char(input, '\n', i);
+    return i;
+}
+
+int option_command(char* input, int i) {
+    // move to retrieve the option: E extent-mapped files, S sparse files, D directory index
+    i += 2;
+    char c = input[i];
+    // find next input, 1 to turn the option on or 0 to turn it off
+    i = advance_to_char(input, ':', i);
+    i += 1;
+    // ensure that the character is a digit
+    int digit = isdigit(input[i]);
+    // if the character is a digit, proceed
+    if (digit > 0) {
+        Bool on = atoi(&input[i]) == 1 ? True : False;
+        const char* option = Null;
+        if (c == 'E') {
+            fs_set_extent_files(on);
+            option = "extent-mapped files";
+        } else if (c == 'S') {
+            fs_set_sparse_files(on);
+            option = "sparse files";
+        } else if (c == 'D') {
+            fs_set_dir_index(on);
+            option = "directory index";
+        }
+        if (option != Null) {
+            // print debug information
+            printf("\nDEBUG_LEVEL > 0:\n");
+            printf("//Turn %s %s\n", option, on == True ? "on" : "off");
+            printf("//O:%c:%d\n\n", c, on == True ? 1 : 0);
+            printf("-> Turned %s %s\n", option, on == True ? "on" : "off");
+            // print section break
+            printf("- - - - - - - - - - - - - - - - - - - - - - -");
+            printf(" - - - - - - - - - - - - -\n\n");
+        }
+    }  // end if (digit > 0)
+    // find the next line of input
+    i = advance_to_char(input, '\n', i);
+    return i;
+}
+
+int link_command(char* input, int i) {
+    // buffer for the new name
+    char name[9];
+    // iNode number dealing with the file and the directory
+    unsigned int inodeNumF, inodeNumD;
+    // move to retrieve the file's iNode
+    i += 2;
+    // ensure that the character is a digit
+    int digit = isdigit(input[i]);
+    // if the character is a digit, proceed
+    if (digit > 0) {
+        // convert the character to a digit
+        inodeNumF = atoi(&input[i]);
+        // find next input, the directory's iNode
+        i = advance_to_char(input, ':', i);
+        i += 1;
+        inodeNumD = atoi(&input[i]);
+        // find next input, the new name
+        i = advance_to_char(input, ':', i);
+        i += 1;
+        memset(name, 0, sizeof(name));
+        memcpy(name, input + i, 8);
+        // an optional count adds that many names: the first 4 bytes of the name and a number
+        int count = input[i + 8] == ':' ? atoi(&input[i + 9]) : 0;
+        // print debug information
+        printf("\nDEBUG_LEVEL > 0:\n");
+        if (count > 0) {
+            printf("//Link File (Inode %d) into Folder (Inode %d) %d times, ", inodeNumF,
+                   inodeNumD, count);
+            printf("as \'%.4s0000\' onward\n", name);
+            printf("//H:%d:%d:%s:%d\n\n", inodeNumF, inodeNumD, name, count);
+        } else {
+            printf("//Link File (Inode %d) into Folder (Inode %d) as \'%s\'\n", inodeNumF,
+                   inodeNumD, name);
+            printf("//H:%d:%d:%s\n\n", inodeNumF, inodeNumD, name);
+        }
+        Bool linked = count > 0 ? True : fs_link(inodeNumF, (unsigned int*)name, inodeNumD);
+        for (int n = 0; n < count && linked == True; n++) {
+            snprintf(name + 4, 5, "%04u", (unsigned int)n % 10000);
+            linked = fs_link(inodeNumF, (unsigned int*)name, inodeNumD);
+        }
+        if (linked == False) {
+            printf("Error: Could not link File (Inode %d) as \'%s\'\n", inodeNumF, name);
+        } else {
+            if (count > 0) {
+                printf("-> Linked File (Inode %d) %d times in Folder (Inode %d), ", inodeNumF,
+                       count, inodeNumD);
+                printf("the last as \'%s\'.\n", name);
+            } else {
+                printf("-> Linked File (Inode %d) as \'%s\' in ", inodeNumF, name);
+                printf("Folder (Inode %d).\n", inodeNumD);
+            }
+            fs_open_file(inodeNumF, &inode);
+            printf("** Expected Result: 0 Inodes allocated, ");
+            printf("File (Inode %d) has %d names\n", inodeNumF, inode.linkCount);
+            Bool status = fs_close_file();
+            if (status == False) printf("Error closing file\n");
+        }
+        // print section break
+        printf("- - - - - - - - - - - - - - - - - - - - - - -");
+        printf(" - - - - - - - - - - - - -\n\n");
+    }  // end if (digit > 0)
+    // find the next line of input
+    i = advance_to_char(input, '\n', i);
+    return i;
+}
+
+int symlink_command(char* input, int i) {
+    // buffer for the link's name
+    char name[9];
+    // buffers for the link's target as given and as read back
+    char target[MAX_BLOCK_SIZE + 1];
+    char readBack[MAX_BLOCK_SIZE + 1];
+    // iNode number dealing with the link and its directory
+    unsigned int inodeNumF, inodeNumD;
+    // move to retrieve the directory's iNode
+    i += 2;
+    // ensure that the character is a digit
+    int digit = isdigit(input[i]);
+    // if the character is a digit, proceed
+    if (digit > 0) {
+        // convert the character to a digit
+        inodeNumD = atoi(&input[i]);
+        // find next input
+        i = advance_to_char(input, ':', i);
+        // move to after semi-colon
+        i += 1;
+        // read the characters for the link's name
+        memset(name, 0, sizeof(name));
+        memcpy(name, input + i, 8);
+        i += 8;
+        // the target is the rest of the line, after the semi-colon
+        i += 1;
+        int length = 0;
+        while (input[i + length] != '\n' && input[i + length] != '\0' &&
+               length < MAX_BLOCK_SIZE) {
+            target[length] = input[i + length];
+            length++;
+        }
+        target[length] = '\0';
+        // print debug information
+        printf("\nDEBUG_LEVEL > 0:\n");
+        printf("//Create a Symbolic Link (\'%s\') in Folder (Inode %d)\n", name, inodeNumD);
+        printf("//S:%d:%s:%s\n\n", inodeNumD, name, target);
+        // create the link and read its target back
+        inodeNumF = fs_symlink(target, (unsigned int*)name, inodeNumD);
+        if (inodeNumF == (unsigned int)(-1)) {
+            printf("Error: Could not create link \'%s\'\n", name);
+        } else if (fs_read_link(inodeNumF, readBack, sizeof(readBack)) == False) {
+            printf("Error: Could not read link (Inode %d)\n", inodeNumF);
+        } else {
+            printf("-> Used (Inode %d) to create a Symbolic Link.\n", inodeNumF);
+            printf("-> Target read back: %s\n", readBack);
+            printf("** Expected Result: target %s\n",
+                   strcmp(readBack, target) == 0 ? "matches" : "DOES NOT MATCH");
+            // a short target lives in the inode, a long one in a data block
+            fs_open_file(inodeNumF, &inode);
+            printf("** Expected Result: target kept %s\n",
+                   (inode.status & INODE_INLINE) ? "in the inode" : "in a data block");
+            Bool status = fs_close_file();
+            if (status == False) printf("Error closing file\n");
+        }
+        // print section break
+        printf("- - - - - - - - - - - - - - - - - - - - - - -");
+        printf(" - - - - - - - - - - - - -\n\n");
+    }  // end if (digit > 0)
+    // find the next line of input
+    i = advance_to_char(input, '\n', i);
+    return i;
+}
+
 int write_command(char* input, int i) {
     // iNode number dealing with files
     unsigned int inodeNumF;
@@ -312,12 +795,10 @@ int read_command(char* input, int i) {
     unsigned int inodeNumF;
     // move to retrieve the iNode number of the file to be read
     i += 2;
-    // check to see if character is a digit
-    int digit = isdigit(input[i]);
-    // if the character is a digit, proceed
+    // the file is given by its iNode number or its path, e.g. R:/docs/notes:10
+    int digit = file_argument(input, i, &inodeNumF);
+    // if the file was given, proceed
     if (digit > 0) {
-        // convert the character to a number
-        inodeNumF = atoi(&input[i]);
         // find the next input
         i = advance_to_char(input, ':', i);
         // move to after the semi-colon, size of bytes to be read
@@ -332,8 +813,26 @@ int read_command(char* input, int i) {
             printf("//Reading %d bytes from file at Inode %d\n", atoi(&input[i]), inodeNumF);
             // print input information
             printf("//R:%d:%d\n\n", inodeNumF, atoi(&input[i]));
-            // call to readFromFile
-            fs_read_from_file(inodeNumF, buffer);
+            // stream the file through a chunk buffer, keeping the word at byte 272608
+            unsigned int probe = 266 * BLOCK_SIZE + 56 * 4;
+            // the value comes only from streamed bytes; a short or failed stream keeps the sentinel
+            unsigned int value = READ_SENTINEL;
+            FileStream stream;
+            if (fs_stream_open(&stream, inodeNumF, READ_CHUNK_BLOCKS) == True) {
+                unsigned int offset = 0;
+                long long int len;
+                memset(chunk, 0xFF, sizeof(chunk));
+                while ((len = fs_stream_next(&stream, chunk)) > 0) {
+                    if (probe >= offset && probe - offset + 4 <= len)
+                        value = chunk[(probe - offset) / 4];
+                    offset += len;
+                    memset(chunk, 0xFF, sizeof(chunk));
+                }
+                if (len < 0) printf("Error: Could not stream File (Inode %d)\n", inodeNumF);
+            } else {
+                printf("Error: Could not open File (Inode %d) for streaming\n", inodeNumF);
+            }
+            if (value == READ_SENTINEL) printf("Error: byte (272608) was not streamed back\n");
             // print that the file had been read
             printf("-> Read %d bytes from File (Inode %d)\n", atoi(&input[i]), inodeNumF);
             printf("** Expected Result: 0 Inodes allocated in the");
@@ -341,7 +840,7 @@ int read_command(char* input, int i) {
             printf("** Expected Result: 0 Blocks allocated in the");
             printf(" Aloc/Free Map\n");
             printf("** Note: value of READ buffer at byte ");
-            printf("(272608) = %d\n\n", buffer[266 * (BLOCK_SIZE / 4) + 56]);
+            printf("(272608) = %d\n\n", value);
         }  // end if (digit > 0)
         // print section break
         printf("- - - - - - - - - - - - - - - - - - - - - - - - ");
@@ -394,10 +893,17 @@ int remove_command(char* input, int i) {
                 printf("all Files in Folder (Inode %d)\n", inodeNumD);
             }  // end if (fsm->inode.fileType == 2)
             // print expected results from rmFile
-            printf("** Expected Result: 1 Inode deallocated in ");
-            printf("the Inode Map\n");
-            printf("** Expected Result: ");
-            printf("%d Blocks deallocated in the Aloc/Free Map\n", inode.fileSize / BLOCK_SIZE);
+            if (inode.fileType != 2 && inode.linkCount > 1) {
+                // a file with other names only loses this one
+                printf("** Expected Result: 0 Inodes deallocated, ");
+                printf("File (Inode %d) keeps %d name(s)\n", inodeNumF, inode.linkCount - 1);
+            } else {
+                printf("** Expected Result: 1 Inode deallocated in ");
+                printf("the Inode Map\n");
+                printf("** Expected Result: ");
+                printf("%d Blocks deallocated in the Aloc/Free Map\n",
+                       inode.fileSize / BLOCK_SIZE);
+            }
             // call to rmFile
             fs_remove_file(inodeNumF, inodeNumD);
         }  // end if (digit > 0)
@@ -442,7 +948,7 @@ int remove_test_command(char* input, int i) {
         index[0] = ssm_get_sector_offset_byte_index();
         index[1] = ssm_get_sector_offset_bit_index();
         // call to write_inode
-        inode_write(&inode, atoi(&input[i]), fsm->diskHandle);
+        inode_write(&inode, atoi(&input[i]));
         // print the block size
         printf("Double indirect Ptr --> %d\n", inode.dIndirect / BLOCK_SIZE);
         // call to allocate sector
@@ -457,12 +963,8 @@ int remove_test_command(char* input, int i) {
         }  // end for (m = 0; m < BLOCK_SIZE/4; m
         // retrieve the block
         block[0] = ssm_get_sector_offset();
-        // move to the beginning of the file
-        fseek(fsm->diskHandle, 0, SEEK_SET);
-        // move to the double indirect block
-        fseek(fsm->diskHandle, inode.dIndirect, SEEK_SET);
-        // write block to the file
-        fwrite(block, BLOCK_SIZE, 1, fsm->diskHandle);
+        // write block to the double indirect block
+        disk_write(block, inode.dIndirect, BLOCK_SIZE);
         // print that iNode values will be tested
         printf("Double indirect Ptr --> Double Indirect Block ");
         printf("--> %d\n", block[0] / BLOCK_SIZE);
@@ -478,12 +980,8 @@ int remove_test_command(char* input, int i) {
         }  // end for (m = 0; m < BLOCK_SIZE/4; m++)
         // retrieve the block
         block[0] = ssm_get_sector_offset();
-        // move to the beginning of the file
-        fseek(fsm->diskHandle, 0, SEEK_SET);
-        // move to the double indirect block
-        fseek(fsm->diskHandle, BLOCK_SIZE * (8 * index[2] + index[3]), SEEK_SET);
-        // write block to file
-        fwrite(block, BLOCK_SIZE, 1, fsm->diskHandle);
+        // write block to the double indirect block
+        disk_write(block, BLOCK_SIZE * (8 * index[2] + index[3]), BLOCK_SIZE);
         // print block value
         printf("Double indirect Ptr --> Double Indirect Block ");
         printf("--> Single Indirect Block -> %d\n", block[0] / BLOCK_SIZE);
@@ -496,12 +994,8 @@ int remove_test_command(char* input, int i) {
         }  // end for (m = 0; m < BLOCK_SIZE/4; m++)
         // for debugging purposes, assign values in buffer
         memcpy(block, (int[]){1, 1, 1, 0, 1, 1, 25, 1, 3, 3, 1, 0}, sizeof(unsigned int) * 12);
-        // move to the beginning of the file
-        fseek(fsm->diskHandle, 0, SEEK_SET);
-        // move to the location stored in index
-        fseek(fsm->diskHandle, index[0], SEEK_SET);
-        // write value of block to disk
-        fwrite(block, sizeof(unsigned int), BLOCK_SIZE / 4, fsm->diskHandle);
+        // write value of block to the location stored in index
+        disk_write(block, index[0], BLOCK_SIZE);
         // print the addition of tuple
         printf("Added File-Tuple (Inode 25) to data block at ");
         printf("sector %d\n", index[0] / BLOCK_SIZE);
@@ -516,7 +1010,7 @@ int remove_test_command(char* input, int i) {
         // set single indirect to -1
         inode.dIndirect = -1;
         // write iNode to file
-        inode_write(&inode, atoi(&input[i]), fsm->diskHandle);
+        inode_write(&inode, atoi(&input[i]));
         // print section break
         printf("- - - - - - - - - - - - - - - - - - - - - - - - ");
         printf("- - - - - - - - - - - -\n\n\n");